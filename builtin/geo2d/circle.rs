@@ -10,7 +10,8 @@ pub struct Circle(microcad_core::Circle);
 
 impl Render<Geometry2D> for Circle {
     fn render(&self, resolution: &RenderResolution) -> Geometry2D {
-        Geometry2D::Polygon(self.0.render(resolution))
+        let segments = resolution.circular_segments(self.0.radius);
+        PrimitiveLibrary::with(|library| library.circle(&self.0, segments))
     }
 }
 
@@ -79,4 +79,6 @@ pub fn builtin_exporters() -> ExporterRegistry {
         .insert(microcad_export::stl::StlExporter)
         .insert(microcad_export::json::JsonExporter)
         .insert(microcad_export::wkt::WktExporter)
+        .insert(microcad_export::wkb::WkbExporter)
+        .insert(microcad_export::parts::PartsExporter)
 }
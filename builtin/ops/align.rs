@@ -3,9 +3,11 @@
 
 //! Builtin align operation.
 
-use microcad_core::{Geometries2D, Geometry2D};
 use microcad_lang::{builtin::*, render::*};
 
+/// Move the children into the center of their common bounds.
+///
+/// The translation is taken from the bounds which come along with the rendered children.
 #[derive(Debug)]
 pub struct Align;
 
@@ -13,18 +15,19 @@ impl Operation for Align {
     fn process_2d(&self, context: &mut RenderContext) -> RenderResult<Geometry2DOutput> {
         context.update_2d(|context, model| {
             let model_ = model.borrow();
-            let geometries: Geometries2D = model_.children.render_with_context(context)?;
+            let geometry: Geometry2DOutput = model_.children.render_with_context(context)?;
             use microcad_core::traits::Align;
-            Ok(Geometry2D::Collection(geometries).align())
+            Ok(geometry.align())
         })
     }
 
-    fn process_3d(&self, _context: &mut RenderContext) -> RenderResult<Geometry3DOutput> {
-        todo!()
-        /*context.update_3d(|context, model, resolution| {
-            let geometry: Geometry3DOutput = model.render(context)?;
-            geometry.map(|geometry| geometry.center(&resolution))
-        })*/
+    fn process_3d(&self, context: &mut RenderContext) -> RenderResult<Geometry3DOutput> {
+        context.update_3d(|context, model| {
+            let model_ = model.borrow();
+            let geometry: Geometry3DOutput = model_.children.render_with_context(context)?;
+            use microcad_core::traits::Align;
+            Ok(geometry.align())
+        })
     }
 }
 
@@ -0,0 +1,47 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Builtin minkowski operation.
+
+use microcad_core::*;
+use microcad_lang::{builtin::*, render::*};
+
+/// Minkowski sum of the first child with the convex hull of all other children.
+#[derive(Debug)]
+pub struct Minkowski;
+
+impl Operation for Minkowski {
+    fn output_type(&self) -> OutputType {
+        OutputType::Geometry3D
+    }
+
+    fn process_3d(&self, context: &mut RenderContext) -> RenderResult<Geometry3DOutput> {
+        context.update_3d(|context, model| {
+            let model_ = model.borrow();
+            let geometries: Geometries3D = model_.children.render_with_context(context)?;
+
+            let mut geometries = geometries.iter();
+            let base = geometries.next().ok_or(RenderError::NothingToRender)?;
+            let tool = Geometry3D::Collection(geometries.cloned().collect());
+            Ok(base.minkowski(&tool))
+        })
+    }
+}
+
+impl BuiltinWorkbenchDefinition for Minkowski {
+    fn id() -> &'static str {
+        "minkowski"
+    }
+
+    fn output_type() -> OutputType {
+        OutputType::Geometry3D
+    }
+
+    fn kind() -> BuiltinWorkbenchKind {
+        BuiltinWorkbenchKind::Operation
+    }
+
+    fn workpiece_function() -> &'static BuiltinWorkpieceFn {
+        &|_| Ok(BuiltinWorkpieceOutput::Operation(Box::new(Minkowski)))
+    }
+}
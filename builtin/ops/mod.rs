@@ -6,6 +6,8 @@ use microcad_lang::builtin::*;
 mod align;
 mod extrude;
 mod hull;
+mod minkowski;
+mod offset;
 mod orient;
 mod revolve;
 mod rotate;
@@ -20,6 +22,8 @@ pub fn ops() -> Symbol {
         .symbol(operation::Intersect::symbol())
         .symbol(align::Align::symbol())
         .symbol(hull::Hull::symbol())
+        .symbol(minkowski::Minkowski::symbol())
+        .symbol(offset::Offset::symbol())
         .symbol(extrude::Extrude::symbol())
         .symbol(orient::Orient::symbol())
         .symbol(revolve::Revolve::symbol())
@@ -0,0 +1,66 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Builtin offset operation.
+
+use microcad_core::*;
+use microcad_lang::{builtin::*, render::*};
+
+#[derive(Debug)]
+pub struct Offset {
+    r: Scalar,
+    join: JoinStyle,
+}
+
+impl Operation for Offset {
+    fn output_type(&self) -> OutputType {
+        OutputType::Geometry2D
+    }
+
+    fn process_2d(&self, context: &mut RenderContext) -> RenderResult<Geometry2DOutput> {
+        context.update_2d(|context, model| {
+            let model_ = model.borrow();
+            let geometries: Geometries2D = model_.children.render_with_context(context)?;
+
+            use microcad_core::Offset;
+            Ok(Geometry2D::MultiPolygon(geometries.offset(
+                self.r,
+                &self.join,
+                &context.current_resolution(),
+            )))
+        })
+    }
+}
+
+impl BuiltinWorkbenchDefinition for Offset {
+    fn id() -> &'static str {
+        "offset"
+    }
+
+    fn output_type() -> OutputType {
+        OutputType::Geometry2D
+    }
+
+    fn kind() -> BuiltinWorkbenchKind {
+        BuiltinWorkbenchKind::Operation
+    }
+
+    fn workpiece_function() -> &'static BuiltinWorkpieceFn {
+        &|args| {
+            let join: String = args.get("join");
+            Ok(BuiltinWorkpieceOutput::Operation(Box::new(Offset {
+                r: args.get("r"),
+                join: join.parse()?,
+            })))
+        }
+    }
+
+    fn parameters() -> ParameterValueList {
+        [
+            parameter!(r: Scalar),
+            parameter!(join: String = "round".into()),
+        ]
+        .into_iter()
+        .collect()
+    }
+}
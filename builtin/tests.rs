@@ -56,3 +56,289 @@ fn test_assert() {
         Err(err) => panic!("{err}"),
     }
 }
+
+#[test]
+fn export_transformed_parts() {
+    microcad_lang::env_logger_init();
+
+    use microcad_core::RenderResolution;
+    use microcad_export::{stl::StlExporter, wkt::WktExporter};
+    use microcad_lang::{
+        builtin::Exporter,
+        model::*,
+        parse::source_file::SourceFile,
+        render::{RenderContext, RenderWithContext},
+    };
+    use std::rc::Rc;
+
+    /// Export `source` part by part and as a whole and return both outputs.
+    fn export(source: &str, exporter: Rc<dyn Exporter>, filename: &str) -> (String, String) {
+        let source_file = SourceFile::load_from_str(source).expect("parse error");
+        let mut context = ContextBuilder::new(source_file)
+            .with_builtin()
+            .expect("builtin error")
+            .build();
+        let model = context.eval().expect("eval error").expect("model");
+
+        let streamed = format!("../target/{filename}");
+        let export = ExportCommand {
+            filename: streamed.clone().into(),
+            resolution: RenderResolution::coarse(),
+            exporter: exporter.clone(),
+        };
+        export.render_and_export(&model).expect("export error");
+
+        let whole = format!("../target/whole_{filename}");
+        let mut render_context =
+            RenderContext::init(&model, RenderResolution::coarse(), None).expect("render error");
+        let model: Model = model
+            .render_with_context(&mut render_context)
+            .expect("render error");
+        exporter
+            .export(&model, std::path::Path::new(&whole))
+            .expect("export error");
+
+        (
+            std::fs::read_to_string(streamed).expect("test error"),
+            std::fs::read_to_string(whole).expect("test error"),
+        )
+    }
+
+    let (streamed, whole) = export(
+        r#"
+            __builtin::geo3d::Cube(size_x = 1.0, size_y = 1.0, size_z = 1.0)
+                .__builtin::ops::translate(x = 10.0, y = 0.0, z = 0.0);
+            __builtin::geo3d::Cube(size_x = 1.0, size_y = 1.0, size_z = 1.0);
+        "#,
+        Rc::new(StlExporter),
+        "transformed_parts.stl",
+    );
+    assert_eq!(streamed, whole);
+    assert!(streamed.contains("vertex 11 1 1") && !streamed.contains("vertex 21"));
+
+    let (streamed, whole) = export(
+        r#"
+            __builtin::geo2d::Rect(width = 1.0, height = 1.0, x = 0.0, y = 0.0)
+                .__builtin::ops::translate(x = 10.0, y = 0.0, z = 0.0);
+            __builtin::geo2d::Rect(width = 1.0, height = 1.0, x = 0.0, y = 0.0);
+        "#,
+        Rc::new(WktExporter),
+        "transformed_parts.wkt",
+    );
+    assert!(streamed.contains("11 1") && !streamed.contains("21"));
+    assert!(whole.contains("11 1") && !whole.contains("21"));
+}
+
+#[test]
+fn export_parts() {
+    microcad_lang::env_logger_init();
+
+    use microcad_core::RenderResolution;
+    use microcad_export::parts::PartsExporter;
+    use microcad_lang::{builtin::Exporter, model::*, parse::source_file::SourceFile};
+    use std::rc::Rc;
+
+    let source_file = SourceFile::load_from_str(
+        r#"
+            __builtin::geo3d::Cube(size_x = 1.0, size_y = 1.0, size_z = 1.0)
+                .__builtin::ops::translate(x = 10.0, y = 0.0, z = 0.0);
+            __builtin::geo3d::Cube(size_x = 1.0, size_y = 1.0, size_z = 1.0)
+                .__builtin::ops::translate(x = 20.0, y = 0.0, z = 0.0);
+        "#,
+    )
+    .expect("parse error");
+    let mut context = ContextBuilder::new(source_file)
+        .with_builtin()
+        .expect("builtin error")
+        .build();
+    let model = context.eval().expect("eval error").expect("model");
+
+    let dir = std::path::Path::new("../target/export_parts");
+    let _ = std::fs::remove_dir_all(dir);
+    std::fs::create_dir_all(dir).expect("test error");
+    let export = ExportCommand {
+        filename: dir.join("assembly.parts"),
+        resolution: RenderResolution::coarse(),
+        exporter: Rc::new(PartsExporter),
+    };
+    export.render_and_export(&model).expect("export error");
+
+    // both copies of the cube refer to the same part file
+    let manifest = std::fs::read_to_string(&export.filename).expect("test error");
+    let parts: Vec<_> = manifest
+        .lines()
+        .filter(|line| line.contains("\"part\""))
+        .collect();
+    assert_eq!(parts.len(), 2);
+    assert_eq!(parts[0], parts[1]);
+    assert!(manifest.contains("10.0") && manifest.contains("20.0"));
+
+    // the part is placed by the manifest only
+    let part_files: Vec<_> = std::fs::read_dir(dir.join("parts"))
+        .expect("test error")
+        .map(|entry| entry.expect("test error").path())
+        .collect();
+    assert_eq!(part_files.len(), 1);
+    let part = std::fs::read_to_string(&part_files[0]).expect("test error");
+    assert!(part.contains("vertex 1 1 1") && !part.contains("vertex 11"));
+
+    // an existing part file is reused
+    std::fs::write(&part_files[0], "reused").expect("test error");
+    export.render_and_export(&model).expect("export error");
+    assert_eq!(
+        std::fs::read_to_string(&part_files[0]).expect("test error"),
+        "reused"
+    );
+
+    // parts of a model which has not been rendered are refused
+    std::fs::remove_file(&part_files[0]).expect("test error");
+    assert!(
+        PartsExporter
+            .export(&model, &dir.join("unrendered.parts"))
+            .is_err()
+    );
+    assert!(!part_files[0].exists());
+}
+
+#[test]
+fn export_if_changed() {
+    microcad_lang::env_logger_init();
+
+    use microcad_core::RenderResolution;
+    use microcad_export::wkt::WktExporter;
+    use microcad_lang::{model::*, parse::source_file::SourceFile, rc::RcMut, render::RenderCache};
+    use std::rc::Rc;
+
+    let eval = |source: &str| {
+        let source_file = SourceFile::load_from_str(source).expect("parse error");
+        let mut context = ContextBuilder::new(source_file)
+            .with_builtin()
+            .expect("builtin error")
+            .build();
+        context.eval().expect("eval error").expect("model")
+    };
+    let export = ExportCommand {
+        filename: "../target/export_if_changed.wkt".into(),
+        resolution: RenderResolution::coarse(),
+        exporter: Rc::new(WktExporter),
+    };
+    let _ = std::fs::remove_file(&export.filename);
+    let cache = RcMut::new(RenderCache::default());
+
+    let rect = "__builtin::geo2d::Rect(width = 1.0, height = 1.0, x = 0.0, y = 0.0);";
+    let model = eval(rect);
+    let exported = |model: &Model| {
+        export
+            .render_and_export_if_changed(model, cache.clone())
+            .expect("export error")
+            .is_some()
+    };
+    assert!(exported(&model));
+    // unchanged model is up to date
+    assert!(!exported(&eval(rect)));
+
+    // a changed attribute changes the output of some exporters
+    let colored = eval(&format!("#[color = \"red\"] {rect}"));
+    assert_ne!(export.stamp(&model), export.stamp(&colored));
+    assert!(exported(&colored));
+    assert!(!exported(&colored));
+
+    // a missing output is exported again
+    std::fs::remove_file(&export.filename).expect("test error");
+    assert!(exported(&colored));
+
+    // forced exports ignore the stamp
+    std::fs::write(&export.filename, "stale").expect("test error");
+    export
+        .render_and_export_with_cache(&colored, cache.clone())
+        .expect("export error");
+    assert_ne!(
+        std::fs::read_to_string(&export.filename).expect("test error"),
+        "stale"
+    );
+
+    // an export which fails after writing a partial output
+    struct FailingExporter;
+    impl microcad_lang::builtin::FileIoInterface for FailingExporter {
+        fn id(&self) -> microcad_lang::Id {
+            "failing".into()
+        }
+    }
+    impl microcad_lang::builtin::Exporter for FailingExporter {
+        fn export(
+            &self,
+            _: &Model,
+            filename: &std::path::Path,
+        ) -> Result<microcad_lang::value::Value, microcad_lang::builtin::ExportError> {
+            std::fs::write(filename, "partial")?;
+            Err(std::fmt::Error.into())
+        }
+    }
+    let failing = ExportCommand {
+        exporter: Rc::new(FailingExporter),
+        ..export.clone()
+    };
+    assert!(
+        failing
+            .render_and_export_if_changed(&model, cache.clone())
+            .is_err()
+    );
+    assert!(!export.stamp_filename().exists());
+    // the partial output is not taken as up to date
+    assert!(exported(&colored));
+    assert_ne!(
+        std::fs::read_to_string(&export.filename).expect("test error"),
+        "partial"
+    );
+}
+
+#[test]
+fn offset_and_minkowski_render_errors() {
+    microcad_lang::env_logger_init();
+
+    use microcad_core::RenderResolution;
+    use microcad_lang::{
+        diag::Diag,
+        model::*,
+        parse::source_file::SourceFile,
+        render::{RenderContext, RenderWithContext},
+    };
+
+    // `true` if `source` evaluates and renders without errors
+    let renders = |source: &str| {
+        let source_file = SourceFile::load_from_str(source).expect("parse error");
+        let mut context = ContextBuilder::new(source_file)
+            .with_builtin()
+            .expect("builtin error")
+            .build();
+        let model = match context.eval() {
+            Ok(Some(model)) if !context.has_errors() => model,
+            _ => return false,
+        };
+        let Ok(mut render_context) = RenderContext::init(&model, RenderResolution::coarse(), None)
+        else {
+            return false;
+        };
+        let rendered: Result<Model, _> = model.render_with_context(&mut render_context);
+        rendered.is_ok()
+    };
+
+    let rect = "__builtin::geo2d::Rect(x = 0.0, y = 0.0, width = 10.0, height = 10.0)";
+    let cube = "__builtin::geo3d::Cube(size_x = 1.0, size_y = 1.0, size_z = 1.0)";
+    assert!(renders(&format!("{rect}.__builtin::ops::offset(r = 1.0);")));
+    assert!(renders(&format!(
+        "{{ {cube}; {cube}; }}.__builtin::ops::minkowski();"
+    )));
+
+    // unknown join style
+    assert!(!renders(&format!(
+        "{rect}.__builtin::ops::offset(r = 1.0, join = \"square\");"
+    )));
+    // offset is 2D only, minkowski is 3D only
+    assert!(!renders(&format!(
+        "{cube}.__builtin::ops::offset(r = 1.0);"
+    )));
+    assert!(!renders(&format!(
+        "{{ {rect}; {rect}; }}.__builtin::ops::minkowski();"
+    )));
+}
@@ -48,6 +48,10 @@ pub enum CoreError {
     #[error("Export missing filename")]
     ExportMissingFilename,
 
+    /// Unknown join style for offset
+    #[error("Invalid join style `{0}` (expected `round`, `miter` or `bevel`)")]
+    InvalidJoinStyle(String),
+
     /// Cannot detect export format from extension
     #[error("Cannot detect export format from extension")]
     CannotDetectExportFormatFromExtension,
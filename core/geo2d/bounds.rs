@@ -3,10 +3,12 @@
 
 //! 2D Geometry bounds.
 
+use std::rc::Rc;
+
 use derive_more::Deref;
 use geo::coord;
 
-use crate::*;
+use crate::{traits::Align, *};
 
 /// Bounds2D type alias.
 pub type Bounds2D = Bounds<Vec2>;
@@ -27,6 +29,11 @@ impl Bounds2D {
         (self.max.y - self.min.y).max(0.0)
     }
 
+    /// Center of these bounds or `None` if bounds are invalid.
+    pub fn center(&self) -> Option<Vec2> {
+        self.is_valid().then(|| (self.min + self.max) * 0.5)
+    }
+
     /// Maximum of width and height.
     pub fn max_extent(&self) -> Scalar {
         self.width().max(self.height())
@@ -156,6 +163,36 @@ impl<T: CalcBounds2D + Transformed2D> Transformed2D for WithBounds2D<T> {
     }
 }
 
+impl Transformed2D for Bounds2D {
+    fn transformed_2d(&self, mat: &Mat3) -> Self {
+        let mut bounds = Bounds2D::default();
+        if self.is_valid() {
+            [
+                (self.min.x, self.min.y),
+                (self.max.x, self.min.y),
+                (self.min.x, self.max.y),
+                (self.max.x, self.max.y),
+            ]
+            .into_iter()
+            .for_each(|(x, y)| bounds.extend_by_point((*mat * Vec3::new(x, y, 1.0)).truncate()));
+        }
+        bounds
+    }
+}
+
+impl Align<WithBounds2D<Geometry2D>> for Rc<WithBounds2D<Geometry2D>> {
+    /// Move the geometry into the center of its bounds.
+    ///
+    /// The translation is lazy, so the geometry is shared instead of copied, and the stored
+    /// bounds are moved along instead of being calculated again.
+    fn align(&self) -> WithBounds2D<Geometry2D> {
+        match self.bounds.center() {
+            Some(d) => self.lazy_transformed_2d(&Mat3::from_translation(-d)),
+            None => self.as_ref().clone(),
+        }
+    }
+}
+
 impl From<Geometry2D> for WithBounds2D<Geometry2D> {
     fn from(geo: Geometry2D) -> Self {
         Self::new(geo)
@@ -172,3 +209,20 @@ fn bounds_2d_test() {
     assert_eq!(bounds1.min, Vec2::new(0.0, 1.0));
     assert_eq!(bounds1.max, Vec2::new(6.0, 7.0));
 }
+
+#[test]
+fn align_with_bounds_2d() {
+    let rect = Geometry2D::Rect(Rect::new((2.0, 4.0), (6.0, 8.0)));
+    let rect = Rc::new(WithBounds2D::new(rect));
+    let aligned = rect.align();
+
+    assert_eq!(aligned.bounds.min, Vec2::new(-2.0, -2.0));
+    assert_eq!(aligned.bounds.max, Vec2::new(2.0, 2.0));
+    assert_eq!(aligned.inner.calc_bounds_2d().min, aligned.bounds.min);
+
+    // the rectangle is moved lazily instead of being copied
+    match &aligned.inner {
+        Geometry2D::Transformed(transformed) => assert!(Rc::ptr_eq(&transformed.geometry, &rect)),
+        _ => panic!("lazy transformation expected"),
+    }
+}
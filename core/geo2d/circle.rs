@@ -38,10 +38,10 @@ impl FetchPoints2D for Circle {
     }
 }
 
-impl Render<Polygon> for Circle {
-    fn render(&self, resolution: &RenderResolution) -> Polygon {
+impl Circle {
+    /// Tessellate the circle into a polygon with `n` segments.
+    pub fn polygon(&self, n: u32) -> Polygon {
         use std::f64::consts::PI;
-        let n = resolution.circular_segments(self.radius);
         let points = (0..n)
             .map(|i| {
                 let angle = 2.0 * PI * (i as f64) / (n as f64);
@@ -52,3 +52,9 @@ impl Render<Polygon> for Circle {
         Polygon::new(LineString::new(points), vec![])
     }
 }
+
+impl Render<Polygon> for Circle {
+    fn render(&self, resolution: &RenderResolution) -> Polygon {
+        self.polygon(resolution.circular_segments(self.radius))
+    }
+}
@@ -4,7 +4,7 @@
 //! 2D Geometry collection
 
 use derive_more::{Deref, DerefMut};
-use geo::{CoordsIter, HasDimensions, MultiPolygon};
+use geo::{HasDimensions, MultiPolygon};
 use std::rc::Rc;
 
 use crate::{
@@ -67,39 +67,7 @@ impl Geometries2D {
 
     /// Apply contex hull operation to geometries.
     pub fn hull(&self) -> geo2d::Polygon {
-        let mut coords = self.iter().fold(Vec::new(), |mut coords, geo| {
-            match geo.as_ref() {
-                Geometry2D::LineString(line_string) => {
-                    coords.append(&mut line_string.coords_iter().collect())
-                }
-                Geometry2D::MultiLineString(multi_line_string) => {
-                    coords.append(&mut multi_line_string.coords_iter().collect())
-                }
-                Geometry2D::Polygon(polygon) => {
-                    coords.append(&mut polygon.exterior_coords_iter().collect())
-                }
-                Geometry2D::MultiPolygon(multi_polygon) => {
-                    coords.append(&mut multi_polygon.exterior_coords_iter().collect())
-                }
-                Geometry2D::Rect(rect) => {
-                    let mut rect_corners: Vec<_> = rect.coords_iter().collect();
-                    coords.append(&mut rect_corners)
-                }
-                Geometry2D::Line(line) => {
-                    coords.push(line.0.into());
-                    coords.push(line.1.into());
-                }
-                Geometry2D::Collection(collection) => {
-                    coords.append(&mut collection.hull().exterior_coords_iter().collect())
-                }
-            }
-            coords
-        });
-
-        geo2d::Polygon::new(
-            geo::algorithm::convex_hull::qhull::quick_hull(&mut coords),
-            vec![],
-        )
+        hull_2d(self.iter().map(Rc::as_ref))
     }
 }
 
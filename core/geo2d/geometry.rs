@@ -7,7 +7,7 @@ use crate::traits::Align;
 
 use super::*;
 
-use geo::{ConvexHull, MultiPolygon};
+use geo::MultiPolygon;
 use strum::IntoStaticStr;
 
 /// A 2D Geometry which is independent from resolution.
@@ -27,6 +27,8 @@ pub enum Geometry2D {
     Line(Line),
     /// Collection,
     Collection(Geometries2D),
+    /// Geometry with a pending transformation.
+    Transformed(LazyTransform2D),
 }
 
 impl Geometry2D {
@@ -52,37 +54,33 @@ impl Geometry2D {
             Geometry2D::MultiPolygon(multi_polygon) => multi_polygon.clone(),
             Geometry2D::Rect(rect) => MultiPolygon(vec![rect.to_polygon()]),
             Geometry2D::Collection(collection) => collection.to_multi_polygon(),
+            Geometry2D::Transformed(transformed) => transformed
+                .geometry
+                .to_multi_polygon()
+                .transformed_2d(&transformed.matrix),
         }
     }
 
     /// Apply hull operation.
     pub fn hull(&self) -> Self {
         match self {
-            Geometry2D::LineString(line_string) => Geometry2D::Polygon(line_string.convex_hull()),
-            Geometry2D::MultiLineString(multi_line_string) => {
-                Geometry2D::Polygon(multi_line_string.convex_hull())
-            }
-            Geometry2D::Polygon(polygon) => Geometry2D::Polygon(polygon.convex_hull()),
-            Geometry2D::MultiPolygon(multi_polygon) => {
-                Geometry2D::Polygon(multi_polygon.convex_hull())
-            }
             Geometry2D::Rect(rect) => Geometry2D::Rect(*rect),
-            Geometry2D::Line(line) => Geometry2D::Polygon(
-                LineString::new(vec![line.0.into(), line.1.into()]).convex_hull(),
-            ),
-            Geometry2D::Collection(collection) => Geometry2D::Polygon(collection.hull()),
+            _ => Geometry2D::Polygon(hull_2d([self])),
         }
     }
 
     /// Returns true if this geometry fills an area (e.g. like a polygon or circle).
     pub fn is_areal(&self) -> bool {
-        !matches!(
-            self,
-            Geometry2D::LineString(_)
-                | Geometry2D::MultiLineString(_)
-                | Geometry2D::Line(_)
-                | Geometry2D::Collection(_)
-        )
+        match self {
+            Geometry2D::Transformed(transformed) => transformed.geometry.is_areal(),
+            _ => !matches!(
+                self,
+                Geometry2D::LineString(_)
+                    | Geometry2D::MultiLineString(_)
+                    | Geometry2D::Line(_)
+                    | Geometry2D::Collection(_)
+            ),
+        }
     }
 
     /// Return this geometry with calculated bounds.
@@ -116,13 +114,16 @@ impl CalcBounds2D for Geometry2D {
             Geometry2D::Rect(rect) => Some(*rect).into(),
             Geometry2D::Line(line) => line.calc_bounds_2d(),
             Geometry2D::Collection(collection) => collection.calc_bounds_2d(),
+            Geometry2D::Transformed(transformed) => transformed.calc_bounds_2d(),
         }
     }
 }
 
 impl Transformed2D for Geometry2D {
     fn transformed_2d(&self, mat: &Mat3) -> Self {
-        if self.is_areal() {
+        if let Geometry2D::Transformed(transformed) = self {
+            Self::Transformed(transformed.transformed_2d(mat))
+        } else if self.is_areal() {
             let multi_polygon: MultiPolygon = self.clone().into();
             Self::MultiPolygon(multi_polygon.transformed_2d(mat))
         } else {
@@ -161,6 +162,7 @@ impl From<Geometry2D> for MultiPolygon {
             Geometry2D::MultiPolygon(multi_polygon) => multi_polygon,
             Geometry2D::Rect(rect) => MultiPolygon(vec![rect.to_polygon()]),
             Geometry2D::Collection(collection) => collection.into(),
+            Geometry2D::Transformed(transformed) => transformed.apply().into(),
             _ => MultiPolygon::empty(),
         }
     }
@@ -0,0 +1,148 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! 2D convex hull engine.
+//!
+//! Points are taken directly from the geometries (only exterior rings matter for the hull),
+//! points inside the octagon of extreme points are dropped (Akl-Toussaint heuristic) and
+//! the remaining ones are passed to quickhull.
+
+use geo::{Coord, CoordsIter};
+
+use crate::{hull::parallel_hull, *};
+
+/// Directions of the extreme points in counter clockwise order.
+const DIRECTIONS: [(f64, f64); 8] = [
+    (1.0, 0.0),
+    (1.0, 1.0),
+    (0.0, 1.0),
+    (-1.0, 1.0),
+    (-1.0, 0.0),
+    (-1.0, -1.0),
+    (0.0, -1.0),
+    (1.0, -1.0),
+];
+
+/// Add all points of a geometry which may be part of its convex hull.
+fn push_hull_coords(geometry: &Geometry2D, coords: &mut Vec<Coord>) {
+    match geometry {
+        Geometry2D::LineString(line_string) => coords.extend(line_string.coords()),
+        Geometry2D::MultiLineString(multi_line_string) => {
+            coords.extend(multi_line_string.coords_iter())
+        }
+        Geometry2D::Polygon(polygon) => coords.extend(polygon.exterior().coords()),
+        Geometry2D::MultiPolygon(multi_polygon) => multi_polygon
+            .iter()
+            .for_each(|polygon| coords.extend(polygon.exterior().coords())),
+        Geometry2D::Rect(rect) => coords.extend(rect.coords_iter()),
+        Geometry2D::Line(line) => {
+            coords.push(line.0.into());
+            coords.push(line.1.into());
+        }
+        Geometry2D::Collection(collection) => collection
+            .iter()
+            .for_each(|geometry| push_hull_coords(geometry, coords)),
+        Geometry2D::Transformed(transformed) => {
+            let start = coords.len();
+            push_hull_coords(&transformed.geometry, coords);
+            let affine = mat3_to_affine_transform(&transformed.matrix);
+            coords[start..]
+                .iter_mut()
+                .for_each(|coord| *coord = affine.apply(*coord));
+        }
+    }
+}
+
+/// Remove all points which are strictly inside the octagon of the extreme points.
+fn akl_toussaint(coords: &mut Vec<Coord>) {
+    let Some(first) = coords.first() else {
+        return;
+    };
+    let mut extremes = [*first; 8];
+    let mut maxima = [f64::MIN; 8];
+    coords.iter().for_each(|c| {
+        DIRECTIONS.iter().enumerate().for_each(|(i, (x, y))| {
+            let d = c.x * x + c.y * y;
+            if d > maxima[i] {
+                maxima[i] = d;
+                extremes[i] = *c;
+            }
+        })
+    });
+
+    let mut octagon: Vec<Coord> = Vec::with_capacity(8);
+    extremes.iter().for_each(|c| {
+        if octagon.last() != Some(c) && octagon.first() != Some(c) {
+            octagon.push(*c)
+        }
+    });
+    if octagon.len() < 3 {
+        return;
+    }
+
+    let edges: Vec<_> = octagon
+        .iter()
+        .zip(octagon.iter().cycle().skip(1))
+        .map(|(a, b)| (*a, *b - *a))
+        .collect();
+    coords.retain(|c| {
+        !edges.iter().all(|(a, edge)| {
+            let v = *c - *a;
+            edge.x * v.y - edge.y * v.x > 0.0
+        })
+    });
+}
+
+/// Return the closed counter clockwise hull ring of `coords`.
+fn quick_hull(mut coords: Vec<Coord>) -> Vec<Coord> {
+    geo::algorithm::convex_hull::qhull::quick_hull(&mut coords).0
+}
+
+/// Calculate the convex hull of some geometries.
+pub fn hull_2d<'a>(geometries: impl IntoIterator<Item = &'a Geometry2D>) -> Polygon {
+    let mut coords = Vec::new();
+    geometries
+        .into_iter()
+        .for_each(|geometry| push_hull_coords(geometry, &mut coords));
+
+    akl_toussaint(&mut coords);
+    Polygon::new(LineString::new(parallel_hull(coords, quick_hull)), vec![])
+}
+
+#[test]
+fn hull_2d_points() {
+    use geo::Area;
+
+    let square = Geometry2D::Rect(Rect::new(
+        Coord { x: 0.0, y: 0.0 },
+        Coord { x: 2.0, y: 2.0 },
+    ));
+    let inner = Geometry2D::Line(Line(geo::Point::new(0.5, 0.5), geo::Point::new(1.5, 1.0)));
+    let outer = Geometry2D::Line(Line(geo::Point::new(1.0, -1.0), geo::Point::new(1.0, 1.0)));
+    let collection = Geometry2D::Collection(Geometries2D::new(vec![inner, outer]));
+
+    let hull = hull_2d([&square, &collection]);
+    assert_eq!(hull.exterior().coords_count(), 6);
+    assert_eq!(hull.unsigned_area(), 5.0);
+}
+
+#[test]
+fn hull_2d_parallel() {
+    use geo::Area;
+
+    // many points on a circle
+    let n = 200_000;
+    let circle = Geometry2D::LineString(LineString::new(
+        (0..n)
+            .map(|i| {
+                let a = i as f64 / n as f64 * std::f64::consts::TAU;
+                Coord {
+                    x: a.cos(),
+                    y: a.sin(),
+                }
+            })
+            .collect(),
+    ));
+    let hull = hull_2d([&circle]);
+    assert!((hull.unsigned_area() - std::f64::consts::PI).abs() < 1e-6);
+}
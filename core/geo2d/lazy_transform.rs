@@ -0,0 +1,169 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! 2D geometry with a pending transformation.
+
+use std::rc::Rc;
+
+use crate::*;
+
+/// 2D geometry with a transformation which has not been applied yet.
+///
+/// Transforming it again just multiplies the matrices.
+/// The transformation is applied when the geometry is needed in world coordinates,
+/// e.g. by a boolean operation or an exporter.
+#[derive(Debug, Clone)]
+pub struct LazyTransform2D {
+    /// Untransformed geometry.
+    pub geometry: Rc<WithBounds2D<Geometry2D>>,
+    /// Pending transformation.
+    pub matrix: Mat3,
+}
+
+impl LazyTransform2D {
+    /// Create a lazy transformation of `geometry`.
+    ///
+    /// If `geometry` is lazily transformed itself, both matrices are combined.
+    pub fn new(geometry: Rc<WithBounds2D<Geometry2D>>, matrix: Mat3) -> Self {
+        match &geometry.inner {
+            Geometry2D::Transformed(transformed) => Self {
+                geometry: transformed.geometry.clone(),
+                matrix: matrix * transformed.matrix,
+            },
+            _ => Self { geometry, matrix },
+        }
+    }
+
+    /// Apply the transformation.
+    pub fn apply(&self) -> Geometry2D {
+        self.geometry.inner.transformed_2d(&self.matrix)
+    }
+}
+
+/// Does `mat` map axis-aligned boxes onto axis-aligned boxes, i.e. does it only scale, mirror,
+/// swap axes and translate?
+fn is_axis_aligned(mat: &Mat3) -> bool {
+    (mat.x.y == 0.0 && mat.y.x == 0.0) || (mat.x.x == 0.0 && mat.y.y == 0.0)
+}
+
+/// Bounds of the coordinates of `geometry` transformed by `mat`.
+fn transformed_bounds(geometry: &Geometry2D, mat: &Mat3, bounds: &mut Bounds2D) {
+    use geo::CoordsIter;
+
+    let mut extend = |coord: geo::Coord| {
+        bounds.extend_by_point((*mat * Vec3::new(coord.x, coord.y, 1.0)).truncate())
+    };
+    match geometry {
+        Geometry2D::LineString(line_string) => line_string.coords_iter().for_each(extend),
+        Geometry2D::MultiLineString(multi_line_string) => {
+            multi_line_string.coords_iter().for_each(extend)
+        }
+        Geometry2D::Polygon(polygon) => polygon.exterior().coords_iter().for_each(extend),
+        Geometry2D::MultiPolygon(multi_polygon) => multi_polygon
+            .iter()
+            .for_each(|polygon| polygon.exterior().coords_iter().for_each(&mut extend)),
+        Geometry2D::Rect(rect) => rect.coords_iter().for_each(extend),
+        Geometry2D::Line(line) => [line.0.0, line.1.0].into_iter().for_each(extend),
+        Geometry2D::Collection(collection) => collection
+            .iter()
+            .for_each(|geometry| transformed_bounds(geometry, mat, bounds)),
+        Geometry2D::Transformed(transformed) => transformed_bounds(
+            &transformed.geometry.inner,
+            &(*mat * transformed.matrix),
+            bounds,
+        ),
+    }
+}
+
+impl CalcBounds2D for LazyTransform2D {
+    /// Transform the cached bounds if the matrix keeps boxes axis-aligned, otherwise the bounds
+    /// of the rotated box would be too large and the coordinates are transformed instead.
+    fn calc_bounds_2d(&self) -> Bounds2D {
+        match is_axis_aligned(&self.matrix) {
+            true => self.geometry.bounds.transformed_2d(&self.matrix),
+            false => {
+                let mut bounds = Bounds2D::default();
+                transformed_bounds(&self.geometry.inner, &self.matrix, &mut bounds);
+                bounds
+            }
+        }
+    }
+}
+
+impl Transformed2D for LazyTransform2D {
+    fn transformed_2d(&self, mat: &Mat3) -> Self {
+        Self {
+            geometry: self.geometry.clone(),
+            matrix: *mat * self.matrix,
+        }
+    }
+}
+
+impl WithBounds2D<Geometry2D> {
+    /// Transform a shared geometry without copying it.
+    ///
+    /// The bounds of `self` are exact, so they are transformed directly unless `mat` rotates.
+    /// Only then the positions are walked.
+    pub fn lazy_transformed_2d(self: &Rc<Self>, mat: &Mat3) -> Self {
+        let transformed = LazyTransform2D::new(self.clone(), *mat);
+        Self {
+            bounds: match is_axis_aligned(mat) {
+                true => self.bounds.transformed_2d(mat),
+                false => transformed.calc_bounds_2d(),
+            },
+            inner: Geometry2D::Transformed(transformed),
+        }
+    }
+}
+
+#[test]
+fn lazy_transform_2d() {
+    use cgmath::SquareMatrix;
+
+    let rect: Rc<WithBounds2D<Geometry2D>> =
+        Rc::new(Geometry2D::Rect(Rect::new((0.0, 0.0), (1.0, 1.0))).into());
+    let translated =
+        Rc::new(rect.lazy_transformed_2d(&Mat3::from_translation(Vec2::new(2.0, 0.0))));
+    let scaled = translated.lazy_transformed_2d(&Mat3::from_nonuniform_scale(2.0, 3.0));
+
+    match &scaled.inner {
+        Geometry2D::Transformed(transformed) => {
+            // no nesting of lazy transformations
+            assert!(Rc::ptr_eq(&transformed.geometry, &rect));
+            assert_ne!(transformed.matrix, Mat3::identity());
+        }
+        _ => panic!("lazy transformation expected"),
+    }
+    assert_eq!(scaled.bounds.min, Vec2::new(4.0, 0.0));
+    assert_eq!(scaled.bounds.max, Vec2::new(6.0, 3.0));
+    assert_eq!(
+        scaled.inner.to_multi_polygon().calc_bounds_2d().max,
+        scaled.bounds.max
+    );
+}
+
+#[test]
+fn lazy_transform_rotated_bounds() {
+    use cgmath::InnerSpace;
+
+    let triangle: Rc<WithBounds2D<Geometry2D>> = Rc::new(
+        Geometry2D::Polygon(Polygon::new(
+            LineString::from(vec![(0.0, 0.0), (1.0, 0.0), (0.0, 1.0)]),
+            vec![],
+        ))
+        .into(),
+    );
+    let rotated = triangle.lazy_transformed_2d(&Mat3::from_angle_z(cgmath::Deg(45.0)));
+
+    // the bounds of the rotated triangle, not of its rotated bounding box
+    let exact = rotated.inner.to_multi_polygon().calc_bounds_2d();
+    assert!((rotated.bounds.min - exact.min).magnitude() < 1e-9);
+    assert!((rotated.bounds.max - exact.max).magnitude() < 1e-9);
+    assert!((rotated.bounds.center().expect("bounds").y - 0.5_f64.sqrt() / 2.0).abs() < 1e-9);
+
+    // scaling after the rotation transforms the exact bounds of the rotated triangle
+    let scaled = Rc::new(rotated).lazy_transformed_2d(&Mat3::from_nonuniform_scale(2.0, 3.0));
+    let exact = scaled.inner.to_multi_polygon().calc_bounds_2d();
+    assert!((scaled.bounds.min - exact.min).magnitude() < 1e-9);
+    assert!((scaled.bounds.max - exact.max).magnitude() < 1e-9);
+}
@@ -7,9 +7,13 @@ mod bounds;
 mod circle;
 mod collection;
 mod geometry;
+mod hull;
+mod lazy_transform;
 mod line;
+mod offset;
 mod primitives;
 mod size;
+mod triangulate;
 
 use crate::*;
 
@@ -18,9 +22,13 @@ pub use circle::*;
 pub use collection::*;
 use geo::AffineTransform;
 pub use geometry::*;
+pub use hull::*;
+pub use lazy_transform::*;
 pub use line::*;
+pub use offset::*;
 pub use primitives::*;
 pub use size::*;
+pub use triangulate::*;
 
 /// Trait to return all points of 2D geometry.
 pub trait FetchPoints2D {
@@ -0,0 +1,109 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! 2D offset (polygon buffering).
+
+use geo::{Buffer, BufferStyle, LineJoin};
+
+use crate::*;
+
+/// How corners are joined when offsetting a geometry outwards.
+#[derive(Debug, Clone, PartialEq)]
+pub enum JoinStyle {
+    /// Circular arc around the corner.
+    Round,
+    /// Sharp corner which is cut off if it exceeds the given limit (relative to the offset).
+    Miter(Scalar),
+    /// Corner cut off straight.
+    Bevel,
+}
+
+impl std::str::FromStr for JoinStyle {
+    type Err = CoreError;
+
+    fn from_str(s: &str) -> Result<Self, Self::Err> {
+        match s {
+            "round" => Ok(Self::Round),
+            "miter" => Ok(Self::Miter(2.0)),
+            "bevel" => Ok(Self::Bevel),
+            _ => Err(CoreError::InvalidJoinStyle(s.to_string())),
+        }
+    }
+}
+
+/// Trait to offset the outline of a geometry.
+pub trait Offset {
+    /// Grow (positive `distance`) or shrink (negative `distance`) the areal parts of a geometry.
+    ///
+    /// The number of segments of round corners is taken from the `resolution`.
+    fn offset(
+        &self,
+        distance: Scalar,
+        join: &JoinStyle,
+        resolution: &RenderResolution,
+    ) -> MultiPolygon;
+}
+
+impl Offset for MultiPolygon {
+    fn offset(
+        &self,
+        distance: Scalar,
+        join: &JoinStyle,
+        resolution: &RenderResolution,
+    ) -> MultiPolygon {
+        if distance == 0.0 {
+            return self.clone();
+        }
+        let line_join = match join {
+            JoinStyle::Round => LineJoin::Round(
+                std::f64::consts::TAU / resolution.circular_segments(distance.abs()) as Scalar,
+            ),
+            JoinStyle::Miter(limit) => LineJoin::Miter(*limit),
+            JoinStyle::Bevel => LineJoin::Bevel,
+        };
+        self.buffer_with_style(BufferStyle::new(distance).line_join(line_join))
+    }
+}
+
+impl Offset for Geometry2D {
+    fn offset(
+        &self,
+        distance: Scalar,
+        join: &JoinStyle,
+        resolution: &RenderResolution,
+    ) -> MultiPolygon {
+        self.to_multi_polygon().offset(distance, join, resolution)
+    }
+}
+
+impl Offset for Geometries2D {
+    fn offset(
+        &self,
+        distance: Scalar,
+        join: &JoinStyle,
+        resolution: &RenderResolution,
+    ) -> MultiPolygon {
+        // unite first so that overlapping children do not produce inner borders
+        self.boolean_op(&BooleanOp::Union)
+            .offset(distance, join, resolution)
+    }
+}
+
+#[test]
+fn offset_square() {
+    use geo::Area;
+
+    let square = Geometry2D::Rect(Rect::new((0.0, 0.0), (10.0, 10.0)));
+    let resolution = RenderResolution::default();
+
+    let grown = square.offset(1.0, &JoinStyle::Miter(2.0), &resolution);
+    assert!((grown.unsigned_area() - 144.0).abs() < 1e-6);
+
+    let shrunk = square.offset(-1.0, &JoinStyle::Round, &resolution);
+    assert!((shrunk.unsigned_area() - 64.0).abs() < 1e-6);
+
+    let rounded = square.offset(1.0, &JoinStyle::Round, &resolution);
+    let expected = 100.0 + 40.0 + std::f64::consts::PI;
+    assert!(rounded.unsigned_area() < expected);
+    assert!(rounded.unsigned_area() > expected - 0.5);
+}
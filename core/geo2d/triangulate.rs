@@ -0,0 +1,628 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Polygon triangulation.
+//!
+//! Simple polygons are triangulated by earcut.
+//! Earcut bridges each hole into the exterior ring and slows down to nearly quadratic time on
+//! polygons with many holes, so these are split into y-monotone pieces by a sweep line and each
+//! piece is triangulated in linear time.
+//! Sorting the vertices and searching the sweep status take *O(n log n)* time, but the status is
+//! a sorted array, so inserting and removing edges moves up to *h* entries for *h* holes, which
+//! makes *O(n·h)* in the worst case, a plain memory move compared to the bridging of earcut.
+//! The sweep checks its result (number of triangles and area) and falls back to earcut for
+//! degenerate input, e.g. holes touching each other.
+
+use geo::{Coord, TriangulateEarcut};
+
+use crate::*;
+
+/// Triangulation algorithm.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum TriangulationMethod {
+    /// Earcut for simple polygons, monotone decomposition for polygons with holes.
+    #[default]
+    Auto,
+    /// Earcut.
+    Earcut,
+    /// Monotone decomposition (falls back to earcut for degenerate input).
+    Monotone,
+}
+
+/// Triangulated area.
+#[derive(Clone, Debug, Default)]
+pub struct Triangulation {
+    /// Vertices.
+    pub vertices: Vec<Vec2>,
+    /// Counter clockwise triangles.
+    pub triangles: Vec<Triangle<u32>>,
+}
+
+impl Triangulation {
+    /// Append another triangulation.
+    pub fn append(&mut self, other: Triangulation) {
+        let offset = self.vertices.len() as u32;
+        self.vertices.extend(other.vertices);
+        self.triangles.extend(
+            other
+                .triangles
+                .into_iter()
+                .map(|t| Triangle(t.0 + offset, t.1 + offset, t.2 + offset)),
+        );
+    }
+}
+
+/// Triangulate the area of a geometry.
+pub trait Triangulate {
+    /// Triangulate with the given method.
+    fn triangulate_with(&self, method: TriangulationMethod) -> Triangulation;
+
+    /// Triangulate with [`TriangulationMethod::Auto`].
+    fn triangulate(&self) -> Triangulation {
+        self.triangulate_with(TriangulationMethod::Auto)
+    }
+}
+
+impl Triangulate for Polygon {
+    fn triangulate_with(&self, method: TriangulationMethod) -> Triangulation {
+        let monotone = match method {
+            TriangulationMethod::Auto => !self.interiors().is_empty(),
+            TriangulationMethod::Earcut => false,
+            TriangulationMethod::Monotone => true,
+        };
+        let rings = std::iter::once(self.exterior())
+            .chain(self.interiors())
+            .map(|ring| ring.0.as_slice());
+        match monotone.then(|| MonotoneSweep::new(rings).triangulate()) {
+            Some(Some((vertices, triangles))) => Triangulation {
+                vertices: vertices
+                    .into_iter()
+                    .map(|coord| Vec2::new(coord.x, coord.y))
+                    .collect(),
+                triangles,
+            },
+            Some(None) => {
+                log::debug!("Monotone triangulation failed, using earcut");
+                earcut(self)
+            }
+            None => earcut(self),
+        }
+    }
+}
+
+impl Triangulate for MultiPolygon {
+    fn triangulate_with(&self, method: TriangulationMethod) -> Triangulation {
+        let mut triangulation = Triangulation::default();
+        self.iter()
+            .for_each(|polygon| triangulation.append(polygon.triangulate_with(method)));
+        triangulation
+    }
+}
+
+fn earcut(polygon: &Polygon) -> Triangulation {
+    let raw_triangulation = polygon.earcut_triangles_raw();
+    let vertices = &raw_triangulation.vertices;
+    Triangulation {
+        vertices: vertices
+            .chunks_exact(2)
+            .map(|chunk| Vec2::new(chunk[0], chunk[1]))
+            .collect(),
+        triangles: raw_triangulation
+            .triangle_indices
+            .chunks_exact(3)
+            .map(|chunk| {
+                let (a, b, c) = (chunk[0], chunk[1], chunk[2]);
+                let coord = |i: usize| Vec2::new(vertices[2 * i], vertices[2 * i + 1]);
+                let (pa, pb, pc) = (coord(a), coord(b), coord(c));
+                match (pb - pa).perp_dot(pc - pa) < 0.0 {
+                    true => Triangle(a as u32, c as u32, b as u32),
+                    false => Triangle(a as u32, b as u32, c as u32),
+                }
+            })
+            .collect(),
+    }
+}
+
+/// Vertex of a polygon ring.
+#[derive(Clone, Copy)]
+struct SweepVertex {
+    coord: Coord,
+    prev: usize,
+    next: usize,
+}
+
+/// Kind of a vertex with respect to a downward sweep.
+#[derive(Clone, Copy, PartialEq, Eq)]
+enum VertexKind {
+    /// Both neighbors are below, the interior angle is less than 180°.
+    Start,
+    /// Both neighbors are below, the interior angle is greater than 180°.
+    Split,
+    /// Both neighbors are above, the interior angle is less than 180°.
+    End,
+    /// Both neighbors are above, the interior angle is greater than 180°.
+    Merge,
+    /// One neighbor is above and one is below.
+    Regular,
+}
+
+/// Triangulation of a polygon with holes by decomposition into y-monotone pieces.
+///
+/// The exterior ring is oriented counter clockwise and the holes clockwise, so the interior is
+/// always left of an edge.
+/// Vertices with equal y are ordered by x, as if the plane was rotated by an infinitesimal angle.
+/// Each edge is identified by the index of its start vertex.
+struct MonotoneSweep {
+    vertices: Vec<SweepVertex>,
+    /// Number of holes.
+    holes: usize,
+    /// Area of the polygon.
+    area: f64,
+}
+
+impl MonotoneSweep {
+    /// Collect the rings of a polygon, exterior first.
+    fn new<'a>(rings: impl Iterator<Item = &'a [Coord]>) -> Self {
+        let mut sweep = Self {
+            vertices: Vec::new(),
+            holes: 0,
+            area: 0.0,
+        };
+        for (n, ring) in rings.enumerate() {
+            let mut coords: Vec<Coord> = Vec::with_capacity(ring.len());
+            ring.iter().for_each(|coord| {
+                if coords.last() != Some(coord) {
+                    coords.push(*coord)
+                }
+            });
+            if coords.len() > 1 && coords.first() == coords.last() {
+                coords.pop();
+            }
+
+            let area = coords
+                .iter()
+                .zip(coords.iter().cycle().skip(1))
+                .map(|(a, b)| a.x * b.y - b.x * a.y)
+                .sum::<f64>()
+                / 2.0;
+            if coords.len() < 3 || area == 0.0 {
+                match n {
+                    0 => return sweep,
+                    _ => continue,
+                }
+            }
+            if (area > 0.0) != (n == 0) {
+                coords.reverse();
+            }
+            match n {
+                0 => sweep.area += area.abs(),
+                _ => {
+                    sweep.area -= area.abs();
+                    sweep.holes += 1;
+                }
+            }
+
+            let first = sweep.vertices.len();
+            let last = first + coords.len() - 1;
+            sweep
+                .vertices
+                .extend(coords.into_iter().enumerate().map(|(i, coord)| {
+                    let v = first + i;
+                    SweepVertex {
+                        coord,
+                        prev: if v == first { last } else { v - 1 },
+                        next: if v == last { first } else { v + 1 },
+                    }
+                }));
+        }
+        sweep
+    }
+
+    /// Return the vertices and the triangles or `None` if the input is degenerate.
+    fn triangulate(&self) -> Option<(Vec<Coord>, Vec<Triangle<u32>>)> {
+        let mut triangles = Vec::new();
+        if !self.vertices.is_empty() {
+            let diagonals = self.diagonals()?;
+            for face in self.faces(&diagonals)? {
+                self.triangulate_monotone(&face, &mut triangles)?;
+            }
+
+            // A triangulation of a polygon with n vertices and h holes has n + 2h - 2 triangles.
+            if triangles.len() != self.vertices.len() + 2 * self.holes - 2 {
+                return None;
+            }
+            let area = triangles
+                .iter()
+                .map(|t| self.orient(t.0 as usize, t.1 as usize, t.2 as usize).abs())
+                .sum::<f64>()
+                / 2.0;
+            if (area - self.area).abs() > 1e-9 * self.area.max(f64::MIN_POSITIVE) {
+                return None;
+            }
+        }
+        Some((
+            self.vertices.iter().map(|vertex| vertex.coord).collect(),
+            triangles,
+        ))
+    }
+
+    /// Order of the sweep: higher vertices first, vertices with equal y from left to right.
+    fn cmp(&self, a: usize, b: usize) -> std::cmp::Ordering {
+        let (a, b) = (self.vertices[a].coord, self.vertices[b].coord);
+        b.y.total_cmp(&a.y).then(a.x.total_cmp(&b.x))
+    }
+
+    fn is_above(&self, a: usize, b: usize) -> bool {
+        self.cmp(a, b).is_lt()
+    }
+
+    /// Twice the signed area of a triangle (positive if counter clockwise).
+    fn orient(&self, a: usize, b: usize, c: usize) -> f64 {
+        let (a, b, c) = (
+            self.vertices[a].coord,
+            self.vertices[b].coord,
+            self.vertices[c].coord,
+        );
+        (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)
+    }
+
+    fn kind(&self, v: usize) -> VertexKind {
+        let SweepVertex { prev, next, .. } = self.vertices[v];
+        let convex = self.orient(prev, v, next) > 0.0;
+        match (self.is_above(v, prev), self.is_above(v, next), convex) {
+            (true, true, true) => VertexKind::Start,
+            (true, true, false) => VertexKind::Split,
+            (false, false, true) => VertexKind::End,
+            (false, false, false) => VertexKind::Merge,
+            _ => VertexKind::Regular,
+        }
+    }
+
+    /// X coordinate of an edge on the sweep line through vertex `v`.
+    fn x_at(&self, edge: usize, v: usize) -> f64 {
+        let a = self.vertices[edge].coord;
+        let b = self.vertices[self.vertices[edge].next].coord;
+        let v = self.vertices[v].coord;
+        if a.y == b.y {
+            v.x
+        } else {
+            a.x + (v.y - a.y) * (b.x - a.x) / (b.y - a.y)
+        }
+    }
+
+    /// Position of vertex `v` in the status, which is sorted by x along the sweep line.
+    fn status_position(&self, status: &[usize], v: usize) -> usize {
+        let x = self.vertices[v].coord.x;
+        status.partition_point(|edge| self.x_at(*edge, v) < x)
+    }
+
+    /// Sweep from top to bottom and return the diagonals which split the polygon into
+    /// y-monotone pieces.
+    ///
+    /// The status holds all edges with the interior to their right which are crossed by
+    /// the sweep line, each with a helper vertex to which a diagonal may be drawn.
+    fn diagonals(&self) -> Option<Vec<(usize, usize)>> {
+        let n = self.vertices.len();
+        let kinds: Vec<_> = (0..n).map(|v| self.kind(v)).collect();
+        let mut order: Vec<_> = (0..n).collect();
+        order.sort_unstable_by(|a, b| self.cmp(*a, *b));
+
+        let mut status: Vec<usize> = Vec::new();
+        let mut helper: Vec<Option<usize>> = vec![None; n];
+        let mut diagonals = Vec::new();
+
+        // the removed edge ends at `v`, so it is searched next to the position of `v`
+        let remove = |status: &mut Vec<usize>, edge: usize, v: usize| -> Option<()> {
+            let position = self.status_position(status, v).saturating_sub(1);
+            let position = (position..status.len())
+                .chain((0..position).rev())
+                .find(|position| status[*position] == edge)?;
+            status.remove(position);
+            Some(())
+        };
+        let left_of = |status: &[usize], v: usize| -> Option<usize> {
+            match self.status_position(status, v) {
+                0 => None,
+                position => Some(status[position - 1]),
+            }
+        };
+
+        for v in order {
+            let prev = self.vertices[v].prev;
+            let mut connect_merge_helper = |edge: usize, diagonals: &mut Vec<_>| -> Option<()> {
+                let helper = helper[edge]?;
+                if kinds[helper] == VertexKind::Merge {
+                    diagonals.push((v, helper));
+                }
+                Some(())
+            };
+
+            match kinds[v] {
+                VertexKind::Start => {
+                    status.insert(self.status_position(&status, v), v);
+                    helper[v] = Some(v);
+                }
+                VertexKind::End => {
+                    connect_merge_helper(prev, &mut diagonals)?;
+                    remove(&mut status, prev, v)?;
+                }
+                VertexKind::Split => {
+                    let edge = left_of(&status, v)?;
+                    diagonals.push((v, helper[edge]?));
+                    helper[edge] = Some(v);
+                    status.insert(self.status_position(&status, v), v);
+                    helper[v] = Some(v);
+                }
+                VertexKind::Merge => {
+                    connect_merge_helper(prev, &mut diagonals)?;
+                    remove(&mut status, prev, v)?;
+                    let edge = left_of(&status, v)?;
+                    connect_merge_helper(edge, &mut diagonals)?;
+                    helper[edge] = Some(v);
+                }
+                // the interior is right of `v`
+                VertexKind::Regular if self.is_above(prev, v) => {
+                    connect_merge_helper(prev, &mut diagonals)?;
+                    remove(&mut status, prev, v)?;
+                    status.insert(self.status_position(&status, v), v);
+                    helper[v] = Some(v);
+                }
+                VertexKind::Regular => {
+                    let edge = left_of(&status, v)?;
+                    connect_merge_helper(edge, &mut diagonals)?;
+                    helper[edge] = Some(v);
+                }
+            }
+        }
+        Some(diagonals)
+    }
+
+    /// Split the polygon along the diagonals into counter clockwise faces.
+    fn faces(&self, diagonals: &[(usize, usize)]) -> Option<Vec<Vec<usize>>> {
+        let n = self.vertices.len();
+        let mut edges: Vec<(usize, usize)> = (0..n).map(|v| (v, self.vertices[v].next)).collect();
+        diagonals.iter().for_each(|(a, b)| {
+            edges.push((*a, *b));
+            edges.push((*b, *a));
+        });
+
+        let angle = |from: usize, to: usize| {
+            let (from, to) = (self.vertices[from].coord, self.vertices[to].coord);
+            (to.y - from.y).atan2(to.x - from.x)
+        };
+        let mut outgoing: Vec<Vec<(f64, usize)>> = vec![Vec::new(); n];
+        edges
+            .iter()
+            .enumerate()
+            .for_each(|(edge, (from, to))| outgoing[*from].push((angle(*from, *to), edge)));
+
+        let mut visited = vec![false; edges.len()];
+        let mut faces = Vec::new();
+        for start in 0..edges.len() {
+            if visited[start] {
+                continue;
+            }
+            let mut face = Vec::new();
+            let mut edge = start;
+            loop {
+                if visited[edge] {
+                    return None;
+                }
+                visited[edge] = true;
+                let (from, to) = edges[edge];
+                face.push(from);
+
+                // turn to the next edge clockwise from the way back
+                let back = angle(to, from);
+                let outgoing = &outgoing[to];
+                let max_angle = |a: &&(f64, usize), b: &&(f64, usize)| a.0.total_cmp(&b.0);
+                edge = outgoing
+                    .iter()
+                    .filter(|(angle, _)| *angle < back)
+                    .max_by(max_angle)
+                    .or_else(|| outgoing.iter().max_by(max_angle))?
+                    .1;
+                if edge == start {
+                    break;
+                }
+            }
+            faces.push(face);
+        }
+        Some(faces)
+    }
+
+    /// Triangulate a counter clockwise y-monotone face.
+    fn triangulate_monotone(
+        &self,
+        face: &[usize],
+        triangles: &mut Vec<Triangle<u32>>,
+    ) -> Option<()> {
+        let m = face.len();
+        if m < 3 {
+            return None;
+        }
+        let mut emit = |a: usize, b: usize, c: usize| {
+            let (a, b, c) = (face[a], face[b], face[c]);
+            triangles.push(match self.orient(a, b, c) < 0.0 {
+                true => Triangle(a as u32, c as u32, b as u32),
+                false => Triangle(a as u32, b as u32, c as u32),
+            });
+        };
+
+        let mut sorted: Vec<_> = (0..m).collect();
+        sorted.sort_unstable_by(|a, b| self.cmp(face[*a], face[*b]));
+        let (top, bottom) = (sorted[0], sorted[m - 1]);
+
+        // walking counter clockwise from the top leads down the left chain
+        let mut left = vec![false; m];
+        let mut i = (top + 1) % m;
+        while i != bottom {
+            left[i] = true;
+            i = (i + 1) % m;
+        }
+
+        let mut stack = vec![sorted[0], sorted[1]];
+        for &j in &sorted[2..m - 1] {
+            let last = *stack.last()?;
+            if left[j] != left[last] {
+                stack.windows(2).for_each(|w| emit(j, w[0], w[1]));
+                stack = vec![last, j];
+            } else {
+                let mut last = stack.pop()?;
+                while let Some(&t) = stack.last() {
+                    let inside = match left[j] {
+                        true => self.orient(face[t], face[last], face[j]) > 0.0,
+                        false => self.orient(face[j], face[last], face[t]) > 0.0,
+                    };
+                    if !inside {
+                        break;
+                    }
+                    emit(j, last, t);
+                    last = t;
+                    stack.pop();
+                }
+                stack.push(last);
+                stack.push(j);
+            }
+        }
+        stack.windows(2).for_each(|w| emit(bottom, w[0], w[1]));
+        Some(())
+    }
+}
+
+#[test]
+fn triangulate_plate_with_holes() {
+    use geo::Area;
+
+    // 40 x 40 plate with 10 x 10 square and octagonal holes
+    let octagon = |x: f64, y: f64| {
+        LineString::new(
+            (0..8)
+                .map(|i| {
+                    let a = i as f64 * std::f64::consts::FRAC_PI_4;
+                    Coord {
+                        x: x + a.cos(),
+                        y: y + a.sin(),
+                    }
+                })
+                .collect(),
+        )
+    };
+    let square = |x: f64, y: f64| {
+        LineString::from(vec![
+            (x - 1.0, y - 1.0),
+            (x + 1.0, y - 1.0),
+            (x + 1.0, y + 1.0),
+            (x - 1.0, y + 1.0),
+        ])
+    };
+    let holes = (0..10)
+        .flat_map(|i| (0..10).map(move |j| (i, j)))
+        .map(|(i, j)| {
+            let (x, y) = (i as f64 * 4.0 + 2.0, j as f64 * 4.0 + 2.0);
+            match (i + j) % 2 {
+                0 => square(x, y),
+                _ => octagon(x, y),
+            }
+        })
+        .collect();
+    let plate = Polygon::new(
+        LineString::from(vec![(0.0, 0.0), (40.0, 0.0), (40.0, 40.0), (0.0, 40.0)]),
+        holes,
+    );
+
+    let rings = std::iter::once(plate.exterior())
+        .chain(plate.interiors())
+        .map(|ring| ring.0.as_slice());
+    let (vertices, triangles) = MonotoneSweep::new(rings)
+        .triangulate()
+        .expect("monotone triangulation");
+    assert_eq!(triangles.len(), vertices.len() + 2 * 100 - 2);
+
+    let triangulation = plate.triangulate();
+    let area: f64 = triangulation
+        .triangles
+        .iter()
+        .map(|t| {
+            let (a, b, c) = (
+                triangulation.vertices[t.0 as usize],
+                triangulation.vertices[t.1 as usize],
+                triangulation.vertices[t.2 as usize],
+            );
+            ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) / 2.0
+        })
+        .sum();
+    assert!((area - plate.unsigned_area()).abs() < 1e-9);
+}
+
+#[test]
+fn triangulate_degenerate_holes() {
+    use geo::Area;
+
+    let square = |x: f64, y: f64, size: f64| {
+        LineString::from(vec![
+            (x, y),
+            (x + size, y),
+            (x + size, y + size),
+            (x, y + size),
+        ])
+    };
+    let plate = |holes: Vec<LineString>| Polygon::new(square(0.0, 0.0, 10.0), holes);
+    let sweep = |polygon: &Polygon| {
+        let rings = std::iter::once(polygon.exterior())
+            .chain(polygon.interiors())
+            .map(|ring| ring.0.as_slice());
+        MonotoneSweep::new(rings)
+            .triangulate()
+            .map(|(_, triangles)| triangles.len())
+    };
+    let area = |polygon: &Polygon| {
+        let triangulation = polygon.triangulate_with(TriangulationMethod::Monotone);
+        triangulation
+            .triangles
+            .iter()
+            .map(|t| {
+                let (a, b, c) = (
+                    triangulation.vertices[t.0 as usize],
+                    triangulation.vertices[t.1 as usize],
+                    triangulation.vertices[t.2 as usize],
+                );
+                ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) / 2.0
+            })
+            .sum::<f64>()
+    };
+
+    // collinear edges and holes touching at a corner are handled by the sweep
+    for (holes, triangles) in [
+        (vec![square(2.0, 2.0, 2.0), square(6.0, 2.0, 2.0)], 14),
+        (vec![square(2.0, 2.0, 2.0), square(2.0, 6.0, 2.0)], 14),
+        (vec![square(2.0, 2.0, 2.0), square(4.0, 4.0, 2.0)], 14),
+        (
+            vec![LineString::from(vec![
+                (2.0, 2.0),
+                (3.0, 2.0),
+                (4.0, 2.0),
+                (4.0, 4.0),
+                (2.0, 4.0),
+            ])],
+            9,
+        ),
+    ] {
+        let polygon = plate(holes);
+        assert_eq!(sweep(&polygon), Some(triangles));
+        assert!((area(&polygon) - polygon.unsigned_area()).abs() < 1e-9);
+    }
+
+    // holes sharing an edge or a tip fall back to earcut
+    for holes in [
+        vec![square(2.0, 2.0, 2.0), square(4.0, 2.0, 2.0)],
+        vec![
+            LineString::from(vec![(3.0, 5.0), (5.0, 3.0), (7.0, 5.0), (5.0, 7.0)]),
+            LineString::from(vec![(5.0, 7.0), (6.0, 8.0), (5.0, 9.0), (4.0, 8.0)]),
+        ],
+    ] {
+        let polygon = plate(holes);
+        assert_eq!(sweep(&polygon), None);
+        assert!((area(&polygon) - polygon.unsigned_area()).abs() < 1e-9);
+    }
+}
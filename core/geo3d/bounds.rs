@@ -1,10 +1,12 @@
 // Copyright © 2025 The µcad authors <info@ucad.xyz>
 // SPDX-License-Identifier: AGPL-3.0-or-later
 
+use std::rc::Rc;
+
 use cgmath::ElementWise;
 use derive_more::Deref;
 
-use crate::*;
+use crate::{traits::Align, *};
 
 /// Bounds3D type alias.
 pub type Bounds3D = Bounds<Vec3>;
@@ -73,6 +75,11 @@ impl Bounds3D {
         }
     }
 
+    /// Center of these bounds or `None` if bounds are invalid.
+    pub fn center(&self) -> Option<Vec3> {
+        self.is_valid().then(|| (self.min + self.max) * 0.5)
+    }
+
     /// Check if bounds are valid
     pub fn is_valid(&self) -> bool {
         self.min.x <= self.max.x && self.min.y <= self.max.y && self.min.z <= self.max.z
@@ -190,6 +197,19 @@ impl<T: CalcBounds3D + Transformed3D> Transformed3D for WithBounds3D<T> {
     }
 }
 
+impl Align<WithBounds3D<Geometry3D>> for Rc<WithBounds3D<Geometry3D>> {
+    /// Move the geometry into the center of its bounds.
+    ///
+    /// The translation is lazy, so the geometry is shared instead of copied, and the stored
+    /// bounds are moved along instead of being calculated again.
+    fn align(&self) -> WithBounds3D<Geometry3D> {
+        match self.bounds.center() {
+            Some(d) => self.lazy_transformed_3d(&Mat4::from_translation(-d)),
+            None => self.as_ref().clone(),
+        }
+    }
+}
+
 impl From<Geometry3D> for WithBounds3D<Geometry3D> {
     fn from(geo: Geometry3D) -> Self {
         let bounds = geo.calc_bounds_3d();
@@ -7,8 +7,6 @@ use std::f64::consts::PI;
 
 use cgmath::{Matrix, Point3, SquareMatrix, Transform, Vector3};
 
-use geo::TriangulateEarcut;
-
 use crate::*;
 
 /// Extrude.
@@ -16,9 +14,9 @@ pub trait Extrude {
     /// Extrude a single slice of the geometry with top and bottom plane.
     fn extrude_slice(&self, m_a: &Mat4, m_b: &Mat4) -> TriangleMesh;
 
-    /// Generate the cap geometry.
-    fn cap(&self, _m: &Mat4, _bottom: bool) -> TriangleMesh {
-        TriangleMesh::default()
+    /// Triangulate the area which closes the ends of an extrusion.
+    fn cap_triangulation(&self) -> Triangulation {
+        Triangulation::default()
     }
 
     /// Perform a linear extrusion with a certain height.
@@ -26,8 +24,9 @@ pub trait Extrude {
         let m_a = Mat4::identity();
         let m_b = Mat4::from_translation(Vec3::new(0.0, 0.0, height));
         let mut mesh = self.extrude_slice(&m_a, &m_b);
-        mesh.append(&self.cap(&m_a, true));
-        mesh.append(&self.cap(&m_b, false));
+        let cap = self.cap_triangulation();
+        mesh.append(&cap.cap(&m_a, true));
+        mesh.append(&cap.cap(&m_b, false));
         let bounds = mesh.calc_bounds_3d();
         mesh.repair(&bounds);
         WithBounds3D::new(mesh, bounds)
@@ -64,8 +63,9 @@ pub trait Extrude {
         if angle_rad.0 < PI * 2.0 {
             let m_start = &transforms[0];
             let m_end = transforms.last().expect("Transform");
-            mesh.append(&self.cap(m_start, true));
-            mesh.append(&self.cap(m_end, false));
+            let cap = self.cap_triangulation();
+            mesh.append(&cap.cap(m_start, true));
+            mesh.append(&cap.cap(m_end, false));
         }
 
         let bounds = mesh.calc_bounds_3d();
@@ -133,32 +133,8 @@ impl Extrude for Polygon {
         mesh
     }
 
-    fn cap(&self, m: &Mat4, flip: bool) -> TriangleMesh {
-        let raw_triangulation = self.earcut_triangles_raw();
-        let m: cgmath::Matrix4<f32> = m.cast().expect("Successful cast");
-
-        TriangleMesh {
-            positions: raw_triangulation
-                .vertices
-                .as_slice()
-                .chunks_exact(2)
-                .map(|chunk| {
-                    let p = Point3::new(chunk[0] as f32, chunk[1] as f32, 0.0_f32);
-                    let p = m.transform_point(p);
-                    Vector3::<f32>::new(p.x, p.y, p.z)
-                })
-                .collect(),
-            normals: None,
-            triangle_indices: raw_triangulation
-                .triangle_indices
-                .as_slice()
-                .chunks_exact(3)
-                .map(|chunk| match flip {
-                    true => Triangle(chunk[2] as u32, chunk[1] as u32, chunk[0] as u32),
-                    false => Triangle(chunk[0] as u32, chunk[1] as u32, chunk[2] as u32),
-                })
-                .collect(),
-        }
+    fn cap_triangulation(&self) -> Triangulation {
+        self.triangulate()
     }
 }
 
@@ -171,12 +147,8 @@ impl Extrude for MultiPolygon {
         mesh
     }
 
-    fn cap(&self, m: &Mat4, flip: bool) -> TriangleMesh {
-        let mut mesh = TriangleMesh::default();
-        self.iter().for_each(|polygon| {
-            mesh.append(&polygon.cap(m, flip));
-        });
-        mesh
+    fn cap_triangulation(&self) -> Triangulation {
+        self.triangulate()
     }
 }
 
@@ -185,7 +157,42 @@ impl Extrude for Geometries2D {
         self.to_multi_polygon().extrude_slice(m_a, m_b)
     }
 
+    fn cap_triangulation(&self) -> Triangulation {
+        self.to_multi_polygon().triangulate()
+    }
+
+    fn linear_extrude(&self, height: Scalar) -> WithBounds3D<TriangleMesh> {
+        self.to_multi_polygon().linear_extrude(height)
+    }
+
+    fn revolve_extrude(&self, angle_rad: Angle, segments: usize) -> WithBounds3D<TriangleMesh> {
+        self.to_multi_polygon().revolve_extrude(angle_rad, segments)
+    }
+}
+
+impl Triangulation {
+    /// Place the triangulation into the plane given by `m`, with reversed triangles if `flip`.
     fn cap(&self, m: &Mat4, flip: bool) -> TriangleMesh {
-        self.to_multi_polygon().cap(m, flip)
+        let m: cgmath::Matrix4<f32> = m.cast().expect("Successful cast");
+
+        TriangleMesh {
+            positions: self
+                .vertices
+                .iter()
+                .map(|v| {
+                    let p = m.transform_point(Point3::new(v.x as f32, v.y as f32, 0.0_f32));
+                    Vector3::<f32>::new(p.x, p.y, p.z)
+                })
+                .collect(),
+            normals: None,
+            triangle_indices: self
+                .triangles
+                .iter()
+                .map(|t| match flip {
+                    true => Triangle(t.2, t.1, t.0),
+                    false => *t,
+                })
+                .collect(),
+        }
     }
 }
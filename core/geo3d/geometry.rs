@@ -17,6 +17,8 @@ pub enum Geometry3D {
     Manifold(Rc<Manifold>),
     /// Collection.
     Collection(Geometries3D),
+    /// Geometry with a pending transformation.
+    Transformed(LazyTransform3D),
 }
 
 impl std::fmt::Debug for Geometry3D {
@@ -43,10 +45,9 @@ impl Geometry3D {
     /// Calculate contex hull.
     pub fn hull(&self) -> Self {
         match &self {
-            Geometry3D::Mesh(triangle_mesh) => triangle_mesh.to_manifold().hull().into(),
             Geometry3D::Manifold(manifold) => manifold.hull().into(),
-            Geometry3D::Collection(collection) => {
-                TriangleMesh::from(collection).to_manifold().hull().into()
+            Geometry3D::Mesh(_) | Geometry3D::Collection(_) | Geometry3D::Transformed(_) => {
+                hull_3d([self]).into()
             }
         }
     }
@@ -69,13 +70,19 @@ impl CalcBounds3D for Geometry3D {
                 TriangleMesh::from(manifold.to_mesh()).calc_bounds_3d()
             }
             Geometry3D::Collection(collection) => collection.calc_bounds_3d(),
+            Geometry3D::Transformed(transformed) => transformed.calc_bounds_3d(),
         }
     }
 }
 
 impl Transformed3D for Geometry3D {
     fn transformed_3d(&self, mat: &Mat4) -> Self {
-        TriangleMesh::from(self.clone()).transformed_3d(mat).into()
+        match self {
+            Geometry3D::Transformed(transformed) => {
+                Geometry3D::Transformed(transformed.transformed_3d(mat))
+            }
+            _ => TriangleMesh::from(self.clone()).transformed_3d(mat).into(),
+        }
     }
 }
 
@@ -105,6 +112,7 @@ impl From<Geometry3D> for Rc<Manifold> {
             Geometry3D::Collection(ref collection) => {
                 Rc::new(TriangleMesh::from(collection).to_manifold())
             }
+            Geometry3D::Transformed(transformed) => Rc::new(transformed.apply().to_manifold()),
         }
     }
 }
@@ -0,0 +1,488 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! 3D convex hull engine.
+//!
+//! Points are taken directly from the geometries without building an intermediate mesh,
+//! points inside the polytope of extreme points are dropped (Akl-Toussaint heuristic) and
+//! the remaining ones are passed to quickhull.
+
+use std::collections::HashMap;
+
+use cgmath::{InnerSpace, Vector3};
+
+use crate::{hull::parallel_hull, *};
+
+/// Directions of the extreme points used for prefiltering.
+const DIRECTIONS: [(f64, f64, f64); 14] = [
+    (1.0, 0.0, 0.0),
+    (-1.0, 0.0, 0.0),
+    (0.0, 1.0, 0.0),
+    (0.0, -1.0, 0.0),
+    (0.0, 0.0, 1.0),
+    (0.0, 0.0, -1.0),
+    (1.0, 1.0, 1.0),
+    (1.0, 1.0, -1.0),
+    (1.0, -1.0, 1.0),
+    (1.0, -1.0, -1.0),
+    (-1.0, 1.0, 1.0),
+    (-1.0, 1.0, -1.0),
+    (-1.0, -1.0, 1.0),
+    (-1.0, -1.0, -1.0),
+];
+
+/// Factor of the coarser tolerance which is used when the first attempt of quickhull fails.
+const COARSE_EPSILON_FACTOR: Scalar = 1024.0;
+
+/// Reason why quickhull found no hull.
+#[derive(Debug, PartialEq)]
+enum NoHull {
+    /// The points do not span any volume.
+    Flat,
+    /// Rounding errors left an edge without its twin.
+    Broken,
+}
+
+/// Triangle of the hull under construction.
+struct Face {
+    /// Point indices in counter clockwise order seen from outside.
+    v: [usize; 3],
+    /// Outward normal.
+    normal: Vec3,
+    /// Distance of the face plane from origin.
+    offset: Scalar,
+    /// Points which are outside of this face and not assigned to another face.
+    outside: Vec<usize>,
+    /// `false` if face has been replaced.
+    alive: bool,
+}
+
+impl Face {
+    fn new(points: &[Vec3], v: [usize; 3]) -> Self {
+        let normal = (points[v[1]] - points[v[0]]).cross(points[v[2]] - points[v[0]]);
+        let normal = if normal.magnitude2() > 0.0 {
+            normal.normalize()
+        } else {
+            Vec3::new(0.0, 0.0, 0.0)
+        };
+        Self {
+            v,
+            normal,
+            offset: normal.dot(points[v[0]]),
+            outside: Vec::new(),
+            alive: true,
+        }
+    }
+
+    /// Create face which is oriented away from point `inside`.
+    fn oriented(points: &[Vec3], v: [usize; 3], inside: usize) -> Self {
+        let face = Self::new(points, v);
+        if face.distance(points[inside]) > 0.0 {
+            Self::new(points, [v[0], v[2], v[1]])
+        } else {
+            face
+        }
+    }
+
+    /// Signed distance of point `p` from face plane.
+    fn distance(&self, p: Vec3) -> Scalar {
+        self.normal.dot(p) - self.offset
+    }
+
+    /// Directed edges of this face.
+    fn edges(&self) -> [(usize, usize); 3] {
+        let [a, b, c] = self.v;
+        [(a, b), (b, c), (c, a)]
+    }
+}
+
+/// Distance below which points are considered to lie on a plane.
+fn epsilon(points: &[Vec3]) -> Scalar {
+    let max = points.iter().fold(Vec3::new(0.0, 0.0, 0.0), |max, p| {
+        Vec3::new(
+            max.x.max(p.x.abs()),
+            max.y.max(p.y.abs()),
+            max.z.max(p.z.abs()),
+        )
+    });
+    (max.x + max.y + max.z) * f32::EPSILON as Scalar
+}
+
+/// Find four points which span a tetrahedron of non-zero volume.
+fn initial_simplex(points: &[Vec3], eps: Scalar) -> Option<[usize; 4]> {
+    let mut extremes = [0; 6];
+    points.iter().enumerate().for_each(|(i, p)| {
+        (0..3).for_each(|axis| {
+            if p[axis] < points[extremes[axis * 2]][axis] {
+                extremes[axis * 2] = i;
+            }
+            if p[axis] > points[extremes[axis * 2 + 1]][axis] {
+                extremes[axis * 2 + 1] = i;
+            }
+        })
+    });
+
+    let (mut i0, mut i1, mut max) = (0, 0, 0.0);
+    extremes.iter().for_each(|a| {
+        extremes.iter().for_each(|b| {
+            let d = (points[*b] - points[*a]).magnitude2();
+            if d > max {
+                (i0, i1, max) = (*a, *b, d);
+            }
+        })
+    });
+    if max.sqrt() <= eps {
+        return None;
+    }
+
+    let farthest = |distance: &dyn Fn(Vec3) -> Scalar| {
+        points
+            .iter()
+            .enumerate()
+            .map(|(i, p)| (i, distance(*p)))
+            .fold((0, 0.0), |max, d| if d.1 > max.1 { d } else { max })
+    };
+
+    let line = (points[i1] - points[i0]).normalize();
+    let (i2, d) = farthest(&|p| (p - points[i0]).cross(line).magnitude());
+    if d <= eps {
+        return None;
+    }
+
+    let normal = (points[i1] - points[i0])
+        .cross(points[i2] - points[i0])
+        .normalize();
+    let (i3, d) = farthest(&|p| normal.dot(p - points[i0]).abs());
+    if d <= eps {
+        return None;
+    }
+
+    Some([i0, i1, i2, i3])
+}
+
+/// Calculate the hull triangles of `points` with quickhull.
+///
+/// If rounding errors break the connectivity of the faces, the hull is calculated again with a
+/// coarser tolerance for points on a face.
+fn quick_hull(points: &[Vec3]) -> Result<Vec<[usize; 3]>, NoHull> {
+    let eps = epsilon(points);
+    match quick_hull_with(points, eps) {
+        Err(NoHull::Broken) => quick_hull_with(points, eps * COARSE_EPSILON_FACTOR),
+        result => result,
+    }
+}
+
+/// Calculate the hull triangles of `points` with quickhull and tolerance `eps`.
+fn quick_hull_with(points: &[Vec3], eps: Scalar) -> Result<Vec<[usize; 3]>, NoHull> {
+    let [i0, i1, i2, i3] = initial_simplex(points, eps).ok_or(NoHull::Flat)?;
+
+    let mut faces = vec![
+        Face::oriented(points, [i0, i1, i2], i3),
+        Face::oriented(points, [i0, i1, i3], i2),
+        Face::oriented(points, [i1, i2, i3], i0),
+        Face::oriented(points, [i2, i0, i3], i1),
+    ];
+    let mut edges = HashMap::new();
+    faces.iter().enumerate().for_each(|(i, face)| {
+        face.edges().into_iter().for_each(|edge| {
+            edges.insert(edge, i);
+        })
+    });
+
+    // assign each point to the first face it is outside of
+    let assign = |faces: &mut [Face], candidates: &[usize], point: usize| {
+        if let Some(face) = candidates
+            .iter()
+            .find(|face| faces[**face].distance(points[point]) > eps)
+        {
+            faces[*face].outside.push(point);
+        }
+    };
+    let simplex: Vec<_> = (0..faces.len()).collect();
+    (0..points.len())
+        .filter(|i| ![i0, i1, i2, i3].contains(i))
+        .for_each(|point| assign(&mut faces, &simplex, point));
+
+    let mut pending = simplex;
+    while let Some(current) = pending.pop() {
+        if !faces[current].alive || faces[current].outside.is_empty() {
+            continue;
+        }
+
+        // farthest point becomes the new hull vertex
+        let eye = *faces[current]
+            .outside
+            .iter()
+            .max_by(|a, b| {
+                let face = &faces[current];
+                face.distance(points[**a])
+                    .total_cmp(&face.distance(points[**b]))
+            })
+            .expect("outside set is not empty");
+
+        // collect all faces which can be seen from the eye and their border
+        let mut visible = vec![current];
+        let mut horizon = Vec::new();
+        faces[current].alive = false;
+        let mut index = 0;
+        while index < visible.len() {
+            let face = visible[index];
+            index += 1;
+            for (a, b) in faces[face].edges() {
+                let Some(&neighbor) = edges.get(&(b, a)) else {
+                    return Err(NoHull::Broken);
+                };
+                if !faces[neighbor].alive {
+                    continue;
+                }
+                if faces[neighbor].distance(points[eye]) > eps {
+                    faces[neighbor].alive = false;
+                    visible.push(neighbor);
+                } else {
+                    horizon.push((a, b));
+                }
+            }
+        }
+
+        let mut orphans = Vec::new();
+        visible.iter().for_each(|face| {
+            orphans.append(&mut faces[*face].outside);
+            faces[*face].edges().iter().for_each(|edge| {
+                edges.remove(edge);
+            });
+        });
+
+        // connect the horizon with the eye
+        let new_faces: Vec<_> = horizon
+            .into_iter()
+            .map(|(a, b)| {
+                let index = faces.len();
+                let face = Face::new(points, [a, b, eye]);
+                face.edges().into_iter().for_each(|edge| {
+                    edges.insert(edge, index);
+                });
+                faces.push(face);
+                index
+            })
+            .collect();
+
+        orphans
+            .into_iter()
+            .filter(|point| *point != eye)
+            .for_each(|point| assign(&mut faces, &new_faces, point));
+        pending.extend(new_faces);
+    }
+
+    Ok(faces
+        .into_iter()
+        .filter(|face| face.alive)
+        .map(|face| face.v)
+        .collect())
+}
+
+/// Return the vertices of the convex hull of `points`.
+///
+/// If no hull is found, all points are returned.
+fn hull_vertices(points: Vec<Vec3>) -> Vec<Vec3> {
+    match quick_hull(&points) {
+        Ok(triangles) => {
+            let mut used = vec![false; points.len()];
+            triangles.iter().flatten().for_each(|i| used[*i] = true);
+            points
+                .into_iter()
+                .zip(used)
+                .filter_map(|(p, used)| used.then_some(p))
+                .collect()
+        }
+        Err(_) => points,
+    }
+}
+
+/// Remove all points which are strictly inside the polytope of the extreme points.
+fn akl_toussaint(points: &mut Vec<Vec3>) {
+    let Some(first) = points.first() else {
+        return;
+    };
+    let mut extremes = [*first; 14];
+    let mut maxima = [Scalar::MIN; 14];
+    points.iter().for_each(|p| {
+        DIRECTIONS.iter().enumerate().for_each(|(i, (x, y, z))| {
+            let d = p.x * x + p.y * y + p.z * z;
+            if d > maxima[i] {
+                maxima[i] = d;
+                extremes[i] = *p;
+            }
+        })
+    });
+
+    let Ok(triangles) = quick_hull(&extremes) else {
+        return;
+    };
+    let eps = epsilon(points);
+    let planes: Vec<_> = triangles
+        .into_iter()
+        .map(|v| Face::new(&extremes, v))
+        .collect();
+    points.retain(|p| !planes.iter().all(|plane| plane.distance(*p) < -eps));
+}
+
+/// Add all points of a geometry which may be part of its convex hull.
+fn push_hull_points(geometry: &Geometry3D, points: &mut Vec<Vec3>) {
+    match geometry {
+        Geometry3D::Mesh(mesh) => points.extend(
+            mesh.positions
+                .iter()
+                .map(|p| Vec3::new(p.x as Scalar, p.y as Scalar, p.z as Scalar)),
+        ),
+        Geometry3D::Manifold(manifold) => points.extend(
+            manifold
+                .to_mesh()
+                .vertices()
+                .chunks_exact(3)
+                .map(|p| Vec3::new(p[0] as Scalar, p[1] as Scalar, p[2] as Scalar)),
+        ),
+        Geometry3D::Collection(collection) => collection
+            .iter()
+            .for_each(|geometry| push_hull_points(geometry, points)),
+        Geometry3D::Transformed(transformed) => {
+            let start = points.len();
+            push_hull_points(&transformed.geometry, points);
+            points[start..].iter_mut().for_each(|p| {
+                *p = (transformed.matrix * p.extend(1.0)).truncate();
+            });
+        }
+    }
+}
+
+/// Calculate the convex hull of some geometries.
+///
+/// Returns an empty mesh if the geometries do not span any volume.
+/// If quickhull fails because of rounding errors, the hull is calculated by manifold.
+pub fn hull_3d<'a>(geometries: impl IntoIterator<Item = &'a Geometry3D>) -> TriangleMesh {
+    let geometries: Vec<_> = geometries.into_iter().collect();
+    let mut points = Vec::new();
+    geometries
+        .iter()
+        .for_each(|geometry| push_hull_points(geometry, &mut points));
+    match try_hull_points_3d(points) {
+        Ok(mesh) => mesh,
+        Err(NoHull::Flat) => TriangleMesh::default(),
+        Err(NoHull::Broken) => {
+            log::warn!("Convex hull falls back to manifold because of rounding errors");
+            let mut mesh = TriangleMesh::default();
+            geometries
+                .into_iter()
+                .for_each(|geometry| mesh.append(&TriangleMesh::from(geometry.clone())));
+            TriangleMesh::from(mesh.to_manifold().hull())
+        }
+    }
+}
+
+/// Calculate the convex hull of some points.
+///
+/// Returns an empty mesh if the points do not span any volume or if quickhull fails because of
+/// rounding errors.
+pub fn hull_points_3d(points: Vec<Vec3>) -> TriangleMesh {
+    match try_hull_points_3d(points) {
+        Ok(mesh) => mesh,
+        Err(NoHull::Flat) => TriangleMesh::default(),
+        Err(NoHull::Broken) => {
+            log::warn!("Convex hull of points failed because of rounding errors");
+            TriangleMesh::default()
+        }
+    }
+}
+
+fn try_hull_points_3d(mut points: Vec<Vec3>) -> Result<TriangleMesh, NoHull> {
+    akl_toussaint(&mut points);
+    let points = parallel_hull(points, hull_vertices);
+    let triangles = quick_hull(&points)?;
+
+    // only keep points which are hull vertices
+    let mut indices = vec![None; points.len()];
+    let mut positions = Vec::new();
+    let mut index = |i: usize| {
+        *indices[i].get_or_insert_with(|| {
+            let p = points[i];
+            positions.push(Vector3::new(p.x as f32, p.y as f32, p.z as f32));
+            positions.len() as u32 - 1
+        })
+    };
+    let triangle_indices = triangles
+        .into_iter()
+        .map(|[a, b, c]| Triangle(index(a), index(b), index(c)))
+        .collect();
+
+    Ok(TriangleMesh {
+        positions,
+        normals: None,
+        triangle_indices,
+    })
+}
+
+#[cfg(test)]
+fn cube_with_inner_points(n: usize) -> Geometry3D {
+    let mut positions: Vec<_> = (0..8)
+        .map(|i| Vector3::new((i & 1) as f32, ((i >> 1) & 1) as f32, ((i >> 2) & 1) as f32))
+        .collect();
+    // pseudo random points inside the cube
+    let mut seed = 12345_u32;
+    let mut random = move || {
+        seed = seed.wrapping_mul(1103515245).wrapping_add(12345);
+        0.01 + 0.98 * ((seed >> 8) as f32 / (1 << 24) as f32)
+    };
+    (0..n).for_each(|_| positions.push(Vector3::new(random(), random(), random())));
+
+    Geometry3D::Mesh(TriangleMesh {
+        positions,
+        normals: None,
+        triangle_indices: Vec::new(),
+    })
+}
+
+#[test]
+fn hull_3d_cube() {
+    let hull = hull_3d([&cube_with_inner_points(1000)]);
+    assert_eq!(hull.positions.len(), 8);
+    assert_eq!(hull.triangle_indices.len(), 12);
+    assert!((hull.volume() - 1.0).abs() < 1e-6);
+}
+
+#[test]
+fn hull_3d_parallel() {
+    // many points on a sphere (fibonacci lattice)
+    let n = 200_000;
+    let golden_angle = std::f64::consts::PI * (3.0 - 5.0_f64.sqrt());
+    let sphere = Geometry3D::Mesh(TriangleMesh {
+        positions: (0..n)
+            .map(|i| {
+                let z = 1.0 - 2.0 * (i as f64 + 0.5) / n as f64;
+                let r = (1.0 - z * z).sqrt();
+                let a = golden_angle * i as f64;
+                Vector3::new((r * a.cos()) as f32, (r * a.sin()) as f32, z as f32)
+            })
+            .collect(),
+        normals: None,
+        triangle_indices: Vec::new(),
+    });
+    let collection = Geometry3D::Collection(Geometries3D::new(vec![
+        sphere,
+        cube_with_inner_points(1000),
+    ]));
+
+    let hull = hull_3d([&collection]);
+    assert!((hull.volume() - 4.0 / 3.0 * std::f64::consts::PI).abs() < 1e-3);
+}
+
+#[test]
+fn hull_3d_coplanar_grid() {
+    // many points on the faces of a cube are the classic trap for rounding errors
+    let grid: Vec<_> = (0..1000)
+        .map(|i| Vec3::new((i % 10) as f64, ((i / 10) % 10) as f64, (i / 100) as f64) / 9.0)
+        .collect();
+    // without tolerance quickhull may fail but must not panic
+    let _ = quick_hull_with(&grid, 0.0);
+
+    let hull = hull_points_3d(grid);
+    assert!((hull.volume() - 1.0).abs() < 1e-6);
+}
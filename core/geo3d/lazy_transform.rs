@@ -0,0 +1,110 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! 3D geometry with a pending transformation.
+
+use std::rc::Rc;
+
+use crate::*;
+
+/// 3D geometry with a transformation which has not been applied yet.
+///
+/// Transforming it again just multiplies the matrices.
+/// The transformation is applied when the geometry is needed in world coordinates,
+/// e.g. by a boolean operation or an exporter.
+#[derive(Debug, Clone)]
+pub struct LazyTransform3D {
+    /// Untransformed geometry.
+    pub geometry: Rc<WithBounds3D<Geometry3D>>,
+    /// Pending transformation.
+    pub matrix: Mat4,
+}
+
+impl LazyTransform3D {
+    /// Create a lazy transformation of `geometry`.
+    ///
+    /// If `geometry` is lazily transformed itself, both matrices are combined.
+    pub fn new(geometry: Rc<WithBounds3D<Geometry3D>>, matrix: Mat4) -> Self {
+        match &geometry.inner {
+            Geometry3D::Transformed(transformed) => Self {
+                geometry: transformed.geometry.clone(),
+                matrix: matrix * transformed.matrix,
+            },
+            _ => Self { geometry, matrix },
+        }
+    }
+
+    /// Apply the transformation.
+    pub fn apply(&self) -> TriangleMesh {
+        TriangleMesh::from(self.geometry.inner.clone()).transformed_3d(&self.matrix)
+    }
+}
+
+/// Does `mat` map axis-aligned boxes onto axis-aligned boxes, i.e. does it only scale, mirror,
+/// swap axes and translate?
+fn is_axis_aligned(mat: &Mat4) -> bool {
+    (0..3).all(|row| (0..3).filter(|column| mat[*column][row] != 0.0).count() <= 1)
+}
+
+/// Bounds of the positions of `geometry` transformed by `mat`.
+fn transformed_bounds(geometry: &Geometry3D, mat: &Mat4, bounds: &mut Bounds3D) {
+    let mut extend = |positions: &[cgmath::Vector3<f32>]| {
+        positions.iter().for_each(|p| {
+            let p = Vec4::new(p.x as Scalar, p.y as Scalar, p.z as Scalar, 1.0);
+            bounds.extend_by_point((mat * p).truncate())
+        })
+    };
+    match geometry {
+        Geometry3D::Mesh(mesh) => extend(&mesh.positions),
+        Geometry3D::Manifold(manifold) => extend(&TriangleMesh::from(manifold.to_mesh()).positions),
+        Geometry3D::Collection(collection) => collection
+            .iter()
+            .for_each(|geometry| transformed_bounds(geometry, mat, bounds)),
+        Geometry3D::Transformed(transformed) => transformed_bounds(
+            &transformed.geometry.inner,
+            &(mat * transformed.matrix),
+            bounds,
+        ),
+    }
+}
+
+impl CalcBounds3D for LazyTransform3D {
+    /// Transform the cached bounds if the matrix keeps boxes axis-aligned, otherwise the bounds
+    /// of the rotated box would be too large and the positions are transformed instead.
+    fn calc_bounds_3d(&self) -> Bounds3D {
+        match is_axis_aligned(&self.matrix) {
+            true => self.geometry.bounds.transformed_3d(&self.matrix),
+            false => {
+                let mut bounds = Bounds3D::default();
+                transformed_bounds(&self.geometry.inner, &self.matrix, &mut bounds);
+                bounds
+            }
+        }
+    }
+}
+
+impl Transformed3D for LazyTransform3D {
+    fn transformed_3d(&self, mat: &Mat4) -> Self {
+        Self {
+            geometry: self.geometry.clone(),
+            matrix: *mat * self.matrix,
+        }
+    }
+}
+
+impl WithBounds3D<Geometry3D> {
+    /// Transform a shared geometry without copying it.
+    ///
+    /// The bounds of `self` are exact, so they are transformed directly unless `mat` rotates.
+    /// Only then the positions are walked.
+    pub fn lazy_transformed_3d(self: &Rc<Self>, mat: &Mat4) -> Self {
+        let transformed = LazyTransform3D::new(self.clone(), *mat);
+        Self {
+            bounds: match is_axis_aligned(mat) {
+                true => self.bounds.transformed_3d(mat),
+                false => transformed.calc_bounds_3d(),
+            },
+            inner: Geometry3D::Transformed(transformed),
+        }
+    }
+}
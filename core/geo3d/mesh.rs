@@ -290,6 +290,7 @@ impl From<Geometry3D> for TriangleMesh {
             Geometry3D::Mesh(triangle_mesh) => triangle_mesh,
             Geometry3D::Manifold(manifold) => manifold.to_mesh().into(),
             Geometry3D::Collection(ref collection) => collection.into(),
+            Geometry3D::Transformed(transformed) => transformed.apply(),
         }
     }
 }
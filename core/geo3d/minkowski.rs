@@ -0,0 +1,230 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! 3D Minkowski sum.
+
+use std::rc::Rc;
+
+use cgmath::Vector3;
+
+use crate::*;
+
+/// Relative volume difference below which a geometry is treated as convex.
+const CONVEX_TOLERANCE: Scalar = 1e-6;
+
+/// Maximum number of times a non-convex solid is split into convex parts.
+const MAX_SPLIT_DEPTH: usize = 6;
+
+/// Sum of each point of `a` with each point of `b`.
+fn point_sums(a: &[Vector3<f32>], b: &[Vector3<f32>]) -> Vec<Vec3> {
+    a.iter()
+        .flat_map(|a| {
+            b.iter().map(move |b| {
+                Vec3::new(
+                    (a.x + b.x) as Scalar,
+                    (a.y + b.y) as Scalar,
+                    (a.z + b.z) as Scalar,
+                )
+            })
+        })
+        .collect()
+}
+
+/// Unite manifolds pairwise so that each boolean operation gets operands of similar size.
+fn union_all(mut manifolds: Vec<Manifold>) -> Manifold {
+    while manifolds.len() > 1 {
+        let mut rest = manifolds.into_iter();
+        let mut united = Vec::new();
+        while let Some(a) = rest.next() {
+            united.push(match rest.next() {
+                Some(b) => a.boolean_op(&b, manifold_rs::BooleanOp::Union),
+                None => a,
+            });
+        }
+        manifolds = united;
+    }
+    manifolds.pop().expect("at least one manifold")
+}
+
+/// Box of `bounds` below (`lower`) or above the plane at `value` on `axis`.
+fn half_box(bounds: &Bounds3D, axis: usize, value: Scalar, lower: bool) -> Manifold {
+    let margin = Vec3::new(1.0, 1.0, 1.0);
+    let (mut min, mut max) = (bounds.min - margin, bounds.max + margin);
+    match lower {
+        true => max[axis] = value,
+        false => min[axis] = value,
+    }
+    hull_points_3d(Bounds3D::new(min, max).corners().collect()).to_manifold()
+}
+
+/// Minkowski sums of a solid with a convex tool, one per convex part of the solid.
+struct MinkowskiPieces<'a> {
+    /// Points of the convex tool.
+    tool: &'a [Vector3<f32>],
+    /// Sums of the convex parts with the tool.
+    pieces: Vec<Manifold>,
+}
+
+impl MinkowskiPieces<'_> {
+    /// Add the sums of the members of collections or the sums of the convex parts of a solid.
+    fn add(&mut self, geometry: &Geometry3D) {
+        match geometry {
+            Geometry3D::Collection(collection) => {
+                collection.iter().for_each(|geometry| self.add(geometry))
+            }
+            Geometry3D::Transformed(transformed) => match &transformed.geometry.inner {
+                Geometry3D::Collection(collection) => collection
+                    .iter()
+                    .for_each(|geometry| self.add(&geometry.transformed_3d(&transformed.matrix))),
+                _ => self.add_solid(TriangleMesh::from(geometry.clone()), MAX_SPLIT_DEPTH),
+            },
+            _ => self.add_solid(TriangleMesh::from(geometry.clone()), MAX_SPLIT_DEPTH),
+        }
+    }
+
+    /// Add the sum of a convex solid or split it into two halves.
+    ///
+    /// The split plane is a vertex coordinate close to the middle of the longest side, so that
+    /// cuts run along concave edges.
+    /// Below the maximum split depth the solid is summed by its boundary triangles instead.
+    fn add_solid(&mut self, mesh: TriangleMesh, depth: usize) {
+        if mesh.triangle_indices.is_empty() {
+            return;
+        }
+        let hull = hull_points_3d(
+            mesh.positions
+                .iter()
+                .map(|p| Vec3::new(p.x as Scalar, p.y as Scalar, p.z as Scalar))
+                .collect(),
+        );
+        let hull_volume = hull.volume();
+        if hull_volume - mesh.volume() <= CONVEX_TOLERANCE * hull_volume {
+            self.pieces
+                .push(hull_points_3d(point_sums(&hull.positions, self.tool)).to_manifold());
+            return;
+        }
+        if depth == 0 {
+            self.add_boundary(mesh);
+            return;
+        }
+
+        let bounds = mesh.calc_bounds_3d();
+        let size = bounds.max - bounds.min;
+        let axis = match (size.x >= size.y, size.x >= size.z, size.y >= size.z) {
+            (true, true, _) => 0,
+            (false, _, true) => 1,
+            _ => 2,
+        };
+        let (min, max) = (bounds.min[axis], bounds.max[axis]);
+        let middle = (min + max) / 2.0;
+        let epsilon = (max - min) * 1e-3;
+        let value = mesh
+            .positions
+            .iter()
+            .map(|p| p[axis] as Scalar)
+            .filter(|v| *v > min + epsilon && *v < max - epsilon)
+            .min_by(|a, b| (a - middle).abs().total_cmp(&(b - middle).abs()))
+            .unwrap_or(middle);
+
+        let solid = mesh.to_manifold();
+        for lower in [true, false] {
+            let half = solid.boolean_op(
+                &half_box(&bounds, axis, value, lower),
+                manifold_rs::BooleanOp::Intersection,
+            );
+            self.add_solid(TriangleMesh::from(half.to_mesh()), depth - 1);
+        }
+    }
+
+    /// Add the sums of each boundary triangle and the solid translated into the tool.
+    fn add_boundary(&mut self, mesh: TriangleMesh) {
+        let origin = self.tool[0];
+        let origin = Vec3::new(origin.x as Scalar, origin.y as Scalar, origin.z as Scalar);
+        for t in mesh.triangles() {
+            self.pieces
+                .push(hull_points_3d(point_sums(&[*t.0, *t.1, *t.2], self.tool)).to_manifold());
+        }
+        self.pieces.push(
+            mesh.transformed_3d(&Mat4::from_translation(origin))
+                .to_manifold(),
+        );
+    }
+}
+
+impl Geometry3D {
+    /// Calculate the Minkowski sum of this geometry and the convex hull of `tool`.
+    ///
+    /// The sum distributes over unions, so the geometry is decomposed into convex parts: the
+    /// members of collections, which are split further by planes until they are convex.
+    /// Each convex part results in a single hull of the summed vertices and all hulls are
+    /// united at the end.
+    /// Parts which are still not convex after a few splits are summed by their triangles.
+    pub fn minkowski(&self, tool: &Geometry3D) -> Geometry3D {
+        let tool = hull_3d([tool]);
+        if tool.positions.is_empty() {
+            return self.clone();
+        }
+
+        let mut pieces = MinkowskiPieces {
+            tool: &tool.positions,
+            pieces: Vec::new(),
+        };
+        pieces.add(self);
+        match pieces.pieces.len() {
+            0 => self.clone(),
+            1 => pieces.pieces.pop().expect("one piece").into(),
+            _ => Rc::new(union_all(pieces.pieces)).into(),
+        }
+    }
+}
+
+#[cfg(test)]
+fn cube(min: (f32, f32, f32), size: f32) -> Geometry3D {
+    let corners = (0..8).map(|i| {
+        Geometry3D::Mesh(TriangleMesh {
+            positions: vec![Vector3::new(
+                min.0 + (i & 1) as f32 * size,
+                min.1 + ((i >> 1) & 1) as f32 * size,
+                min.2 + ((i >> 2) & 1) as f32 * size,
+            )],
+            normals: None,
+            triangle_indices: Vec::new(),
+        })
+    });
+    hull_3d(&corners.collect::<Vec<_>>()).into()
+}
+
+#[test]
+fn minkowski_convex() {
+    let sum = cube((0.0, 0.0, 0.0), 2.0).minkowski(&cube((0.0, 0.0, 0.0), 1.0));
+    assert!((TriangleMesh::from(sum).volume() - 27.0).abs() < 1e-4);
+}
+
+#[test]
+fn minkowski_concave() {
+    let base = Geometry3D::Collection(Geometries3D::new(vec![
+        cube((0.0, 0.0, 0.0), 1.0),
+        cube((3.0, 0.0, 0.0), 1.0),
+    ]));
+    let sum = base.minkowski(&cube((0.0, 0.0, 0.0), 1.0));
+    assert!((TriangleMesh::from(sum).volume() - 16.0).abs() < 1e-4);
+}
+
+#[test]
+fn minkowski_overlapping() {
+    // L-shape of two overlapping cubes
+    let a = cube((0.0, 0.0, 0.0), 2.0);
+    let b = cube((1.0, 1.0, 0.0), 2.0);
+    let tool = cube((0.0, 0.0, 0.0), 1.0);
+
+    let collection = Geometry3D::Collection(Geometries3D::new(vec![a.clone(), b.clone()]));
+    let sum = collection.minkowski(&tool);
+    assert!((TriangleMesh::from(sum).volume() - 42.0).abs() < 1e-4);
+
+    // the same shape as one non-convex solid
+    let solid = a
+        .boolean_op(&b, &BooleanOp::Union)
+        .expect("union of two cubes");
+    let sum = solid.minkowski(&tool);
+    assert!((TriangleMesh::from(sum).volume() - 42.0).abs() < 1e-4);
+}
@@ -7,7 +7,10 @@ mod bounds;
 mod collection;
 mod extrude;
 mod geometry;
+mod hull;
+mod lazy_transform;
 mod mesh;
+mod minkowski;
 mod triangle;
 mod vertex;
 
@@ -15,6 +18,8 @@ pub use bounds::*;
 pub use collection::*;
 pub use extrude::*;
 pub use geometry::*;
+pub use hull::*;
+pub use lazy_transform::*;
 pub use manifold_rs::Manifold;
 pub use mesh::TriangleMesh;
 pub use vertex::Vertex;
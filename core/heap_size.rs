@@ -0,0 +1,159 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Memory size estimation.
+
+use std::{mem::size_of, rc::Rc};
+
+use crate::*;
+
+/// Trait to estimate the memory a value owns on the heap.
+///
+/// The estimate counts the allocated capacity of the owned buffers, not the size of the value itself.
+/// Data behind an [`Rc`] is counted for each reference, so shared data is counted more than once.
+pub trait HeapSize {
+    /// Estimated number of bytes owned on the heap.
+    fn heap_size(&self) -> usize;
+}
+
+/// Size of an [`Rc`] allocation including its reference counters and the heap data of its content.
+pub fn rc_heap_size<T: HeapSize>(rc: &Rc<T>) -> usize {
+    2 * size_of::<usize>() + size_of::<T>() + rc.as_ref().heap_size()
+}
+
+impl<T: HeapSize> HeapSize for Vec<T> {
+    fn heap_size(&self) -> usize {
+        self.capacity() * size_of::<T>() + self.iter().map(HeapSize::heap_size).sum::<usize>()
+    }
+}
+
+impl HeapSize for LineString {
+    fn heap_size(&self) -> usize {
+        self.0.capacity() * size_of::<geo::Coord<Scalar>>()
+    }
+}
+
+impl HeapSize for MultiLineString {
+    fn heap_size(&self) -> usize {
+        self.0.heap_size()
+    }
+}
+
+impl HeapSize for Polygon {
+    fn heap_size(&self) -> usize {
+        self.exterior().heap_size()
+            + self.interiors().len() * size_of::<LineString>()
+            + self
+                .interiors()
+                .iter()
+                .map(HeapSize::heap_size)
+                .sum::<usize>()
+    }
+}
+
+impl HeapSize for MultiPolygon {
+    fn heap_size(&self) -> usize {
+        self.0.heap_size()
+    }
+}
+
+impl HeapSize for Geometry2D {
+    fn heap_size(&self) -> usize {
+        match self {
+            Geometry2D::LineString(line_string) => line_string.heap_size(),
+            Geometry2D::MultiLineString(multi_line_string) => multi_line_string.heap_size(),
+            Geometry2D::Polygon(polygon) => polygon.heap_size(),
+            Geometry2D::MultiPolygon(multi_polygon) => multi_polygon.heap_size(),
+            Geometry2D::Rect(_) | Geometry2D::Line(_) => 0,
+            Geometry2D::Collection(collection) => collection.heap_size(),
+            Geometry2D::Transformed(transformed) => rc_heap_size(&transformed.geometry),
+        }
+    }
+}
+
+impl HeapSize for Geometries2D {
+    fn heap_size(&self) -> usize {
+        self.capacity() * size_of::<Rc<Geometry2D>>() + self.iter().map(rc_heap_size).sum::<usize>()
+    }
+}
+
+impl<T: CalcBounds2D + Transformed2D + HeapSize> HeapSize for WithBounds2D<T> {
+    fn heap_size(&self) -> usize {
+        self.inner.heap_size()
+    }
+}
+
+#[cfg(feature = "geo3d")]
+impl HeapSize for TriangleMesh {
+    fn heap_size(&self) -> usize {
+        self.positions.capacity() * size_of::<cgmath::Vector3<f32>>()
+            + self
+                .normals
+                .as_ref()
+                .map(|normals| normals.capacity() * size_of::<cgmath::Vector3<f32>>())
+                .unwrap_or_default()
+            + self.triangle_indices.capacity() * size_of::<Triangle<u32>>()
+    }
+}
+
+/// Estimated bytes per vertex of a [`Manifold`]: position and normal.
+#[cfg(feature = "geo3d")]
+const MANIFOLD_VERTEX_SIZE: usize = 2 * size_of::<[f64; 3]>();
+
+/// Estimated bytes per triangle of a [`Manifold`]: three half-edges, face normal and the
+/// reference to the original triangle.
+#[cfg(feature = "geo3d")]
+const MANIFOLD_TRIANGLE_SIZE: usize =
+    3 * 4 * size_of::<i32>() + size_of::<[f64; 3]>() + 4 * size_of::<i32>();
+
+/// Manifold keeps its data in foreign memory, estimate it by its number of vertices and triangles.
+///
+/// The bindings do not expose these counts, so the mesh is exported with [`Manifold::to_mesh`].
+/// This copies all vertices and indices temporarily and is meant for memory reports only.
+#[cfg(feature = "geo3d")]
+fn manifold_heap_size(manifold: &Manifold) -> usize {
+    let mesh = manifold.to_mesh();
+    let vertices = mesh.vertices().len() / 3;
+    let triangles = mesh.indices().len() / 3;
+    vertices * MANIFOLD_VERTEX_SIZE + triangles * MANIFOLD_TRIANGLE_SIZE
+}
+
+#[cfg(feature = "geo3d")]
+impl HeapSize for Geometry3D {
+    fn heap_size(&self) -> usize {
+        match self {
+            Geometry3D::Mesh(triangle_mesh) => triangle_mesh.heap_size(),
+            Geometry3D::Manifold(manifold) => manifold_heap_size(manifold),
+            Geometry3D::Collection(collection) => collection.heap_size(),
+            Geometry3D::Transformed(transformed) => rc_heap_size(&transformed.geometry),
+        }
+    }
+}
+
+#[cfg(feature = "geo3d")]
+impl HeapSize for Geometries3D {
+    fn heap_size(&self) -> usize {
+        self.capacity() * size_of::<Rc<Geometry3D>>() + self.iter().map(rc_heap_size).sum::<usize>()
+    }
+}
+
+#[cfg(feature = "geo3d")]
+impl<T: CalcBounds3D + Transformed3D + HeapSize> HeapSize for WithBounds3D<T> {
+    fn heap_size(&self) -> usize {
+        self.inner.heap_size()
+    }
+}
+
+#[test]
+fn heap_size_2d() {
+    let square = Geometry2D::Polygon(Polygon::new(
+        LineString::from(vec![(0.0, 0.0), (1.0, 0.0), (1.0, 1.0), (0.0, 1.0)]),
+        vec![],
+    ));
+    let coord_size = size_of::<geo::Coord<Scalar>>();
+    // `Polygon::new` closes the ring
+    assert!(square.heap_size() >= 5 * coord_size);
+
+    let collection = Geometry2D::Collection(Geometries2D::new(vec![square.clone(), square]));
+    assert!(collection.heap_size() >= 2 * (5 * coord_size + size_of::<Geometry2D>()));
+}
@@ -0,0 +1,33 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Shared parts of the 2D and 3D convex hull engines.
+
+/// Minimum number of points before the hull is calculated on multiple threads.
+const PARALLEL_THRESHOLD: usize = 50_000;
+
+/// Calculate the hull vertices of `points` on all available threads.
+///
+/// The points are split into chunks, `hull` is applied to each chunk in parallel and once
+/// more to all resulting chunk hull vertices.
+/// `hull` must return the vertices of the convex hull of the given points.
+pub(crate) fn parallel_hull<P: Copy + Send>(points: Vec<P>, hull: fn(Vec<P>) -> Vec<P>) -> Vec<P> {
+    let threads = std::thread::available_parallelism()
+        .map(|n| n.get())
+        .unwrap_or(1);
+    if threads < 2 || points.len() < PARALLEL_THRESHOLD {
+        return hull(points);
+    }
+
+    let chunk_size = points.len().div_ceil(threads);
+    let vertices = std::thread::scope(|scope| {
+        points
+            .chunks(chunk_size)
+            .map(|chunk| scope.spawn(move || hull(chunk.to_vec())))
+            .collect::<Vec<_>>()
+            .into_iter()
+            .flat_map(|handle| handle.join().expect("hull thread panicked"))
+            .collect::<Vec<_>>()
+    });
+    hull(vertices)
+}
@@ -4,6 +4,7 @@
 //! µcad core
 
 mod boolean_op;
+mod hull;
 
 pub mod bounds;
 pub mod color;
@@ -11,6 +12,8 @@ pub mod core_error;
 pub mod geo2d;
 #[cfg(feature = "geo3d")]
 pub mod geo3d;
+pub mod heap_size;
+pub mod primitive_library;
 pub mod render;
 pub mod theme;
 pub mod traits;
@@ -41,5 +44,7 @@ pub use color::*;
 pub use core_error::*;
 pub use geo2d::*;
 pub use geo3d::*;
+pub use heap_size::*;
+pub use primitive_library::*;
 pub use render::*;
 pub use triangle::*;
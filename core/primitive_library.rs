@@ -0,0 +1,73 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Library of unit-sized primitives.
+//!
+//! Circles are tessellated once per segment count with radius 1.
+//! Each instance is a lazy scale and translation of the shared unit circle, so thousands of
+//! differently sized holes share a handful of base polygons.
+//! The number of segments of a circle is a power of two (see
+//! [`RenderResolution::circular_segments`]), so only a few base shapes exist.
+//!
+//! Spheres, cylinders and cubes are not shared: a transformed mesh must be converted into a
+//! manifold for every boolean operation, which costs more than the native constructors.
+
+use std::{cell::RefCell, collections::HashMap, rc::Rc};
+
+use crate::*;
+
+thread_local! {
+    static LIBRARY: RefCell<PrimitiveLibrary> = RefCell::new(PrimitiveLibrary::default());
+}
+
+/// Unit-sized primitives by segment count.
+#[derive(Default)]
+pub struct PrimitiveLibrary {
+    /// Circles with radius 1 around the origin.
+    circles: HashMap<u32, Rc<WithBounds2D<Geometry2D>>>,
+}
+
+impl PrimitiveLibrary {
+    /// Run `f` with the primitive library of the current thread.
+    pub fn with<T>(f: impl FnOnce(&mut PrimitiveLibrary) -> T) -> T {
+        LIBRARY.with(|library| f(&mut library.borrow_mut()))
+    }
+
+    /// Circle with `segments` segments.
+    pub fn circle(&mut self, circle: &Circle, segments: u32) -> Geometry2D {
+        if circle.radius <= 0.0 {
+            return Geometry2D::Polygon(circle.polygon(segments));
+        }
+        let unit = self.circles.entry(segments).or_insert_with(|| {
+            let unit = Circle {
+                radius: 1.0,
+                offset: Vec2::new(0.0, 0.0),
+            };
+            Rc::new(Geometry2D::Polygon(unit.polygon(segments)).into())
+        });
+        let matrix = Mat3::from_translation(circle.offset)
+            * Mat3::from_nonuniform_scale(circle.radius, circle.radius);
+        Geometry2D::Transformed(LazyTransform2D::new(unit.clone(), matrix))
+    }
+}
+
+#[test]
+fn shared_primitives() {
+    let circle = |radius, x| Circle {
+        radius,
+        offset: Vec2::new(x, 0.0),
+    };
+    let (small, large) = PrimitiveLibrary::with(|library| {
+        (
+            library.circle(&circle(1.5, 0.0), 16),
+            library.circle(&circle(2.0, 10.0), 16),
+        )
+    });
+    match (&small, &large) {
+        (Geometry2D::Transformed(small), Geometry2D::Transformed(large)) => {
+            assert!(Rc::ptr_eq(&small.geometry, &large.geometry));
+        }
+        _ => panic!("lazy transformations expected"),
+    }
+    assert_eq!(large.calc_bounds_2d().max, Vec2::new(12.0, 2.0));
+}
@@ -4,7 +4,9 @@
 //! Export models to files  
 
 pub mod json;
+pub mod parts;
 pub mod ply;
 pub mod stl;
 pub mod svg;
+pub mod wkb;
 pub mod wkt;
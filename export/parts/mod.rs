@@ -0,0 +1,215 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Hierarchical export into content-addressed part files.
+//!
+//! Each built-in primitive or operation of a 3D model is a part which is written once into a
+//! `parts` directory next to the manifest, named by the render hash of the part (e.g.
+//! `parts/5e2a01c4d9b07f13.stl`).
+//! The hash covers the part's element, its children and their resolutions, so a part file
+//! which already exists is neither rendered nor written again.
+//! Transformations are not parts but nodes of the manifest, so copies of a part at different
+//! places share one part file.
+//! The manifest (e.g. `assembly.parts`) is a JSON file which describes the model tree:
+//!
+//! ```json
+//! {
+//!   "format": "stl",
+//!   "root": {
+//!     "id": "assembly",
+//!     "element": "...",
+//!     "hash": "e0c1f23a5b4d6978",
+//!     "matrix": [1.0, 0.0, ...],
+//!     "children": [
+//!       { "element": "...", "hash": "5e2a01c4d9b07f13", "matrix": [...], "part": "parts/5e2a01c4d9b07f13.stl" }
+//!     ]
+//!   }
+//! }
+//! ```
+//!
+//! `id` is only set for models created by an assignment.
+//! `matrix` is the column-major world matrix of a node, which places the geometry of a part.
+
+use std::{collections::HashSet, io::Write, path::PathBuf};
+
+use microcad_core::Mat4;
+use microcad_lang::{
+    Id,
+    builtin::{BuiltinWorkbenchKind, ExportError, Exporter, FileIoInterface},
+    model::{Element, Model, OutputType},
+    render::{ComputedHash, HashId, RenderContext, RenderError, RenderOutput, RenderWithContext},
+    value::Value,
+};
+use serde_json::json;
+
+use crate::stl::{StlWriter, WriteStl};
+
+/// Name of the part directory next to the manifest.
+const PARTS_DIR: &str = "parts";
+
+/// Exporter of a manifest and content-addressed STL part files.
+pub struct PartsExporter;
+
+/// Part files of one export.
+struct PartStore {
+    /// Directory of the part files.
+    dir: PathBuf,
+    /// Parts which have been written or found during this export.
+    parts: HashSet<HashId>,
+    /// Number of part files written.
+    written: usize,
+}
+
+impl PartStore {
+    fn new(manifest: &std::path::Path) -> std::io::Result<Self> {
+        let dir = manifest.with_file_name(PARTS_DIR);
+        std::fs::create_dir_all(&dir)?;
+        Ok(Self {
+            dir,
+            parts: HashSet::new(),
+            written: 0,
+        })
+    }
+
+    fn filename(hash: HashId) -> String {
+        format!("{hash:016x}.stl")
+    }
+
+    /// Describe `model` and its children and write all missing parts.
+    ///
+    /// Parts are rendered with `context` unless `model` has been rendered already.
+    fn node(
+        &mut self,
+        model: &Model,
+        mut context: Option<&mut RenderContext>,
+    ) -> Result<serde_json::Value, ExportError> {
+        let hash = model.computed_hash();
+        let (mut node, is_part) = {
+            let model_ = model.borrow();
+            let mut node = json!({
+                "element": model_.element().to_string(),
+                "hash": format!("{hash:016x}"),
+                "matrix": matrix_to_array(&model_.output().world_matrix()),
+            });
+            if let Some(id) = &model_.id {
+                node["id"] = id.to_string().into();
+            }
+            let is_part = match model_.element() {
+                Element::BuiltinWorkpiece(workpiece) => {
+                    !matches!(workpiece.kind, BuiltinWorkbenchKind::Transform)
+                }
+                _ => false,
+            };
+            (node, is_part)
+        };
+
+        if is_part {
+            let filename = Self::filename(hash);
+            let path = self.dir.join(&filename);
+            if !self.parts.contains(&hash) && !path.exists() {
+                if let Some(context) = context {
+                    let _: Model = model.render_with_context(context)?;
+                    let result = Self::write_part(model, &path);
+                    model.release_geometry();
+                    result?;
+                } else {
+                    Self::write_part(model, &path)?;
+                }
+                self.written += 1;
+            }
+            self.parts.insert(hash);
+            node["part"] = format!("{PARTS_DIR}/{filename}").into();
+        } else {
+            let children = model.borrow().children.clone();
+            node["children"] = children
+                .iter()
+                .map(|child| self.node(child, context.as_deref_mut()))
+                .collect::<Result<Vec<_>, _>>()?
+                .into();
+        }
+        Ok(node)
+    }
+
+    /// Write the rendered geometry of a part.
+    ///
+    /// The file is written under a temporary name first, so that an interrupted export does not
+    /// leave an incomplete part file behind.
+    /// A part without geometry is refused, because its empty file would be reused by later
+    /// exports.
+    fn write_part(model: &Model, path: &std::path::Path) -> Result<(), ExportError> {
+        let model_ = model.borrow();
+        let geometry = match model_.output() {
+            RenderOutput::Geometry3D {
+                geometry: Some(geometry),
+                ..
+            } => geometry,
+            _ => return Err(ExportError::RenderError(RenderError::NothingToRender)),
+        };
+
+        let temp = path.with_extension("stl.tmp");
+        {
+            let mut f = std::io::BufWriter::new(std::fs::File::create(&temp)?);
+            let mut writer = StlWriter::new(&mut f)?;
+            geometry.inner.write_stl(&mut writer)?;
+            drop(writer);
+            f.flush()?;
+        }
+        Ok(std::fs::rename(temp, path)?)
+    }
+
+    /// Write the manifest which describes the tree of `root`.
+    fn write_manifest(
+        &self,
+        filename: &std::path::Path,
+        root: serde_json::Value,
+    ) -> Result<(), ExportError> {
+        let mut f = std::io::BufWriter::new(std::fs::File::create(filename)?);
+        let manifest = json!({ "format": "stl", "root": root });
+        serde_json::to_writer_pretty(&mut f, &manifest).map_err(std::io::Error::from)?;
+        writeln!(f)?;
+        f.flush()?;
+        log::info!(
+            "Exported {parts} part(s) into {dir}, {written} written",
+            parts = self.parts.len(),
+            dir = self.dir.display(),
+            written = self.written
+        );
+        Ok(())
+    }
+}
+
+fn matrix_to_array(matrix: &Mat4) -> Vec<f64> {
+    let columns: [[f64; 4]; 4] = (*matrix).into();
+    columns.into_iter().flatten().collect()
+}
+
+impl Exporter for PartsExporter {
+    fn export(&self, model: &Model, filename: &std::path::Path) -> Result<Value, ExportError> {
+        let mut store = PartStore::new(filename)?;
+        let root = store.node(model, None)?;
+        store.write_manifest(filename, root)?;
+        Ok(Value::None)
+    }
+
+    fn render_and_export(
+        &self,
+        model: &Model,
+        context: &mut RenderContext,
+        filename: &std::path::Path,
+    ) -> Result<Value, ExportError> {
+        let mut store = PartStore::new(filename)?;
+        let root = store.node(model, Some(context))?;
+        store.write_manifest(filename, root)?;
+        Ok(Value::None)
+    }
+
+    fn output_type(&self) -> OutputType {
+        OutputType::Geometry3D
+    }
+}
+
+impl FileIoInterface for PartsExporter {
+    fn id(&self) -> Id {
+        Id::new("parts")
+    }
+}
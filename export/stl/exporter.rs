@@ -7,6 +7,7 @@ use microcad_lang::{
     Id,
     builtin::{ExportError, Exporter, FileIoInterface},
     model::{Model, OutputType},
+    render::RenderContext,
     value::Value,
 };
 
@@ -23,6 +24,22 @@ impl Exporter for StlExporter {
         Ok(Value::None)
     }
 
+    fn render_and_export(
+        &self,
+        model: &Model,
+        context: &mut RenderContext,
+        filename: &std::path::Path,
+    ) -> Result<Value, ExportError> {
+        let mut f = std::io::BufWriter::new(std::fs::File::create(filename)?);
+        let mut writer = StlWriter::new(&mut f)?;
+        model.render_parts(context, &mut |part| -> Result<(), ExportError> {
+            Ok(part.write_stl(&mut writer)?)
+        })?;
+        drop(writer);
+        std::io::Write::flush(&mut f)?;
+        Ok(Value::None)
+    }
+
     fn output_type(&self) -> OutputType {
         OutputType::Geometry3D
     }
@@ -27,6 +27,7 @@ impl WriteStl for Geometry3D {
         match self {
             Geometry3D::Mesh(triangle_mesh) => triangle_mesh.write_stl(writer),
             Geometry3D::Manifold(manifold) => manifold.write_stl(writer),
+            Geometry3D::Transformed(transformed) => transformed.apply().write_stl(writer),
             _ => unreachable!("Can only write triangle geometries to STL"),
         }
     }
@@ -38,11 +39,11 @@ impl WriteStl for Model {
         let output = self_.output();
         match output {
             microcad_lang::render::RenderOutput::Geometry3D {
-                world_matrix,
+                parent_matrix,
                 geometry,
                 ..
             } => {
-                let mat = world_matrix.expect("Some matrix");
+                let mat = parent_matrix.expect("Some matrix");
                 match geometry {
                     Some(geometry) => geometry.transformed_3d(&mat).write_stl(writer),
                     None => self_
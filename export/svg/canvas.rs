@@ -202,6 +202,7 @@ impl MapToCanvas for Geometry2D {
             Geometry2D::Collection(collection) => {
                 Geometry2D::Collection(collection.map_to_canvas(canvas))
             }
+            Geometry2D::Transformed(transformed) => transformed.apply().map_to_canvas(canvas),
         }
     }
 }
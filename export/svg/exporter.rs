@@ -130,6 +130,9 @@ impl Exporter for SvgExporter {
                 &model.get_theme().unwrap_or_default(),
             ))?;
 
+            let symbols = SvgSymbols::collect(model, writer.canvas());
+            writer.define_symbols(symbols)?;
+
             model.write_svg(&mut writer, &SvgTagAttributes::default())?;
             Ok(Value::None)
         } else {
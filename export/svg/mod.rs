@@ -7,6 +7,7 @@ mod attributes;
 mod canvas;
 pub mod exporter;
 mod primitives;
+mod symbols;
 pub mod writer;
 
 #[cfg(test)]
@@ -16,6 +17,7 @@ pub use attributes::SvgTagAttributes;
 pub use canvas::*;
 pub use exporter::*;
 pub use primitives::*;
+pub use symbols::*;
 pub use writer::*;
 
 /// Trait to write something into an SVG.
@@ -139,6 +139,7 @@ impl WriteSvg for Geometry2D {
             Geometry2D::Rect(rect) => rect.write_svg(writer, attr),
             Geometry2D::Line(edge) => edge.write_svg(writer, attr),
             Geometry2D::Collection(collection) => collection.write_svg(writer, attr),
+            Geometry2D::Transformed(transformed) => transformed.apply().write_svg(writer, attr),
         }
     }
 }
@@ -171,7 +172,7 @@ impl WriteSvg for Model {
 
                 match geometry {
                     Some(geometry) => {
-                        geometry.write_svg_mapped(writer, attr)?;
+                        writer.write_geometry(geometry, attr)?;
                     }
                     None => {
                         self_
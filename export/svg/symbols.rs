@@ -0,0 +1,184 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Reuse of geometry which is identical up to translation.
+//!
+//! Geometry which occurs more than once (e.g. holes created by multiplicity) is written once as
+//! `<symbol>` into `<defs>` and each occurrence as `<use>` with its position.
+
+use std::{
+    collections::HashMap,
+    hash::{DefaultHasher, Hash, Hasher},
+};
+
+use geo::CoordsIter;
+use microcad_core::*;
+use microcad_lang::{model::Model, render::RenderOutput};
+
+use crate::svg::{Canvas, MapToCanvas};
+
+/// Canvas coordinates are compared in steps of this size.
+const PRECISION: Scalar = 1e-6;
+
+/// Minimum number of coordinates of a geometry to be worth a symbol.
+const MIN_SYMBOL_COORDS: usize = 8;
+
+/// Position and hash of geometry in canvas coordinates.
+pub(crate) struct SvgShape {
+    /// Hash of the coordinates relative to `origin`.
+    pub hash: u64,
+    /// Minimum of the bounds.
+    pub origin: Vec2,
+}
+
+impl SvgShape {
+    /// Hash `geometry`, which has been mapped to canvas, relative to the minimum of its bounds.
+    ///
+    /// Returns `None` for geometry which is too small to be worth a symbol.
+    pub fn new(geometry: &Geometry2D) -> Option<Self> {
+        if coords_count(geometry) < MIN_SYMBOL_COORDS {
+            return None;
+        }
+        let origin = geometry.calc_bounds_2d().rect()?.min();
+        let origin = Vec2::new(origin.x, origin.y);
+
+        let mut hasher = DefaultHasher::new();
+        hash_geometry(geometry, origin, &mut hasher);
+        Some(Self {
+            hash: hasher.finish(),
+            origin,
+        })
+    }
+}
+
+/// A symbol with its number of occurrences.
+struct SvgSymbol {
+    /// Index of the symbol (`s0`, `s1`, ...).
+    index: usize,
+    /// Number of occurrences.
+    count: usize,
+    /// Geometry of the first occurrence relative to its origin.
+    geometry: Geometry2D,
+}
+
+/// Symbols by hash of their relative geometry.
+#[derive(Default)]
+pub struct SvgSymbols(HashMap<u64, SvgSymbol>);
+
+impl SvgSymbols {
+    /// Count the geometry of all models which are written by
+    /// [`WriteSvg for Model`](crate::svg::WriteSvg).
+    pub fn collect(model: &Model, canvas: &Canvas) -> Self {
+        let mut symbols = Self::default();
+        symbols.add_model(model, canvas);
+        symbols
+    }
+
+    fn add_model(&mut self, model: &Model, canvas: &Canvas) {
+        let model_ = model.borrow();
+        if let RenderOutput::Geometry2D { geometry, .. } = model_.output() {
+            match geometry {
+                Some(geometry) => self.add(geometry, canvas),
+                None => model_
+                    .children()
+                    .for_each(|child| self.add_model(child, canvas)),
+            }
+        }
+    }
+
+    /// Count an occurrence of `geometry`.
+    pub fn add(&mut self, geometry: &Geometry2D, canvas: &Canvas) {
+        let geometry = geometry.map_to_canvas(canvas);
+        if let Some(shape) = SvgShape::new(&geometry) {
+            let index = self.0.len();
+            self.0
+                .entry(shape.hash)
+                .or_insert_with(|| SvgSymbol {
+                    index,
+                    count: 0,
+                    geometry: geometry.transformed_2d(&Mat3::from_translation(-shape.origin)),
+                })
+                .count += 1;
+        }
+    }
+
+    /// Drop geometry which occurs only once and return the symbols in order of appearance.
+    pub(crate) fn into_defined(self) -> (HashMap<u64, String>, Vec<(String, Geometry2D)>) {
+        let mut symbols: Vec<_> = self.0.into_iter().filter(|(_, s)| s.count > 1).collect();
+        symbols.sort_by_key(|(_, symbol)| symbol.index);
+
+        let mut ids = HashMap::new();
+        let defs = symbols
+            .into_iter()
+            .enumerate()
+            .map(|(n, (hash, symbol))| {
+                let id = format!("s{n}");
+                ids.insert(hash, id.clone());
+                (id, symbol.geometry)
+            })
+            .collect();
+        (ids, defs)
+    }
+}
+
+fn coords_count(geometry: &Geometry2D) -> usize {
+    match geometry {
+        Geometry2D::LineString(line_string) => line_string.coords_count(),
+        Geometry2D::MultiLineString(multi_line_string) => multi_line_string.coords_count(),
+        Geometry2D::Polygon(polygon) => polygon.coords_count(),
+        Geometry2D::MultiPolygon(multi_polygon) => multi_polygon.coords_count(),
+        Geometry2D::Rect(_) | Geometry2D::Line(_) => 0,
+        Geometry2D::Collection(collection) => collection.iter().map(|g| coords_count(g)).sum(),
+        Geometry2D::Transformed(transformed) => coords_count(&transformed.geometry.inner),
+    }
+}
+
+fn hash_coords<'a>(
+    coords: impl ExactSizeIterator<Item = &'a geo::Coord>,
+    origin: Vec2,
+    hasher: &mut impl Hasher,
+) {
+    coords.len().hash(hasher);
+    coords.for_each(|coord| {
+        (((coord.x - origin.x) / PRECISION).round() as i64).hash(hasher);
+        (((coord.y - origin.y) / PRECISION).round() as i64).hash(hasher);
+    });
+}
+
+fn hash_polygon(polygon: &Polygon, origin: Vec2, hasher: &mut impl Hasher) {
+    polygon.interiors().len().hash(hasher);
+    hash_coords(polygon.exterior().0.iter(), origin, hasher);
+    polygon
+        .interiors()
+        .iter()
+        .for_each(|interior| hash_coords(interior.0.iter(), origin, hasher));
+}
+
+fn hash_geometry(geometry: &Geometry2D, origin: Vec2, hasher: &mut impl Hasher) {
+    geometry.name().hash(hasher);
+    match geometry {
+        Geometry2D::LineString(line_string) => hash_coords(line_string.0.iter(), origin, hasher),
+        Geometry2D::MultiLineString(multi_line_string) => {
+            multi_line_string.0.len().hash(hasher);
+            multi_line_string
+                .iter()
+                .for_each(|line_string| hash_coords(line_string.0.iter(), origin, hasher));
+        }
+        Geometry2D::Polygon(polygon) => hash_polygon(polygon, origin, hasher),
+        Geometry2D::MultiPolygon(multi_polygon) => {
+            multi_polygon.0.len().hash(hasher);
+            multi_polygon
+                .iter()
+                .for_each(|polygon| hash_polygon(polygon, origin, hasher));
+        }
+        Geometry2D::Rect(rect) => hash_coords([rect.min(), rect.max()].iter(), origin, hasher),
+        Geometry2D::Line(line) => hash_coords([line.0.0, line.1.0].iter(), origin, hasher),
+        Geometry2D::Collection(collection) => {
+            collection.len().hash(hasher);
+            collection
+                .iter()
+                .for_each(|geometry| hash_geometry(geometry, origin, hasher));
+        }
+        Geometry2D::Transformed(transformed) => hash_geometry(&transformed.apply(), origin, hasher),
+    }
+}
@@ -248,3 +248,48 @@ fn svg_sample_sketch() -> std::io::Result<()> {
 
     Ok(())
 }
+
+#[test]
+fn svg_symbols() -> std::io::Result<()> {
+    let filename = "../target/svg_symbols.svg";
+    let content_rect = Rect::new(coord! {x: 0.0, y: 0.0}, coord! {x: 100.0, y: 100.0});
+    let holes: Vec<_> = [(10.0, 10.0), (50.0, 20.0), (80.5, 70.25)]
+        .iter()
+        .map(|(x, y)| {
+            Geometry2D::Polygon(
+                Circle {
+                    radius: 3.0,
+                    offset: Vec2::new(*x, *y),
+                }
+                .polygon(16),
+            )
+        })
+        .collect();
+    let plate = Geometry2D::Rect(content_rect);
+
+    {
+        let mut svg = SvgWriter::new_canvas(
+            Box::new(std::fs::File::create(filename)?),
+            None,
+            content_rect,
+            None,
+        )?;
+        let mut symbols = SvgSymbols::default();
+        holes
+            .iter()
+            .chain([&plate])
+            .for_each(|geometry| symbols.add(geometry, svg.canvas()));
+        svg.define_symbols(symbols)?;
+        holes
+            .iter()
+            .chain([&plate])
+            .try_for_each(|geometry| svg.write_geometry(geometry, &Default::default()))?;
+    }
+
+    let svg = std::fs::read_to_string(filename)?;
+    assert_eq!(svg.matches("<symbol id=\"s0\"").count(), 1);
+    assert_eq!(svg.matches("<use xlink:href=\"#s0\"").count(), 3);
+    assert_eq!(svg.matches("<path").count(), 1);
+    assert_eq!(svg.matches("<rect").count(), 1);
+    Ok(())
+}
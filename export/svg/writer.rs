@@ -3,9 +3,11 @@
 
 //! Scalable Vector Graphics (SVG) file writer
 
+use std::collections::HashMap;
+
 use microcad_core::*;
 
-use crate::svg::{SvgTagAttributes, canvas::Canvas};
+use crate::svg::{MapToCanvas, SvgShape, SvgSymbols, SvgTagAttributes, WriteSvg, canvas::Canvas};
 
 /// SVG writer.
 pub struct SvgWriter {
@@ -15,6 +17,8 @@ pub struct SvgWriter {
     level: usize,
     /// The canvas.
     canvas: Canvas,
+    /// Ids of the defined symbols by hash of their geometry.
+    symbols: HashMap<u64, String>,
 }
 
 impl SvgWriter {
@@ -45,7 +49,7 @@ impl SvgWriter {
         writeln!(&mut writer, "<?xml version='1.0' encoding='UTF-8'?>")?;
         writeln!(
             &mut writer,
-            "<svg version='1.1' xmlns='http://www.w3.org/2000/svg' viewBox='{x} {y} {w} {h}' width='{w}mm' height='{h}mm'>",
+            "<svg version='1.1' xmlns='http://www.w3.org/2000/svg' xmlns:xlink='http://www.w3.org/1999/xlink' viewBox='{x} {y} {w} {h}' width='{w}mm' height='{h}mm'>",
         )?;
         writeln!(
             &mut writer,
@@ -70,6 +74,7 @@ impl SvgWriter {
             writer: Box::new(writer),
             level: 1,
             canvas,
+            symbols: HashMap::new(),
         })
     }
 
@@ -136,6 +141,55 @@ impl SvgWriter {
         self.close_tag("defs")
     }
 
+    /// Write geometry which occurs more than once into `<defs>` as `<symbol>`.
+    ///
+    /// [`Self::write_geometry`] refers to these symbols by `<use>`.
+    pub fn define_symbols(&mut self, symbols: SvgSymbols) -> std::io::Result<()> {
+        let (ids, defs) = symbols.into_defined();
+        if defs.is_empty() {
+            return Ok(());
+        }
+        self.open_tag("defs", &Default::default())?;
+        for (id, geometry) in defs {
+            self.open_tag(
+                &format!("symbol id=\"{id}\" overflow=\"visible\""),
+                &Default::default(),
+            )?;
+            geometry.write_svg(self, &Default::default())?;
+            self.close_tag("symbol")?;
+        }
+        self.close_tag("defs")?;
+        self.symbols = ids;
+        Ok(())
+    }
+
+    /// Write geometry mapped to canvas, as `<use>` if it is a defined symbol.
+    pub fn write_geometry(
+        &mut self,
+        geometry: &Geometry2D,
+        attr: &SvgTagAttributes,
+    ) -> std::io::Result<()> {
+        let geometry = geometry.map_to_canvas(&self.canvas);
+        let symbol = match self.symbols.is_empty() {
+            true => None,
+            false => SvgShape::new(&geometry).and_then(|shape| {
+                let id = self.symbols.get(&shape.hash)?.clone();
+                Some((id, shape.origin))
+            }),
+        };
+        match symbol {
+            Some((id, origin)) => self.tag(
+                &format!(
+                    "use xlink:href=\"#{id}\" x=\"{x}\" y=\"{y}\"",
+                    x = origin.x,
+                    y = origin.y
+                ),
+                attr,
+            ),
+            None => geometry.write_svg(self, attr),
+        }
+    }
+
     /// Style tag.
     pub fn style(&mut self, inner: &str) -> std::io::Result<()> {
         self.open_tag("style", &Default::default())?;
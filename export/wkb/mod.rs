@@ -0,0 +1,240 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Export 2D models to Well-Known Binary (WKB).
+//!
+//! The file holds a single `GeometryCollection` of the geometries which the WKT exporter would
+//! write line by line (see [`crate::wkt`]), with all numbers in little endian byte order and
+//! coordinates in world coordinates as raw doubles.
+//! Collections are written as nested `GeometryCollection`.
+//! The geometries are streamed into the file and their number is written into the header
+//! of the collection when the export has finished.
+
+use std::io::{Seek, SeekFrom, Write};
+
+use microcad_core::{Geometry2D, LineString, Mat3, Polygon};
+use microcad_lang::{
+    Id,
+    builtin::{ExportError, Exporter, FileIoInterface},
+    model::{Model, OutputType},
+    render::{RenderContext, RenderOutput},
+    value::Value,
+};
+
+use crate::wkt::transform;
+
+/// WKB Exporter.
+pub struct WkbExporter;
+
+/// Byte order mark for little endian.
+const LITTLE_ENDIAN: u8 = 1;
+
+/// WKB geometry types.
+#[repr(u32)]
+#[derive(Clone, Copy)]
+enum WkbType {
+    LineString = 2,
+    Polygon = 3,
+    MultiLineString = 5,
+    MultiPolygon = 6,
+    GeometryCollection = 7,
+}
+
+/// Writer of a WKB geometry collection.
+struct WkbWriter<'a, W: Write + Seek> {
+    writer: &'a mut W,
+    /// Position of the number of geometries in the collection header.
+    count_position: u64,
+    /// Number of geometries written.
+    count: u32,
+}
+
+impl<'a, W: Write + Seek> WkbWriter<'a, W> {
+    /// Begin a geometry collection.
+    fn new(writer: &'a mut W) -> std::io::Result<Self> {
+        let mut wkb = Self {
+            writer,
+            count_position: 0,
+            count: 0,
+        };
+        wkb.write_header(WkbType::GeometryCollection)?;
+        wkb.count_position = wkb.writer.stream_position()?;
+        wkb.write_u32(0)?;
+        Ok(wkb)
+    }
+
+    fn write_header(&mut self, ty: WkbType) -> std::io::Result<()> {
+        self.writer.write_all(&[LITTLE_ENDIAN])?;
+        self.writer.write_all(&(ty as u32).to_le_bytes())
+    }
+
+    fn write_u32(&mut self, n: usize) -> std::io::Result<()> {
+        self.writer.write_all(&(n as u32).to_le_bytes())
+    }
+
+    fn write_coords<'c>(
+        &mut self,
+        coords: impl ExactSizeIterator<Item = &'c geo::Coord>,
+        mat: &Mat3,
+    ) -> std::io::Result<()> {
+        self.write_u32(coords.len())?;
+        for coord in coords {
+            let (x, y) = transform(mat, coord);
+            self.writer.write_all(&x.to_le_bytes())?;
+            self.writer.write_all(&y.to_le_bytes())?;
+        }
+        Ok(())
+    }
+
+    fn write_line_string(&mut self, line_string: &LineString, mat: &Mat3) -> std::io::Result<()> {
+        self.write_header(WkbType::LineString)?;
+        self.write_coords(line_string.0.iter(), mat)
+    }
+
+    fn write_polygon(&mut self, polygon: &Polygon, mat: &Mat3) -> std::io::Result<()> {
+        self.write_header(WkbType::Polygon)?;
+        match polygon.exterior().0.is_empty() {
+            true => self.write_u32(0),
+            false => {
+                self.write_u32(1 + polygon.interiors().len())?;
+                self.write_coords(polygon.exterior().0.iter(), mat)?;
+                polygon
+                    .interiors()
+                    .iter()
+                    .try_for_each(|interior| self.write_coords(interior.0.iter(), mat))
+            }
+        }
+    }
+
+    /// Write a geometry into the collection.
+    fn write_geometry(&mut self, geometry: &Geometry2D, mat: &Mat3) -> std::io::Result<()> {
+        self.write_member(geometry, mat)?;
+        self.count += 1;
+        Ok(())
+    }
+
+    /// Write a geometry with all its members.
+    fn write_member(&mut self, geometry: &Geometry2D, mat: &Mat3) -> std::io::Result<()> {
+        match geometry {
+            Geometry2D::Transformed(transformed) => {
+                self.write_member(&transformed.geometry.inner, &(*mat * transformed.matrix))
+            }
+            Geometry2D::LineString(line_string) => self.write_line_string(line_string, mat),
+            Geometry2D::MultiLineString(multi_line_string) => {
+                self.write_header(WkbType::MultiLineString)?;
+                self.write_u32(multi_line_string.0.len())?;
+                multi_line_string
+                    .iter()
+                    .try_for_each(|line_string| self.write_line_string(line_string, mat))
+            }
+            Geometry2D::Line(line) => {
+                self.write_header(WkbType::LineString)?;
+                self.write_coords([line.0.0, line.1.0].iter(), mat)
+            }
+            Geometry2D::Polygon(polygon) => self.write_polygon(polygon, mat),
+            Geometry2D::Rect(rect) => self.write_polygon(&rect.to_polygon(), mat),
+            Geometry2D::MultiPolygon(multi_polygon) => {
+                self.write_header(WkbType::MultiPolygon)?;
+                self.write_u32(multi_polygon.0.len())?;
+                multi_polygon
+                    .iter()
+                    .try_for_each(|polygon| self.write_polygon(polygon, mat))
+            }
+            Geometry2D::Collection(collection) => {
+                self.write_header(WkbType::GeometryCollection)?;
+                self.write_u32(collection.len())?;
+                collection
+                    .iter()
+                    .try_for_each(|geometry| self.write_member(geometry, mat))
+            }
+        }
+    }
+
+    /// Write the geometry of a model and its children with their parent matrices.
+    fn write_model(&mut self, model: &Model) -> std::io::Result<()> {
+        let model_ = model.borrow();
+        match model_.output() {
+            RenderOutput::Geometry2D {
+                parent_matrix,
+                geometry,
+                ..
+            } => match geometry {
+                Some(geometry) => {
+                    self.write_geometry(&geometry.inner, &parent_matrix.expect("Some matrix"))
+                }
+                None => model_
+                    .children()
+                    .try_for_each(|model| self.write_model(model)),
+            },
+            _ => Ok(()),
+        }
+    }
+
+    /// Write the number of geometries into the collection header.
+    fn finish(self) -> std::io::Result<()> {
+        let end = self.writer.stream_position()?;
+        self.writer.seek(SeekFrom::Start(self.count_position))?;
+        self.writer.write_all(&self.count.to_le_bytes())?;
+        self.writer.seek(SeekFrom::Start(end))?;
+        self.writer.flush()
+    }
+}
+
+impl Exporter for WkbExporter {
+    fn export(&self, model: &Model, filename: &std::path::Path) -> Result<Value, ExportError> {
+        let mut f = std::io::BufWriter::new(std::fs::File::create(filename)?);
+        let mut writer = WkbWriter::new(&mut f)?;
+        writer.write_model(model)?;
+        writer.finish()?;
+        Ok(Value::None)
+    }
+
+    fn render_and_export(
+        &self,
+        model: &Model,
+        context: &mut RenderContext,
+        filename: &std::path::Path,
+    ) -> Result<Value, ExportError> {
+        let mut f = std::io::BufWriter::new(std::fs::File::create(filename)?);
+        let mut writer = WkbWriter::new(&mut f)?;
+        model.render_parts(context, &mut |part| -> Result<(), ExportError> {
+            Ok(writer.write_model(part)?)
+        })?;
+        writer.finish()?;
+        Ok(Value::None)
+    }
+
+    fn output_type(&self) -> OutputType {
+        OutputType::Geometry2D
+    }
+}
+
+impl FileIoInterface for WkbExporter {
+    fn id(&self) -> Id {
+        Id::new("wkb")
+    }
+}
+
+#[test]
+fn wkb_collection() {
+    let mut wkb = std::io::Cursor::new(Vec::new());
+    let mut writer = WkbWriter::new(&mut wkb).expect("wkb");
+    let line = Geometry2D::LineString(LineString::from(vec![(0.0, 0.0), (1.0, 2.0)]));
+    let mat = Mat3::from_translation(microcad_core::Vec2::new(1.0, 0.0));
+    writer.write_geometry(&line, &mat).expect("wkb");
+    let collection = Geometry2D::Collection(microcad_core::Geometries2D::new(vec![line]));
+    writer.write_geometry(&collection, &mat).expect("wkb");
+    writer.finish().expect("wkb");
+
+    let wkb = wkb.into_inner();
+    // collection header, line string, collection with a line string
+    assert_eq!(wkb.len(), 9 + (9 + 2 * 16) + (9 + 9 + 2 * 16));
+    assert_eq!(wkb[..9], [1, 7, 0, 0, 0, 2, 0, 0, 0]);
+    assert_eq!(wkb[9..18], [1, 2, 0, 0, 0, 2, 0, 0, 0]);
+    assert_eq!(wkb[18..26], 1.0_f64.to_le_bytes());
+    assert_eq!(wkb[42..50], 2.0_f64.to_le_bytes());
+    assert_eq!(
+        wkb[50..68],
+        [1, 7, 0, 0, 0, 1, 0, 0, 0, 1, 2, 0, 0, 0, 2, 0, 0, 0]
+    );
+}
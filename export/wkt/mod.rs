@@ -2,80 +2,177 @@
 // SPDX-License-Identifier: AGPL-3.0-or-later
 
 //! Export 2D models to Well-Known Text (WKT).
+//!
+//! The geometry is streamed into the file and transformed into world coordinates while its
+//! coordinates are written, so neither the text nor transformed copies of the geometry are
+//! held in memory.
+//! Each geometry is written as one line, collections as `GEOMETRYCOLLECTION` of their members.
 
-use std::fmt::Write;
+use std::io::Write;
 
-use geo::line_string;
-use microcad_core::{Geometries2D, Geometry2D, Transformed2D};
+use cgmath::SquareMatrix;
+use microcad_core::{Geometry2D, LineString, Mat3, Polygon};
 use microcad_lang::{
     Id,
     builtin::{ExportError, Exporter, FileIoInterface},
     model::{Model, OutputType},
+    render::{RenderContext, RenderOutput},
     value::Value,
 };
-use wkt::ToWkt;
 
 /// WKT Exporter.
 pub struct WktExporter;
 
+/// Transform a coordinate by `mat`.
+pub(crate) fn transform(mat: &Mat3, coord: &geo::Coord) -> (f64, f64) {
+    (
+        mat.x.x * coord.x + mat.y.x * coord.y + mat.z.x,
+        mat.x.y * coord.x + mat.y.y * coord.y + mat.z.y,
+    )
+}
+
 trait WriteWkt {
-    fn write_wkt(&self, writer: &mut impl Write) -> std::fmt::Result;
+    /// Write WKT with all coordinates transformed by `mat`.
+    fn write_wkt(&self, writer: &mut impl Write, mat: &Mat3) -> std::io::Result<()>;
+}
+
+fn write_coords<'a>(
+    writer: &mut impl Write,
+    coords: impl Iterator<Item = &'a geo::Coord>,
+    mat: &Mat3,
+) -> std::io::Result<()> {
+    write!(writer, "(")?;
+    for (n, coord) in coords.enumerate() {
+        let (x, y) = transform(mat, coord);
+        match n {
+            0 => write!(writer, "{x} {y}")?,
+            _ => write!(writer, ",{x} {y}")?,
+        }
+    }
+    write!(writer, ")")
+}
+
+impl WriteWkt for LineString {
+    fn write_wkt(&self, writer: &mut impl Write, mat: &Mat3) -> std::io::Result<()> {
+        match self.0.is_empty() {
+            true => write!(writer, "EMPTY"),
+            false => write_coords(writer, self.0.iter(), mat),
+        }
+    }
 }
 
-impl WriteWkt for Geometries2D {
-    fn write_wkt(&self, writer: &mut impl Write) -> std::fmt::Result {
-        writeln!(writer, "GEOMETRYCOLLECTION(")?;
-        self.iter().try_for_each(|geo| geo.write_wkt(writer))?;
-        writeln!(writer, ")")
+impl WriteWkt for Polygon {
+    fn write_wkt(&self, writer: &mut impl Write, mat: &Mat3) -> std::io::Result<()> {
+        if self.exterior().0.is_empty() {
+            return write!(writer, "EMPTY");
+        }
+        write!(writer, "(")?;
+        write_coords(writer, self.exterior().0.iter(), mat)?;
+        for interior in self.interiors() {
+            write!(writer, ",")?;
+            write_coords(writer, interior.0.iter(), mat)?;
+        }
+        write!(writer, ")")
     }
 }
 
 impl WriteWkt for Geometry2D {
-    fn write_wkt(&self, writer: &mut impl Write) -> std::fmt::Result {
-        match &self {
-            Geometry2D::LineString(line_string) => {
-                writeln!(writer, "{}", line_string.wkt_string())
-            }
-            Geometry2D::MultiLineString(multi_line_string) => {
-                writeln!(writer, "{}", multi_line_string.wkt_string())
-            }
-            Geometry2D::Polygon(polygon) => {
-                writeln!(writer, "{}", polygon.wkt_string())
-            }
-            Geometry2D::MultiPolygon(multi_polygon) => {
-                writeln!(writer, "{}", multi_polygon.wkt_string())
-            }
-            Geometry2D::Rect(rect) => {
-                writeln!(writer, "{}", rect.wkt_string())
+    fn write_wkt(&self, writer: &mut impl Write, mat: &Mat3) -> std::io::Result<()> {
+        write_geometry(self, writer, mat)?;
+        writeln!(writer)
+    }
+}
+
+/// Write the members of a multi geometry or collection in parentheses or ` EMPTY`.
+fn write_members<W: Write, T>(
+    writer: &mut W,
+    members: impl Iterator<Item = T>,
+    mut f: impl FnMut(&mut W, T) -> std::io::Result<()>,
+) -> std::io::Result<()> {
+    let mut count = 0;
+    for member in members {
+        write!(writer, "{}", if count == 0 { "(" } else { "," })?;
+        f(writer, member)?;
+        count += 1;
+    }
+    match count {
+        0 => write!(writer, " EMPTY"),
+        _ => write!(writer, ")"),
+    }
+}
+
+/// Write a tagged geometry, e.g. `POLYGON((...))`, without line break.
+fn write_geometry<W: Write>(
+    geometry: &Geometry2D,
+    writer: &mut W,
+    mat: &Mat3,
+) -> std::io::Result<()> {
+    match geometry {
+        Geometry2D::Transformed(transformed) => write_geometry(
+            &transformed.geometry.inner,
+            writer,
+            &(*mat * transformed.matrix),
+        ),
+        Geometry2D::LineString(line_string) => {
+            write!(writer, "LINESTRING")?;
+            if line_string.0.is_empty() {
+                write!(writer, " ")?;
             }
-            Geometry2D::Line(line) => {
-                writeln!(
-                    writer,
-                    "{}",
-                    line_string![line.0.into(), line.1.into()].wkt_string()
-                )
+            line_string.write_wkt(writer, mat)
+        }
+        Geometry2D::MultiLineString(multi_line_string) => {
+            write!(writer, "MULTILINESTRING")?;
+            write_members(writer, multi_line_string.iter(), |writer, line_string| {
+                line_string.write_wkt(writer, mat)
+            })
+        }
+        Geometry2D::Line(line) => {
+            write!(writer, "LINESTRING")?;
+            write_coords(writer, [line.0.0, line.1.0].iter(), mat)
+        }
+        Geometry2D::Polygon(polygon) => {
+            write!(writer, "POLYGON")?;
+            if polygon.exterior().0.is_empty() {
+                write!(writer, " ")?;
             }
-            Geometry2D::Collection(collection) => collection.write_wkt(writer),
+            polygon.write_wkt(writer, mat)
+        }
+        Geometry2D::Rect(rect) => {
+            write!(writer, "POLYGON")?;
+            rect.to_polygon().write_wkt(writer, mat)
+        }
+        Geometry2D::MultiPolygon(multi_polygon) => {
+            write!(writer, "MULTIPOLYGON")?;
+            write_members(writer, multi_polygon.iter(), |writer, polygon| {
+                polygon.write_wkt(writer, mat)
+            })
+        }
+        Geometry2D::Collection(collection) => {
+            write!(writer, "GEOMETRYCOLLECTION")?;
+            write_members(writer, collection.iter(), |writer, geometry| {
+                write_geometry(geometry, writer, mat)
+            })
         }
     }
 }
 
+/// Models are written with the world matrix of their parent, because the geometry of a
+/// transformation already contains its local matrix.
 impl WriteWkt for Model {
-    fn write_wkt(&self, writer: &mut impl Write) -> std::fmt::Result {
+    fn write_wkt(&self, writer: &mut impl Write, _: &Mat3) -> std::io::Result<()> {
         let self_ = self.borrow();
-        let output = self_.output();
-        match output {
-            microcad_lang::render::RenderOutput::Geometry2D {
-                world_matrix,
+        match self_.output() {
+            RenderOutput::Geometry2D {
+                parent_matrix,
                 geometry,
                 ..
             } => {
-                let mat = world_matrix.expect("Some matrix");
+                let mat = parent_matrix.expect("Some matrix");
                 match geometry {
-                    Some(geometry) => (*geometry.transformed_2d(&mat)).write_wkt(writer),
+                    Some(geometry) => geometry.inner.write_wkt(writer, &mat),
                     None => self_
                         .children()
-                        .try_for_each(|model| model.write_wkt(writer)),
+                        .try_for_each(|model| model.write_wkt(writer, &mat)),
                 }
             }
             _ => Ok(()),
@@ -85,12 +182,23 @@ impl WriteWkt for Model {
 
 impl Exporter for WktExporter {
     fn export(&self, model: &Model, filename: &std::path::Path) -> Result<Value, ExportError> {
-        use std::io::Write;
+        let mut f = std::io::BufWriter::new(std::fs::File::create(filename)?);
+        model.write_wkt(&mut f, &Mat3::identity())?;
+        f.flush()?;
+        Ok(Value::None)
+    }
 
-        let mut f = std::fs::File::create(filename)?;
-        let mut buffer = String::new();
-        model.write_wkt(&mut buffer)?;
-        f.write_all(buffer.as_bytes())?;
+    fn render_and_export(
+        &self,
+        model: &Model,
+        context: &mut RenderContext,
+        filename: &std::path::Path,
+    ) -> Result<Value, ExportError> {
+        let mut f = std::io::BufWriter::new(std::fs::File::create(filename)?);
+        model.render_parts(context, &mut |part| -> Result<(), ExportError> {
+            Ok(part.write_wkt(&mut f, &Mat3::identity())?)
+        })?;
+        f.flush()?;
         Ok(Value::None)
     }
 
@@ -104,3 +212,29 @@ impl FileIoInterface for WktExporter {
         Id::new("wkt")
     }
 }
+
+#[test]
+fn wkt_transformed() {
+    use microcad_core::Vec2;
+    use std::rc::Rc;
+
+    let triangle = Geometry2D::Polygon(Polygon::new(
+        LineString::from(vec![(0.0, 0.0), (1.0, 0.0), (1.0, 2.0)]),
+        vec![],
+    ));
+    let line = Geometry2D::LineString(LineString::from(vec![(0.0, 0.0), (1.0, 1.0)]));
+    let mat = Mat3::from_translation(Vec2::new(10.0, 0.0));
+
+    let mut wkt = Vec::new();
+    triangle.write_wkt(&mut wkt, &mat).expect("wkt");
+    line.write_wkt(&mut wkt, &mat).expect("wkt");
+    Geometry2D::Collection([triangle, line].into_iter().map(Rc::new).collect())
+        .write_wkt(&mut wkt, &mat)
+        .expect("wkt");
+    assert_eq!(
+        String::from_utf8(wkt).expect("utf-8"),
+        "POLYGON((10 0,11 0,11 2,10 0))\n\
+         LINESTRING(10 0,11 1)\n\
+         GEOMETRYCOLLECTION(POLYGON((10 0,11 0,11 2,10 0)),LINESTRING(10 0,11 1))\n"
+    );
+}
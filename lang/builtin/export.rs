@@ -5,7 +5,14 @@
 
 use std::rc::Rc;
 
-use crate::{Id, builtin::file_io::*, model::*, parameter, render::RenderError, value::*};
+use crate::{
+    Id,
+    builtin::file_io::*,
+    model::*,
+    parameter,
+    render::{RenderContext, RenderError},
+    value::*,
+};
 
 use thiserror::Error;
 
@@ -72,6 +79,20 @@ pub trait Exporter: FileIoInterface {
     /// Export the model if the model is marked for export.
     fn export(&self, model: &Model, filename: &std::path::Path) -> Result<Value, ExportError>;
 
+    /// Render the pre-rendered model and export it.
+    ///
+    /// Reimplement this function when your export format can be written part by part
+    /// (see [`Model::render_parts`]), so that only one rendered part is kept in memory.
+    fn render_and_export(
+        &self,
+        model: &Model,
+        context: &mut RenderContext,
+        filename: &std::path::Path,
+    ) -> Result<Value, ExportError> {
+        use crate::render::RenderWithContext;
+        self.export(&model.render_with_context(context)?, filename)
+    }
+
     /// The expected model output type of this exporter.
     ///
     /// Reimplement this function when your export output format only accepts specific model output types.
@@ -41,6 +41,11 @@ impl DiagHandler {
         self.diag_list.pretty_print(f, source_by_hash)
     }
 
+    /// Return all collected diagnostics.
+    pub fn diag_list(&self) -> &DiagList {
+        &self.diag_list
+    }
+
     /// Return overall number of occurred errors.
     pub fn warning_count(&self) -> u32 {
         self.warning_count
@@ -53,30 +58,29 @@ impl DiagHandler {
 
     /// return lines with errors
     pub fn error_lines(&self) -> std::collections::HashSet<usize> {
-        self.diag_list
-            .iter()
-            .filter_map(|d| {
-                if d.level() == Level::Error {
-                    d.line()
-                } else {
-                    None
-                }
-            })
-            .collect()
+        self.diag_list.error_lines()
     }
 
     /// return lines with warnings
     pub fn warning_lines(&self) -> std::collections::HashSet<usize> {
-        self.diag_list
-            .iter()
-            .filter_map(|d| {
-                if d.level() == Level::Warning {
-                    d.line()
-                } else {
-                    None
-                }
-            })
-            .collect()
+        self.diag_list.warning_lines()
+    }
+
+    /// Write all diagnostics of all files and the number of errors and warnings as JSON object.
+    pub fn write_json(
+        &self,
+        f: &mut dyn std::fmt::Write,
+        source_by_hash: &impl GetSourceByHash,
+    ) -> std::fmt::Result {
+        write!(
+            f,
+            "{{\"errors\":{},\"warnings\":{},\"suppressed\":{},\"diagnostics\":",
+            self.error_count,
+            self.warning_count,
+            self.diag_list.suppressed_count()
+        )?;
+        self.diag_list.write_json(f, source_by_hash)?;
+        writeln!(f, "}}")
     }
 }
 
@@ -93,11 +97,17 @@ impl PushDiag for DiagHandler {
             return Err(DiagError::ErrorLimitReached(error_limit));
         }
 
-        match &diag {
-            Diagnostic::Error(_) => {
+        let level = diag.level();
+        if !self.diag_list.insert(diag) {
+            // duplicates are neither kept nor counted
+            return Ok(());
+        }
+
+        match level {
+            Level::Error => {
                 self.error_count += 1;
             }
-            Diagnostic::Warning(_) => {
+            Level::Warning => {
                 if self.warnings_as_errors {
                     self.error_count += 1;
                 } else {
@@ -106,7 +116,6 @@ impl PushDiag for DiagHandler {
             }
             _ => (),
         }
-
-        self.diag_list.push_diag(diag)
+        Ok(())
     }
 }
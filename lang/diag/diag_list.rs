@@ -1,29 +1,239 @@
 // Copyright © 2024-2025 The µcad authors <info@ucad.xyz>
 // SPDX-License-Identifier: AGPL-3.0-or-later
 
-use crate::{diag::*, resolve::*};
+use super::diagnostic::DiagSource;
+use crate::{diag::*, rc::*, resolve::*, syntax::SourceFile};
 use derive_more::Deref;
+use std::collections::{HashMap, HashSet};
+
+/// Maximum number of warnings and errors which are kept per source code line.
+pub const DIAGNOSTICS_PER_LINE: u32 = 10;
+
+/// Warnings and errors of one source code line.
+#[derive(Debug, Default)]
+struct LineDiags {
+    /// Number of errors.
+    errors: u32,
+    /// Number of warnings.
+    warnings: u32,
+    /// Number of kept diagnostics.
+    kept: u32,
+    /// Number of diagnostics which exceeded [`DIAGNOSTICS_PER_LINE`].
+    suppressed: u32,
+}
+
+/// What makes a warning or error a duplicate: level, source file hash, range and message.
+type DiagKey = (bool, u64, Option<std::ops::Range<usize>>, String);
 
 /// Source file diagnostics.
+///
+/// Warnings and errors are indexed by source file and line when they are inserted.
+/// Duplicates (same level, message and source code reference) are dropped and at most
+/// [`DIAGNOSTICS_PER_LINE`] of them are kept per line.
 #[derive(Debug, Default, Deref)]
-pub struct DiagList(Vec<Diagnostic>);
+pub struct DiagList {
+    /// Kept diagnostics in order of insertion.
+    #[deref]
+    diags: Vec<Diagnostic>,
+    /// Warnings and errors per source file hash and line.
+    lines: HashMap<(u64, usize), LineDiags>,
+    /// Keys of all inserted warnings and errors.
+    seen: HashSet<DiagKey>,
+}
 
 impl DiagList {
+    /// Insert a diagnostic and return `false` if it duplicates a previous warning or error.
+    pub fn insert(&mut self, diag: Diagnostic) -> bool {
+        let level = diag.level();
+        let is_error = match level {
+            Level::Error => true,
+            Level::Warning => false,
+            Level::Trace | Level::Info => {
+                self.diags.push(diag);
+                return true;
+            }
+        };
+
+        let src_ref = diag.src_ref();
+        let key = (
+            is_error,
+            src_ref.source_hash(),
+            src_ref.0.map(|inner| inner.range()),
+            diag.message(),
+        );
+        if !self.seen.insert(key) {
+            return false;
+        }
+
+        let Some(at) = src_ref.at() else {
+            self.diags.push(diag);
+            return true;
+        };
+        let line = self
+            .lines
+            .entry((src_ref.source_hash(), at.line))
+            .or_default();
+        match is_error {
+            true => line.errors += 1,
+            false => line.warnings += 1,
+        }
+        if line.kept < DIAGNOSTICS_PER_LINE {
+            line.kept += 1;
+            self.diags.push(diag);
+        } else {
+            line.suppressed += 1;
+        }
+        true
+    }
+
+    /// Return lines with errors (in any source file).
+    pub fn error_lines(&self) -> HashSet<usize> {
+        self.lines
+            .iter()
+            .filter(|(_, line)| line.errors > 0)
+            .map(|((_, line), _)| *line)
+            .collect()
+    }
+
+    /// Return lines with warnings (in any source file).
+    pub fn warning_lines(&self) -> HashSet<usize> {
+        self.lines
+            .iter()
+            .filter(|(_, line)| line.warnings > 0)
+            .map(|((_, line), _)| *line)
+            .collect()
+    }
+
+    /// Return number of warnings and errors which have not been kept.
+    pub fn suppressed_count(&self) -> u32 {
+        self.lines.values().map(|line| line.suppressed).sum()
+    }
+
     /// Pretty print this list of diagnostics.
+    ///
+    /// Each source file is fetched and prepared only once.
     pub fn pretty_print(
         &self,
         f: &mut dyn std::fmt::Write,
         source_by_hash: &impl GetSourceByHash,
     ) -> std::fmt::Result {
-        self.0
+        let source_files = self.source_files(source_by_hash);
+        let sources = Self::prepare(&source_files);
+
+        self.diags.iter().try_for_each(|diag| {
+            diag.pretty_print_in(f, sources.get(&diag.src_ref().source_hash()))
+        })?;
+
+        let mut suppressed: Vec<_> = self
+            .lines
+            .iter()
+            .filter(|(_, line)| line.suppressed > 0)
+            .collect();
+        suppressed.sort_by_key(|(location, _)| **location);
+        suppressed
+            .into_iter()
+            .try_for_each(|((hash, line), diags)| {
+                writeln!(
+                    f,
+                    "note: {} more warning(s) or error(s) in {}:{line} suppressed",
+                    diags.suppressed,
+                    sources
+                        .get(hash)
+                        .map(|source| source.filename())
+                        .unwrap_or(crate::invalid!(FILE)),
+                )
+            })
+    }
+
+    /// Write this list of diagnostics as JSON array.
+    pub fn write_json(
+        &self,
+        f: &mut dyn std::fmt::Write,
+        source_by_hash: &impl GetSourceByHash,
+    ) -> std::fmt::Result {
+        let source_files = self.source_files(source_by_hash);
+        let sources = Self::prepare(&source_files);
+
+        write!(f, "[")?;
+        for (n, diag) in self.diags.iter().enumerate() {
+            if n > 0 {
+                write!(f, ",")?;
+            }
+            diag.write_json(f, sources.get(&diag.src_ref().source_hash()))?;
+        }
+        write!(f, "]")
+    }
+
+    /// Fetch all source files which are referred by diagnostics.
+    fn source_files(&self, source_by_hash: &impl GetSourceByHash) -> HashMap<u64, Rc<SourceFile>> {
+        let mut source_files = HashMap::new();
+        let hashes: HashSet<_> = self
+            .diags
+            .iter()
+            .map(|diag| diag.src_ref().source_hash())
+            .chain(self.lines.keys().map(|(hash, _)| *hash))
+            .collect();
+        hashes.into_iter().for_each(|hash| {
+            if let Ok(source_file) = source_by_hash.get_by_hash(hash) {
+                source_files.insert(hash, source_file);
+            }
+        });
+        source_files
+    }
+
+    fn prepare(source_files: &HashMap<u64, Rc<SourceFile>>) -> HashMap<u64, DiagSource<'_>> {
+        source_files
             .iter()
-            .try_for_each(|diag| diag.pretty_print(f, source_by_hash))
+            .map(|(hash, source_file)| (*hash, DiagSource::new(source_file)))
+            .collect()
     }
 }
 
 impl PushDiag for DiagList {
     fn push_diag(&mut self, diag: Diagnostic) -> DiagResult<()> {
-        self.0.push(diag);
+        self.insert(diag);
         Ok(())
     }
 }
+
+#[test]
+fn dedup_and_cap() {
+    use crate::src_ref::*;
+
+    struct NoSources;
+    impl GetSourceByHash for NoSources {
+        fn get_by_hash(&self, hash: u64) -> ResolveResult<Rc<SourceFile>> {
+            Err(ResolveError::UnknownHash(hash))
+        }
+    }
+
+    let registration = FileId::register(0xd1a6, "a;\nb;\nc;");
+    let file = registration.id();
+    let mut diag_list = DiagList::default();
+    let error = |n: u32, range| {
+        Diagnostic::Error(Refer::new(
+            Box::new(DiagError::ErrorLimitReached(n)) as Box<dyn std::error::Error>,
+            SrcRef::new(range, file),
+        ))
+    };
+
+    assert!(diag_list.insert(error(1, 0..1)));
+    assert!(!diag_list.insert(error(1, 0..1)));
+    (0..DIAGNOSTICS_PER_LINE + 2).for_each(|n| {
+        diag_list.insert(error(n + 2, 3..4));
+    });
+    diag_list
+        .warning(&SrcRef::new(6..7, file), DiagError::ErrorLimitReached(0))
+        .expect("warning");
+
+    assert_eq!(diag_list.len() as u32, 2 + DIAGNOSTICS_PER_LINE);
+    assert_eq!(diag_list.suppressed_count(), 2);
+    assert_eq!(diag_list.error_lines(), HashSet::from([1, 2]));
+    assert_eq!(diag_list.warning_lines(), HashSet::from([3]));
+
+    let mut json = String::new();
+    diag_list.write_json(&mut json, &NoSources).expect("json");
+    assert!(json.starts_with(
+        r#"[{"level":"error","message":"Error limit reached: Stopped evaluation after 1 errors","line":1,"column":1,"start":0,"end":1},"#
+    ));
+}
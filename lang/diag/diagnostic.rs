@@ -1,7 +1,7 @@
 // Copyright © 2024-2025 The µcad authors <info@ucad.xyz>
 // SPDX-License-Identifier: AGPL-3.0-or-later
 
-use crate::{diag::*, resolve::*, src_ref::*};
+use crate::{diag::*, resolve::*, src_ref::*, syntax::SourceFile};
 
 /// Diagnostic message with source code reference attached.
 pub enum Diagnostic {
@@ -42,7 +42,7 @@ impl Diagnostic {
             Diagnostic::Warning(r) => r.src_ref(),
             Diagnostic::Error(r) => r.src_ref(),
         };
-        src_ref.as_ref().map(|r| r.at.line)
+        src_ref.at().map(|at| at.line)
     }
 
     /// Pretty print the diagnostic.
@@ -67,51 +67,51 @@ impl Diagnostic {
         &self,
         f: &mut dyn std::fmt::Write,
         source_by_hash: &impl GetSourceByHash,
+    ) -> std::fmt::Result {
+        let source_file = source_by_hash
+            .get_by_hash(self.src_ref().source_hash())
+            .ok();
+        let source = source_file.as_deref().map(DiagSource::new);
+        self.pretty_print_in(f, source.as_ref())
+    }
+
+    /// Pretty print the diagnostic with an already prepared source file.
+    pub(super) fn pretty_print_in(
+        &self,
+        f: &mut dyn std::fmt::Write,
+        source: Option<&DiagSource>,
     ) -> std::fmt::Result {
         let src_ref = self.src_ref();
-        let source_file = source_by_hash.get_by_hash(src_ref.source_hash());
-
-        fn make_relative(path: &std::path::Path) -> String {
-            let current_dir = std::env::current_dir().expect("current dir");
-            if let Ok(path) = path.canonicalize() {
-                pathdiff::diff_paths(path, current_dir)
-                    .expect("related paths:\n  {path:?}\n  {current_dir:?}")
-            } else {
-                path.to_path_buf()
-            }
-            .to_string_lossy()
-            .to_string()
-        }
-        match &src_ref {
-            SrcRef(None) => writeln!(f, "{}: {}", self.level(), self.message())?,
-            SrcRef(Some(src_ref)) => {
+        match src_ref.at() {
+            None => writeln!(f, "{}: {}", self.level(), self.message())?,
+            Some(at) => {
                 writeln!(f, "{}: {}", self.level(), self.message())?;
                 writeln!(
                     f,
                     "  ---> {}:{}",
-                    source_file
-                        .as_ref()
-                        .map(|sf| make_relative(&sf.filename()))
-                        .unwrap_or(crate::invalid!(FILE).to_string()),
-                    src_ref.at
+                    source
+                        .map(|source| source.filename.as_str())
+                        .unwrap_or(crate::invalid!(FILE)),
+                    at
                 )?;
                 writeln!(f, "     |",)?;
 
-                let line = source_file
-                    .as_ref()
-                    .map(|sf| {
-                        sf.get_line(src_ref.at.line - 1)
+                let line = source
+                    .map(|source| {
+                        source
+                            .lines
+                            .get(at.line - 1)
+                            .copied()
                             .unwrap_or(crate::invalid!(LINE))
                     })
                     .unwrap_or(crate::invalid!(FILE));
 
-                writeln!(f, "{: >4} | {}", src_ref.at.line, line)?;
+                writeln!(f, "{: >4} | {}", at.line, line)?;
                 writeln!(
                     f,
                     "{: >4} | {}",
                     "",
-                    " ".repeat(src_ref.at.col - 1)
-                        + &"^".repeat(src_ref.range.len().min(line.len())),
+                    " ".repeat(at.col - 1) + &"^".repeat(src_ref.len().min(line.len())),
                 )?;
                 writeln!(f, "     |",)?;
             }
@@ -119,6 +119,71 @@ impl Diagnostic {
 
         Ok(())
     }
+
+    /// Write the diagnostic as JSON object.
+    ///
+    /// `file`, `line`, `column`, `start` and `end` are omitted if unknown.
+    pub(super) fn write_json(
+        &self,
+        f: &mut dyn std::fmt::Write,
+        source: Option<&DiagSource>,
+    ) -> std::fmt::Result {
+        use crate::trace::escape_json;
+
+        let src_ref = self.src_ref();
+        write!(
+            f,
+            "{{\"level\":\"{}\",\"message\":\"{}\"",
+            self.level(),
+            escape_json(&self.message())
+        )?;
+        if let Some(source) = source {
+            write!(f, ",\"file\":\"{}\"", escape_json(&source.filename))?;
+        }
+        if let (Some(inner), Some(at)) = (src_ref.0, src_ref.at()) {
+            let range = inner.range();
+            write!(
+                f,
+                ",\"line\":{},\"column\":{},\"start\":{},\"end\":{}",
+                at.line, at.col, range.start, range.end
+            )?;
+        }
+        write!(f, "}}")
+    }
+}
+
+/// Source file of diagnostics which is prepared once for pretty printing.
+pub(super) struct DiagSource<'a> {
+    /// File name relative to the current directory.
+    filename: String,
+    /// Source code lines.
+    lines: Vec<&'a str>,
+}
+
+impl<'a> DiagSource<'a> {
+    pub(super) fn new(source_file: &'a SourceFile) -> Self {
+        Self {
+            filename: make_relative(&source_file.filename()),
+            lines: source_file.source.lines().collect(),
+        }
+    }
+
+    /// File name relative to the current directory.
+    pub(super) fn filename(&self) -> &str {
+        &self.filename
+    }
+}
+
+fn make_relative(path: &std::path::Path) -> String {
+    let current_dir = std::env::current_dir().expect("current dir");
+    if let Ok(path) = path.canonicalize() {
+        pathdiff::diff_paths(path, current_dir)
+            .expect("related paths:\n  {path:?}\n  {current_dir:?}")
+    } else {
+        path.to_path_buf()
+    }
+    .to_string_lossy()
+    .to_string()
 }
 
 impl SrcReferrer for Diagnostic {
@@ -86,6 +86,17 @@ pub trait Diag {
         str
     }
 
+    /// Write all errors as JSON object (e.g. for CI tools).
+    fn fmt_diagnosis_json(&self, f: &mut dyn std::fmt::Write) -> std::fmt::Result;
+
+    /// Get all errors as JSON string.
+    fn json_diagnosis(&self) -> String {
+        let mut str = String::new();
+        self.fmt_diagnosis_json(&mut str)
+            .expect("displayable diagnosis");
+        str
+    }
+
     /// Returns true if there are warnings.
     fn has_warnings(&self) -> bool {
         self.warning_count() > 0
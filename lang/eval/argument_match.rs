@@ -5,12 +5,57 @@
 
 use crate::{eval::*, value::*};
 
+/// Source of a parameter value in a [`BindingPlan`].
+#[derive(Clone, Copy, Debug)]
+enum Binding {
+    /// Value of the argument with the given index.
+    Argument(usize),
+    /// Default value of the parameter.
+    Default,
+}
+
+/// Outcome of matching an `ArgumentValueList` with a `ParameterValueList`.
+///
+/// The outcome only depends on the ids and types of the arguments and on the ids, types and
+/// defaults of the parameters, so a plan can bind other arguments of the same shape without
+/// matching them again.
+#[derive(Debug, Default)]
+pub struct BindingPlan {
+    /// Index of each bound parameter with the source of its value.
+    bindings: Vec<(usize, Binding)>,
+}
+
+impl BindingPlan {
+    /// Bind `arguments` to `params` into a tuple.
+    pub fn bind(&self, arguments: &ArgumentValueList, params: &ParameterValueList) -> Tuple {
+        let mut result = Tuple::new_named(std::collections::HashMap::new(), arguments.src_ref());
+        self.bindings.iter().for_each(|(n, binding)| {
+            let (id, param) = params.get_index(*n).expect("bound parameter");
+            let value = match binding {
+                Binding::Argument(n) => arguments[*n].1.value.clone(),
+                Binding::Default => param.default_value.clone().expect("default value"),
+            };
+            result.insert(id.clone(), value);
+        });
+        result
+    }
+
+    /// Bind `arguments` to `params` into one or many tuples (see parameter multiplicity).
+    pub fn bind_multi(
+        &self,
+        arguments: &ArgumentValueList,
+        params: &ParameterValueList,
+    ) -> Vec<Tuple> {
+        ArgumentMatch::multiply(self.bind(arguments, params), params)
+    }
+}
+
 /// Matching of `ParameterList` with `ArgumentValueList` into Tuple
 #[derive(Default)]
 pub struct ArgumentMatch<'a> {
-    arguments: Vec<(&'a Identifier, &'a ArgumentValue)>,
-    params: Vec<(&'a Identifier, &'a ParameterValue)>,
-    result: Tuple,
+    arguments: Vec<(usize, &'a Identifier, &'a ArgumentValue)>,
+    params: Vec<(usize, &'a Identifier, &'a ParameterValue)>,
+    plan: BindingPlan,
 }
 
 impl<'a> ArgumentMatch<'a> {
@@ -21,9 +66,9 @@ impl<'a> ArgumentMatch<'a> {
         arguments: &'a ArgumentValueList,
         params: &'a ParameterValueList,
     ) -> EvalResult<Tuple> {
-        let am = Self::new(arguments, params)?;
-        am.check_exact_types(params)?;
-        Ok(am.result)
+        let result = Self::plan(arguments, params)?.bind(arguments, params);
+        Self::check_exact_types(&result, params)?;
+        Ok(result)
     }
 
     /// Match a `ParameterList` with an `ArgumentValueList` into an vector of tuples.
@@ -33,15 +78,32 @@ impl<'a> ArgumentMatch<'a> {
         arguments: &'a ArgumentValueList,
         params: &'a ParameterValueList,
     ) -> EvalResult<Vec<Tuple>> {
-        Ok(Self::new(arguments, params)?.multiply(params))
+        Ok(Self::plan(arguments, params)?.bind_multi(arguments, params))
+    }
+
+    /// Match a `ParameterList` with an `ArgumentValueList` into a plan to bind arguments of the
+    /// same shape.
+    pub fn plan(
+        arguments: &'a ArgumentValueList,
+        params: &'a ParameterValueList,
+    ) -> EvalResult<BindingPlan> {
+        Ok(Self::new(arguments, params)?.plan)
     }
 
     /// Create new instance and start matching.
     fn new(arguments: &'a ArgumentValueList, params: &'a ParameterValueList) -> EvalResult<Self> {
         let mut am = Self {
-            arguments: arguments.iter().map(|(id, v)| (id, v)).collect(),
-            params: params.iter().collect(),
-            result: Tuple::new_named(std::collections::HashMap::new(), arguments.src_ref()),
+            arguments: arguments
+                .iter()
+                .enumerate()
+                .map(|(n, (id, v))| (n, id, v))
+                .collect(),
+            params: params
+                .iter()
+                .enumerate()
+                .map(|(n, (id, param))| (n, id, param))
+                .collect(),
+            plan: BindingPlan::default(),
         };
 
         am.match_ids();
@@ -57,20 +119,22 @@ impl<'a> ArgumentMatch<'a> {
     fn match_ids(&mut self) {
         if !self.arguments.is_empty() {
             log::trace!("find id match for:\n{self:?}");
-            self.arguments.retain(|(id, arg)| {
+            self.arguments.retain(|(arg_n, id, arg)| {
                 let id = match (id.is_empty(), &arg.inline_id) {
                     (true, Some(id)) => id,
                     _ => id,
                 };
 
                 if !id.is_empty() {
-                    if let Some(n) = self.params.iter().position(|(i, _)| *i == id) {
-                        let (id, _) = self.params.swap_remove(n);
+                    if let Some(n) = self.params.iter().position(|(_, i, _)| *i == id) {
+                        let (param_n, id, _) = self.params.swap_remove(n);
                         log::trace!(
                             "{found} parameter by id: {id:?}",
                             found = crate::mark!(MATCH)
                         );
-                        self.result.insert((*id).clone(), arg.value.clone());
+                        self.plan
+                            .bindings
+                            .push((param_n, Binding::Argument(*arg_n)));
                         return false;
                     }
                 }
@@ -87,16 +151,16 @@ impl<'a> ArgumentMatch<'a> {
             } else {
                 log::trace!("find type matches for:\n{self:?}");
             }
-            self.arguments.retain(|(arg_id, arg)| {
+            self.arguments.retain(|(arg_n, arg_id, arg)| {
                 // filter params by type
                 let same_type: Vec<_> = self
                     .params
                     .iter()
                     .enumerate()
                     .filter(|(..)| arg_id.is_empty())
-                    .filter_map(|(n, (id, param))| {
+                    .filter_map(|(n, (param_n, id, param))| {
                         if [Type::Invalid, arg.ty(), arg.ty_inner()].contains(&param.ty()) {
-                            Some((n, id, param))
+                            Some((n, *param_n, id, param))
                         } else {
                             None
                         }
@@ -112,13 +176,15 @@ impl<'a> ArgumentMatch<'a> {
                     .iter()
                     .filter(|(.., param)| !exclude_defaults || param.default_value.is_none());
 
-                if let Some((n, id, _)) = same_type.next() {
+                if let Some((n, param_n, id, _)) = same_type.next() {
                     if same_type.next().is_none() {
                         log::trace!(
                             "{found} parameter by type: {id:?}",
                             found = crate::mark!(MATCH)
                         );
-                        self.result.insert((**id).clone(), arg.value.clone());
+                        self.plan
+                            .bindings
+                            .push((*param_n, Binding::Argument(*arg_n)));
                         self.params.swap_remove(*n);
                         return false;
                     } else {
@@ -137,7 +203,7 @@ impl<'a> ArgumentMatch<'a> {
         if !self.params.is_empty() {
             log::trace!("find default match for:\n{self:?}");
             // remove missing that can be found
-            self.params.retain(|(id, param)| {
+            self.params.retain(|(n, id, param)| {
                 // check for any default value
                 if let Some(def) = &param.default_value {
                     // paranoia check if type is compatible
@@ -146,7 +212,7 @@ impl<'a> ArgumentMatch<'a> {
                             "{found} argument by default: {id:?} = {def}",
                             found = crate::mark!(MATCH)
                         );
-                        self.result.insert((*id).clone(), def.clone());
+                        self.plan.bindings.push((*n, Binding::Default));
                         return false;
                     }
                 }
@@ -159,12 +225,15 @@ impl<'a> ArgumentMatch<'a> {
     fn check_missing(&self) -> EvalResult<()> {
         if !self.params.is_empty() {
             let mut missing: IdentifierList =
-                self.params.iter().map(|(id, _)| (*id).clone()).collect();
+                self.params.iter().map(|(_, id, _)| (*id).clone()).collect();
             missing.sort();
             Err(EvalError::MissingArguments(missing))
         } else if !self.arguments.is_empty() {
-            let mut too_many: IdentifierList =
-                self.arguments.iter().map(|(id, _)| (*id).clone()).collect();
+            let mut too_many: IdentifierList = self
+                .arguments
+                .iter()
+                .map(|(_, id, _)| (*id).clone())
+                .collect();
             too_many.sort();
             Err(EvalError::TooManyArguments(too_many))
         } else {
@@ -172,8 +241,8 @@ impl<'a> ArgumentMatch<'a> {
         }
     }
 
-    fn check_exact_types(&self, params: &ParameterValueList) -> EvalResult<()> {
-        let multipliers = Self::multipliers(&self.result, params);
+    fn check_exact_types(result: &Tuple, params: &ParameterValueList) -> EvalResult<()> {
+        let multipliers = Self::multipliers(result, params);
         if multipliers.is_empty() {
             return Ok(());
         }
@@ -183,14 +252,14 @@ impl<'a> ArgumentMatch<'a> {
     /// Process parameter multiplicity
     ///
     /// Return one or many tuples.
-    fn multiply(&self, params: &ParameterValueList) -> Vec<Tuple> {
-        let ids: IdentifierList = Self::multipliers(&self.result, params);
+    fn multiply(tuple: Tuple, params: &ParameterValueList) -> Vec<Tuple> {
+        let ids: IdentifierList = Self::multipliers(&tuple, params);
         if !ids.is_empty() {
             let mut result = Vec::new();
-            self.result.multiplicity(ids, |t| result.push(t));
+            tuple.multiplicity(ids, |t| result.push(t));
             result
         } else {
-            vec![self.result.clone()]
+            vec![tuple]
         }
     }
 
@@ -221,13 +290,13 @@ impl std::fmt::Debug for ArgumentMatch<'_> {
             args = self
                 .arguments
                 .iter()
-                .map(|(id, arg)| format!("{id:?} = {arg:?}"))
+                .map(|(_, id, arg)| format!("{id:?} = {arg:?}"))
                 .collect::<Vec<_>>()
                 .join(", "),
             params = self
                 .params
                 .iter()
-                .map(|(id, param)| format!("{id:?} = {param:?}"))
+                .map(|(_, id, param)| format!("{id:?} = {param:?}"))
                 .collect::<Vec<_>>()
                 .join(", "),
         )
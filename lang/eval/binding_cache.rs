@@ -0,0 +1,144 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Cache of evaluated parameter lists and binding plans.
+
+use crate::{eval::*, rc::*, syntax::*, ty::*, value::*};
+
+/// Cached outcome of matching arguments of a certain shape with a parameter list.
+enum Outcome {
+    /// The arguments match.
+    Match(Rc<BindingPlan>),
+    /// Some parameters got no value.
+    MissingArguments(IdentifierList),
+    /// Some arguments do not match any parameter.
+    TooManyArguments(IdentifierList),
+}
+
+/// Everything the matching outcome depends on: the parameter list, the ids, types and default
+/// types of its evaluated parameters and the ids, inline ids and types of the arguments.
+#[derive(PartialEq, Eq, Hash)]
+struct Shape {
+    parameters: usize,
+    params: Vec<(Identifier, Type, Option<Type>)>,
+    arguments: Vec<(Identifier, Option<Identifier>, Type)>,
+}
+
+/// Cache of the parameter lists and matching outcomes of workbench, initializer and function calls.
+///
+/// Parameter lists are identified by the address of their syntax node, which stays put as
+/// long as the sources of an [`EvalContext`] are alive.
+#[derive(Default)]
+pub(super) struct BindingCache {
+    /// Evaluated parameter lists with constant default values.
+    parameters: rustc_hash::FxHashMap<usize, Rc<ParameterValueList>>,
+    /// Matching outcomes by parameter list and argument shape.
+    outcomes: rustc_hash::FxHashMap<Shape, Outcome>,
+}
+
+impl BindingCache {
+    /// Get an evaluated parameter list.
+    pub(super) fn parameters(&self, parameters: &ParameterList) -> Option<Rc<ParameterValueList>> {
+        self.parameters.get(&Self::address(parameters)).cloned()
+    }
+
+    /// Store an evaluated parameter list, which must have constant default values only.
+    pub(super) fn insert_parameters(
+        &mut self,
+        parameters: &ParameterList,
+        values: Rc<ParameterValueList>,
+    ) {
+        self.parameters.insert(Self::address(parameters), values);
+    }
+
+    /// Match `arguments` with the evaluated `params` of `parameters` using the cached outcome
+    /// for arguments of the same shape.
+    pub(super) fn match_arguments(
+        &mut self,
+        parameters: &ParameterList,
+        params: &ParameterValueList,
+        arguments: &ArgumentValueList,
+    ) -> EvalResult<Vec<Tuple>> {
+        let shape = Self::shape(parameters, params, arguments);
+        let outcome = match self.outcomes.entry(shape) {
+            std::collections::hash_map::Entry::Occupied(entry) => entry.into_mut(),
+            std::collections::hash_map::Entry::Vacant(entry) => {
+                entry.insert(match ArgumentMatch::plan(arguments, params) {
+                    Ok(plan) => Outcome::Match(Rc::new(plan)),
+                    Err(EvalError::MissingArguments(ids)) => Outcome::MissingArguments(ids),
+                    Err(EvalError::TooManyArguments(ids)) => Outcome::TooManyArguments(ids),
+                    Err(err) => return Err(err),
+                })
+            }
+        };
+
+        match outcome {
+            Outcome::Match(plan) => Ok(plan.bind_multi(arguments, params)),
+            Outcome::MissingArguments(ids) => Err(EvalError::MissingArguments(ids.clone())),
+            Outcome::TooManyArguments(ids) => Err(EvalError::TooManyArguments(ids.clone())),
+        }
+    }
+
+    /// Shape of a call which decides the matching outcome.
+    ///
+    /// The shape is compared as a whole, so calls of different shapes never share an outcome.
+    fn shape(
+        parameters: &ParameterList,
+        params: &ParameterValueList,
+        arguments: &ArgumentValueList,
+    ) -> Shape {
+        Shape {
+            parameters: Self::address(parameters),
+            params: params
+                .iter()
+                .map(|(id, param)| {
+                    (
+                        id.clone(),
+                        param.ty(),
+                        param.default_value.as_ref().map(Ty::ty),
+                    )
+                })
+                .collect(),
+            arguments: arguments
+                .iter()
+                .map(|(id, arg)| (id.clone(), arg.inline_id.clone(), arg.value.ty()))
+                .collect(),
+        }
+    }
+
+    fn address(parameters: &ParameterList) -> usize {
+        std::ptr::from_ref(parameters) as usize
+    }
+}
+
+#[test]
+fn cached_binding() {
+    let parameters = ParameterList::default();
+    let params: ParameterValueList = [
+        crate::parameter!(a: Scalar),
+        crate::parameter!(b: Length = 4.0),
+    ]
+    .into_iter()
+    .collect();
+
+    let mut cache = BindingCache::default();
+    let mut bind = |a: f64| {
+        let arguments: ArgumentValueList = [crate::argument!(Scalar = a)].into_iter().collect();
+        cache.match_arguments(&parameters, &params, &arguments)
+    };
+    assert_eq!(
+        bind(1.0).expect("match"),
+        [crate::tuple!("(a=1.0, b=4.0mm)")]
+    );
+    assert_eq!(
+        bind(2.0).expect("match"),
+        [crate::tuple!("(a=2.0, b=4.0mm)")]
+    );
+    assert_eq!(cache.outcomes.len(), 1);
+
+    let arguments: ArgumentValueList = [crate::argument!(c: Scalar = 1.0)].into_iter().collect();
+    assert!(matches!(
+        cache.match_arguments(&parameters, &params, &arguments),
+        Err(EvalError::MissingArguments(_))
+    ));
+}
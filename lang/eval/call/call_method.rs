@@ -29,21 +29,18 @@ impl CallMethod for Array {
     ) -> EvalResult<Value> {
         match id.single_identifier().expect("Single id").id().as_str() {
             "count" => Ok(Value::Integer(self.len() as i64)),
-            "all_equal" => {
-                let is_equal = match self.first() {
-                    Some(first) => self[1..].iter().all(|x| x == first),
-                    None => true,
-                };
-                Ok(Value::Bool(is_equal))
-            }
-            "is_ascending" => {
-                let is_ascending = self.as_slice().windows(2).all(|w| w[0] <= w[1]);
-                Ok(Value::Bool(is_ascending))
-            }
-            "is_descending" => {
-                let is_descending = self.as_slice().windows(2).all(|w| w[0] >= w[1]);
-                Ok(Value::Bool(is_descending))
-            }
+            "all_equal" => Ok(Value::Bool(self.all_equal())),
+            "is_ascending" => Ok(Value::Bool(self.is_ascending())),
+            "is_descending" => Ok(Value::Bool(self.is_descending())),
+            "sum" => match self.sum() {
+                Ok(value) => Ok(value),
+                Err(err) => {
+                    context.error(id, err)?;
+                    Ok(Value::None)
+                }
+            },
+            "min" => Ok(self.min()),
+            "max" => Ok(self.max()),
             _ => {
                 context.error(id, EvalError::UnknownMethod(id.clone()))?;
                 Ok(Value::None)
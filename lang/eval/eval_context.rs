@@ -23,6 +23,12 @@ pub struct EvalContext {
     importers: ImporterRegistry,
     /// Diagnostics handler.
     diag: DiagHandler,
+    /// Overridden top-level values of the root source file.
+    overrides: std::collections::HashMap<Identifier, Value>,
+    /// Ids of the overrides which have been assigned.
+    overridden: std::collections::HashSet<Identifier>,
+    /// Evaluated parameter lists and binding plans of calls.
+    bindings: BindingCache,
 }
 
 impl EvalContext {
@@ -68,6 +74,41 @@ impl EvalContext {
         ))
     }
 
+    /// Override top-level values of the root source file.
+    ///
+    /// An assignment to one of the given ids in the root source file gets the given value instead
+    /// of evaluating its expression (e.g. to evaluate variants of a design in a parameter sweep).
+    pub fn set_overrides(&mut self, overrides: Tuple) {
+        self.overrides = overrides.named;
+        self.overridden.clear();
+    }
+
+    /// Ids of overrides which did not match any top-level assignment during evaluation.
+    pub fn unused_overrides(&self) -> IdentifierList {
+        self.overrides
+            .keys()
+            .filter(|id| !self.overridden.contains(id))
+            .cloned()
+            .collect()
+    }
+
+    /// Return the overridden value of an assignment to `id` if it is a top-level assignment.
+    pub(super) fn override_value(&mut self, id: &Identifier) -> Option<Value> {
+        if self.overrides.is_empty() {
+            return None;
+        }
+        match self.stack.current_frame() {
+            Some(StackFrame::Source(source_id, _)) if *source_id == self.sources.root().id() => {
+                let value = self.overrides.get(id).cloned();
+                if value.is_some() {
+                    self.overridden.insert(id.clone());
+                }
+                value
+            }
+            _ => None,
+        }
+    }
+
     /// Access captured output.
     pub fn output(&self) -> Option<String> {
         self.output.output()
@@ -84,6 +125,7 @@ impl EvalContext {
             log::error!("Aborting evaluation because of prior resolve errors!");
             return Err(EvalError::ResolveFailed);
         }
+        let _span = crate::trace_span!("eval", "eval {}", self.sources.root().filename_as_str());
         let model: Model = self.sources.root().eval(self)?;
         log::trace!("Post-evaluation context:\n{self:?}");
         log::trace!("Evaluated Model:\n{}", FormatTree(&model));
@@ -106,11 +148,52 @@ impl EvalContext {
         result
     }
 
+    /// Match `arguments` with the `parameters` of a workbench, an initializer or a function.
+    ///
+    /// Returns one tuple for each parameter multiplicity match.
+    /// Parameter lists with constant default values are evaluated only once and the outcome of
+    /// the matching is reused for arguments of the same shape.
+    pub(super) fn match_arguments(
+        &mut self,
+        parameters: &ParameterList,
+        arguments: &ArgumentValueList,
+    ) -> EvalResult<Vec<Tuple>> {
+        let params = match self.bindings.parameters(parameters) {
+            Some(params) => params,
+            None => {
+                let error_count = self.error_count();
+                let params: ParameterValueList = parameters.eval(self)?;
+                let params = Rc::new(params);
+                if parameters.is_constant() && self.error_count() == error_count {
+                    self.bindings.insert_parameters(parameters, params.clone());
+                }
+                params
+            }
+        };
+        self.bindings
+            .match_arguments(parameters, &params, arguments)
+    }
+
     /// All registered exporters.
     pub fn exporters(&self) -> &ExporterRegistry {
         &self.exporters
     }
 
+    /// Source file cache.
+    pub fn sources(&self) -> &Sources {
+        &self.sources
+    }
+
+    /// Resolved symbol table.
+    pub fn symbol_table(&self) -> &SymbolTable {
+        &self.symbol_table
+    }
+
+    /// Diagnostics of resolve and evaluation.
+    pub fn diag_handler(&self) -> &DiagHandler {
+        &self.diag
+    }
+
     /// Return search paths of this context.
     pub fn search_paths(&self) -> &Vec<std::path::PathBuf> {
         self.sources.search_paths()
@@ -359,6 +442,9 @@ impl Default for EvalContext {
             exporters: Default::default(),
             importers: Default::default(),
             diag: Default::default(),
+            overrides: Default::default(),
+            overridden: Default::default(),
+            bindings: Default::default(),
         }
     }
 }
@@ -482,6 +568,10 @@ impl Diag for EvalContext {
         self.diag.pretty_print(f, self)
     }
 
+    fn fmt_diagnosis_json(&self, f: &mut dyn std::fmt::Write) -> std::fmt::Result {
+        self.diag.write_json(f, self)
+    }
+
     fn warning_count(&self) -> u32 {
         self.diag.warning_count()
     }
@@ -260,6 +260,10 @@ pub enum EvalError {
     /// Evaluation aborted because of prior resolve errors
     #[error("Evaluation aborted because of prior resolve errors!")]
     ResolveFailed,
+
+    /// Invalid values to override top-level values.
+    #[error("Invalid overrides: {0}")]
+    InvalidOverrides(String),
 }
 
 /// Result type of any evaluation.
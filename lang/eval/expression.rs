@@ -47,10 +47,9 @@ impl Eval for RangeExpression {
     fn eval(&self, context: &mut EvalContext) -> EvalResult<Value> {
         Ok(
             match (self.first.eval(context)?, self.last.eval(context)?) {
-                (Value::Integer(first), Value::Integer(last)) => Value::Array(Array::from_values(
-                    (first..last + 1).map(Value::Integer).collect(),
-                    Type::Integer,
-                )),
+                (Value::Integer(first), Value::Integer(last)) => {
+                    Value::Array(Array::range(first, last))
+                }
                 (_, _) => Value::None,
             },
         )
@@ -227,7 +226,7 @@ impl Eval for Expression {
                         let index = index as usize;
                         if index < list.len() {
                             match list.get(index) {
-                                Some(value) => Ok(value.clone()),
+                                Some(value) => Ok(value),
                                 None => Err(EvalError::ListIndexOutOfBounds {
                                     index,
                                     len: list.len(),
@@ -39,7 +39,7 @@ impl Eval for FunctionDefinition {
 
 impl CallTrait for FunctionDefinition {
     fn call(&self, args: &ArgumentValueList, context: &mut EvalContext) -> EvalResult<Value> {
-        match ArgumentMatch::find_multi_match(args, &self.signature.parameters.eval(context)?) {
+        match context.match_arguments(&self.signature.parameters, args) {
             Ok(matches) => {
                 let mut result: Vec<Value> = Vec::new();
                 for args in matches {
@@ -55,10 +55,11 @@ impl CallTrait for FunctionDefinition {
                 }
             }
 
-            Err(err) => {
+            Err(err @ (EvalError::MissingArguments(_) | EvalError::TooManyArguments(_))) => {
                 context.error(args, err)?;
                 Ok(Value::None)
             }
+            Err(err) => Err(err),
         }
     }
 }
@@ -29,6 +29,7 @@
 
 mod argument_match;
 mod attribute;
+mod binding_cache;
 mod body;
 mod call;
 mod eval_context;
@@ -43,6 +44,7 @@ mod locals;
 mod module_definition;
 mod output;
 mod parameter;
+mod snapshot;
 mod source_file;
 mod sources;
 mod statements;
@@ -55,7 +57,9 @@ pub use call::*;
 pub use eval_context::*;
 pub use eval_error::*;
 pub use output::*;
+pub use snapshot::*;
 
+use binding_cache::*;
 use grant::*;
 use locals::*;
 use statements::*;
@@ -0,0 +1,130 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Snapshot of a loaded design for repeated evaluation.
+
+use crate::{builtin::*, diag::*, eval::*, parse::*, parser::*, rc::*};
+
+/// Loaded state of a design which can be forked into many evaluation contexts.
+///
+/// A fork shares all parsed source files with the snapshot and only symbolizes and resolves them
+/// again, because symbols are altered during evaluation.
+/// Parameter sweeps use forks to evaluate variants of a design without loading anything again.
+pub struct EvalSnapshot {
+    /// Parsed source files.
+    sources: Sources,
+    /// Builds the builtin library for each fork.
+    builtin: Option<fn() -> Symbol>,
+}
+
+impl EvalSnapshot {
+    /// Load a root file and all library files from `search_paths`.
+    pub fn load(
+        root: Rc<SourceFile>,
+        search_paths: &[impl AsRef<std::path::Path>],
+        builtin: Option<fn() -> Symbol>,
+    ) -> EvalResult<Self> {
+        Ok(Self {
+            sources: Sources::load(root, search_paths)?,
+            builtin,
+        })
+    }
+
+    /// Take a snapshot of the source files of an existing context.
+    pub fn from_context(context: &EvalContext, builtin: Option<fn() -> Symbol>) -> Self {
+        let sources = context.sources();
+        Self {
+            sources: sources.with_root(sources.root()),
+            builtin,
+        }
+    }
+
+    /// Root source file of the design.
+    pub fn root(&self) -> Rc<SourceFile> {
+        self.sources.root()
+    }
+
+    /// Create a resolved context in which the top-level values given in `overrides` are replaced.
+    pub fn fork(
+        &self,
+        overrides: Tuple,
+        output: Box<dyn Output>,
+        exporters: ExporterRegistry,
+        importers: ImporterRegistry,
+    ) -> EvalResult<EvalContext> {
+        let resolve_context = ResolveContext::recreate(
+            &self.sources,
+            self.sources.root(),
+            self.builtin.map(|builtin| builtin()),
+            DiagHandler::default(),
+        )?;
+        let mut context = EvalContext::new(resolve_context, output, exporters, importers);
+        context.set_overrides(overrides);
+        Ok(context)
+    }
+}
+
+impl Tuple {
+    /// Evaluate a tuple from µcad code like `(z = [20..120], m = 1.5mm)`.
+    ///
+    /// The code must not refer to any symbols.
+    pub fn from_code(code: &str) -> EvalResult<Self> {
+        let expression = Parser::parse_rule::<TupleExpression>(Rule::tuple_expression, code, 0)?;
+        let mut context = EvalContext::default();
+        let value: Value = expression.eval(&mut context)?;
+        if context.has_errors() {
+            return Err(EvalError::InvalidOverrides(context.diagnosis()));
+        }
+        match value {
+            Value::Tuple(tuple) => Ok(*tuple),
+            value => Err(EvalError::ExpectedType {
+                expected: Type::Tuple(Default::default()),
+                found: value.ty(),
+            }),
+        }
+    }
+
+    /// Expand all array items into one tuple per combination of their items.
+    pub fn variants(&self) -> Vec<Tuple> {
+        let ids: IdentifierList = self
+            .named
+            .iter()
+            .filter(|(_, value)| matches!(value, Value::Array(_)))
+            .map(|(id, _)| id.clone())
+            .collect();
+        let mut variants = Vec::new();
+        self.multiplicity(ids, |variant| variants.push(variant));
+        variants
+    }
+}
+
+#[test]
+fn fork_with_overrides() {
+    let root = SourceFile::load_from_str("sweep", "const Z = 20;\nconst WIDTH = Z * 2mm;")
+        .expect("test code");
+    let snapshot = EvalSnapshot::load(root, &[] as &[std::path::PathBuf], None).expect("snapshot");
+
+    let overrides = Tuple::from_code("(Z = [20, 30], unknown = 1)").expect("tuple");
+    let mut widths = Vec::new();
+    overrides.variants().into_iter().for_each(|variant| {
+        let mut context = snapshot
+            .fork(
+                variant,
+                Capture::new(),
+                Default::default(),
+                Default::default(),
+            )
+            .expect("fork");
+        context.eval().expect("eval");
+        assert!(!context.has_errors(), "{}", context.diagnosis());
+        assert_eq!(context.unused_overrides().to_string(), "unknown");
+
+        let name: QualifiedName = ["sweep".into(), "WIDTH".into()].into_iter().collect();
+        let width = context.symbol_table().lookup(&name).expect("WIDTH");
+        widths.push(width.with_def(|def| match def {
+            SymbolDefinition::Constant(.., value) => value.to_string(),
+            _ => panic!("constant expected"),
+        }));
+    });
+    assert_eq!(widths, ["40mm", "60mm"]);
+}
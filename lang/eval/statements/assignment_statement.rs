@@ -28,8 +28,11 @@ impl Eval<()> for AssignmentStatement {
 
         let assignment = &self.assignment;
 
-        // evaluate assignment expression
-        let new_value: Value = assignment.expression.eval(context)?;
+        // evaluate assignment expression unless the value has been overridden
+        let new_value: Value = match context.override_value(&assignment.id) {
+            Some(value) => value,
+            None => assignment.expression.eval(context)?,
+        };
         if let Err(err) = assignment.type_check(new_value.ty()) {
             context.error(self, err)?;
             return Ok(());
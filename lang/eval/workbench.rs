@@ -136,14 +136,13 @@ impl WorkbenchDefinition {
             id = self.id,
             kind = self.kind
         );
+        let _span = crate::trace_span!("eval", "{kind} {id}", kind = self.kind, id = self.id);
 
         // prepare models
         let mut models = Models::default();
-        // prepare building plan
-        let plan = self.plan.eval(context)?;
 
         // try to match arguments with the building plan
-        match ArgumentMatch::find_multi_match(arguments, &plan) {
+        match context.match_arguments(&self.plan, arguments) {
             Ok(matches) => {
                 log::debug!(
                     "Building plan matches: {}",
@@ -163,7 +162,7 @@ impl WorkbenchDefinition {
                     )?);
                 }
             }
-            _ => {
+            Err(EvalError::MissingArguments(_) | EvalError::TooManyArguments(_)) => {
                 log::trace!("Building plan did not match, finding initializer");
 
                 // at the end: check if initialization was successful
@@ -171,34 +170,38 @@ impl WorkbenchDefinition {
 
                 // find an initializer that matches the arguments
                 for init in self.inits() {
-                    if let Ok(matches) =
-                        ArgumentMatch::find_multi_match(arguments, &init.parameters.eval(context)?)
-                    {
-                        log::debug!(
-                            "Initializer matches: {}",
-                            matches
-                                .iter()
-                                .map(|m| format!("{m:?}"))
-                                .collect::<Vec<_>>()
-                                .join("\n")
-                        );
-                        // evaluate models for all multiplicity matches
-                        for arguments in matches {
-                            models.push(self.eval_to_model(
-                                call_src_ref.clone(),
-                                Creator::new(symbol.clone(), arguments),
-                                Some(init),
-                                context,
-                            )?);
+                    let matches = match context.match_arguments(&init.parameters, arguments) {
+                        Ok(matches) => matches,
+                        Err(EvalError::MissingArguments(_) | EvalError::TooManyArguments(_)) => {
+                            continue;
                         }
-                        initialized = true;
-                        break;
+                        Err(err) => return Err(err),
+                    };
+                    log::debug!(
+                        "Initializer matches: {}",
+                        matches
+                            .iter()
+                            .map(|m| format!("{m:?}"))
+                            .collect::<Vec<_>>()
+                            .join("\n")
+                    );
+                    // evaluate models for all multiplicity matches
+                    for arguments in matches {
+                        models.push(self.eval_to_model(
+                            call_src_ref.clone(),
+                            Creator::new(symbol.clone(), arguments),
+                            Some(init),
+                            context,
+                        )?);
                     }
+                    initialized = true;
+                    break;
                 }
                 if !initialized {
                     context.error(arguments, EvalError::NoInitializationFound(self.id.clone()))?;
                 }
             }
+            Err(err) => return Err(err),
         }
 
         Ok(models.to_multiplicity(self.src_ref.clone()))
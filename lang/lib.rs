@@ -9,6 +9,7 @@
 //! - Resolve parsed sources in [`resolve`]
 //! - Evaluate resolved sources in [`eval`]
 //! - Diagnose any evaluation errors in [`diag`]
+//! - Measure processing stages with [`trace`] spans
 //!
 //! The grammar of µcad can be found [here](../../../lang/grammar.pest).
 //!
@@ -26,6 +27,7 @@ pub mod render;
 pub mod resolve;
 pub mod src_ref;
 pub mod syntax;
+pub mod trace;
 pub mod tree_display;
 pub mod ty;
 pub mod value;
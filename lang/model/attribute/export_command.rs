@@ -31,19 +31,120 @@ impl ExportCommand {
 
     /// Render the model and export.
     pub fn render_and_export(&self, model: &Model) -> Result<Value, ExportError> {
-        let render_cache = RcMut::new(RenderCache::default());
-        let mut render_context =
+        self.render_and_export_with_cache(model, RcMut::new(RenderCache::default()))
+    }
+
+    /// Render the model with the given render cache and export.
+    pub fn render_and_export_with_cache(
+        &self,
+        model: &Model,
+        render_cache: RcMut<RenderCache>,
+    ) -> Result<Value, ExportError> {
+        let _span = self.span();
+        let mut render_context = self.prerender(model, render_cache)?;
+        self.exporter
+            .render_and_export(model, &mut render_context, &self.filename)
+    }
+
+    /// Render the model with the given render cache and export, unless the output is up to date.
+    ///
+    /// The output is up to date if it exists and its sidecar file (see [`Self::stamp_filename()`])
+    /// holds the stamp of the pre-rendered model (see [`Self::stamp()`]).
+    /// The sidecar file is removed before an export and written after a successful export, so
+    /// a failed export which left a partial output behind is not taken as up to date.
+    ///
+    /// Returns `None` if the export has been skipped.
+    pub fn render_and_export_if_changed(
+        &self,
+        model: &Model,
+        render_cache: RcMut<RenderCache>,
+    ) -> Result<Option<Value>, ExportError> {
+        let _span = self.span();
+        let mut render_context = self.prerender(model, render_cache)?;
+
+        let stamp = self.stamp(model);
+        let stamp_filename = self.stamp_filename();
+        if self.filename.exists()
+            && std::fs::read_to_string(&stamp_filename).is_ok_and(|old| old == stamp)
+        {
+            log::info!("{} is up to date", self.filename.display());
+            return Ok(None);
+        }
+
+        match std::fs::remove_file(&stamp_filename) {
+            Err(err) if err.kind() != std::io::ErrorKind::NotFound => return Err(err.into()),
+            _ => (),
+        }
+        let value = self
+            .exporter
+            .render_and_export(model, &mut render_context, &self.filename)?;
+        std::fs::write(stamp_filename, stamp)?;
+        Ok(Some(value))
+    }
+
+    /// Stamp which identifies the output of a pre-rendered `model`.
+    ///
+    /// The model hash includes the elements and resolutions of all models of the tree.
+    /// Attributes are hashed separately, because exporters read them (e.g. `color` or
+    /// `svg = (style = ...)`) but they do not change the geometry.
+    /// The µcad version is included because it may change hashes and exporters.
+    pub fn stamp(&self, model: &Model) -> String {
+        use crate::render::ComputedHash;
+        use std::hash::{Hash, Hasher};
+
+        fn hash_attributes(model: &Model, hasher: &mut impl Hasher) {
+            let model_ = model.borrow();
+            model_
+                .attributes
+                .iter()
+                .for_each(|attribute| attribute.to_string().hash(hasher));
+            model_.children.len().hash(hasher);
+            model_
+                .children
+                .iter()
+                .for_each(|child| hash_attributes(child, hasher));
+        }
+
+        let mut hasher = rustc_hash::FxHasher::default();
+        hash_attributes(model, &mut hasher);
+        format!(
+            "{hash:016x} {attributes:016x} {id} {resolution} {version}\n",
+            hash = model.computed_hash(),
+            attributes = hasher.finish(),
+            id = self.exporter.id(),
+            resolution = self.resolution,
+            version = env!("CARGO_PKG_VERSION")
+        )
+    }
+
+    /// Sidecar file of the output which holds the stamp of the last export, e.g. `gear.stl.hash`.
+    pub fn stamp_filename(&self) -> std::path::PathBuf {
+        let mut filename = self.filename.clone().into_os_string();
+        filename.push(".hash");
+        filename.into()
+    }
+
+    fn span(&self) -> Option<crate::trace::Span> {
+        crate::trace_span!(
+            "export",
+            "{id} {filename}",
+            id = self.exporter.id(),
+            filename = self.filename.display()
+        )
+    }
+
+    fn prerender(
+        &self,
+        model: &Model,
+        render_cache: RcMut<RenderCache>,
+    ) -> Result<RenderContext, ExportError> {
+        let render_context =
             RenderContext::init(model, self.resolution.clone(), Some(render_cache))?;
         log::trace!(
             "Pre-rendered model:\n{}",
             crate::tree_display::FormatTree(model)
         );
-
-        use crate::render::RenderWithContext;
-        self.exporter.export(
-            &model.render_with_context(&mut render_context)?,
-            &self.filename,
-        )
+        Ok(render_context)
     }
 }
 
@@ -3,7 +3,7 @@
 
 //! Resolution attribute.
 
-use microcad_core::Scalar;
+use microcad_core::{Mat4, RenderResolution, Scalar};
 
 use crate::{ty::QuantityType, value::*};
 
@@ -23,6 +23,33 @@ impl Default for ResolutionAttribute {
     }
 }
 
+impl ResolutionAttribute {
+    /// Return the render resolution of a model which carries this attribute.
+    ///
+    /// - `inherited`: Resolution inherited from the parent (in model coordinates).
+    /// - `world_matrix`: World matrix of the model.
+    ///
+    /// A linear resolution is given in world coordinates and will be converted into model
+    /// coordinates.
+    /// A relative resolution refines (`> 100%`) or coarsens (`< 100%`) the inherited one.
+    /// Values which are not positive are ignored.
+    pub fn render_resolution(
+        &self,
+        inherited: RenderResolution,
+        world_matrix: Mat4,
+    ) -> RenderResolution {
+        match *self {
+            ResolutionAttribute::Linear(linear) if linear > 0.0 => {
+                RenderResolution::new(linear) * world_matrix
+            }
+            ResolutionAttribute::Relative(relative) if relative > 0.0 => {
+                RenderResolution::new(inherited.linear / relative)
+            }
+            _ => inherited,
+        }
+    }
+}
+
 impl From<ResolutionAttribute> for Value {
     fn from(resolution_attribute: ResolutionAttribute) -> Self {
         match resolution_attribute {
@@ -61,7 +88,39 @@ impl std::fmt::Display for ResolutionAttribute {
     fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
         match self {
             ResolutionAttribute::Linear(linear) => write!(f, "Linear({linear} mm)"),
-            ResolutionAttribute::Relative(relative) => write!(f, "Relative({relative}%)"),
+            ResolutionAttribute::Relative(relative) => {
+                write!(f, "Relative({}%)", relative * 100.0)
+            }
         }
     }
 }
+
+#[test]
+fn resolution_attribute_render_resolution() {
+    use cgmath::SquareMatrix;
+
+    let inherited = RenderResolution::new(0.1);
+    let scaled = Mat4::from_scale(2.0);
+
+    let relative = ResolutionAttribute::Relative(2.0);
+    assert_eq!(
+        relative.render_resolution(inherited.clone(), scaled).linear,
+        0.05
+    );
+
+    // linear resolution is given in world coordinates
+    let linear = ResolutionAttribute::Linear(1.0);
+    assert_eq!(
+        linear.render_resolution(inherited.clone(), scaled).linear,
+        0.5
+    );
+    assert_eq!(
+        linear
+            .render_resolution(inherited.clone(), Mat4::identity())
+            .linear,
+        1.0
+    );
+
+    let invalid = ResolutionAttribute::Relative(0.0);
+    assert_eq!(invalid.render_resolution(inherited, scaled).linear, 0.1);
+}
@@ -80,6 +80,13 @@ where
         self.vec.iter()
     }
 
+    /// get mutable iterator over values in original order
+    ///
+    /// Values must not be changed in a way which changes their key.
+    pub fn iter_mut(&mut self) -> std::slice::IterMut<'_, V> {
+        self.vec.iter_mut()
+    }
+
     /// return number of stored values
     pub fn len(&self) -> usize {
         self.vec.len()
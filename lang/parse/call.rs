@@ -89,7 +89,7 @@ fn call() {
             .expect("test error")
             .next()
             .expect("test error"),
-        0,
+        crate::src_ref::FileId::from_hash(0),
     );
 
     let call = Call::parse(pair).expect("test error");
@@ -121,10 +121,7 @@ impl Parse for Expression {
 
         PRATT_PARSER
             .map_primary(|primary| {
-                match (
-                    Pair::new(primary.clone(), pair.source_hash()),
-                    primary.as_rule(),
-                ) {
+                match (Pair::new(primary.clone(), pair.file()), primary.as_rule()) {
                     (primary, Rule::literal) => Ok(Self::Literal(Literal::parse(primary)?)),
                     (primary, Rule::expression) => Ok(Self::parse(primary)?),
                     (primary, Rule::array_expression) => {
@@ -194,8 +191,8 @@ impl Parse for Expression {
                     src_ref: pair.clone().into(),
                 })
             })
-            .map_postfix(|lhs, op| {
-                match (Pair::new(op.clone(), pair.source_hash()), op.as_rule()) {
+            .map_postfix(
+                |lhs, op| match (Pair::new(op.clone(), pair.file()), op.as_rule()) {
                     (op, Rule::array_element_access) => Ok(Self::ArrayElementAccess(
                         Box::new(lhs?),
                         Box::new(Self::parse(op)?),
@@ -228,8 +225,8 @@ impl Parse for Expression {
                     rule => {
                         unreachable!("Expr::parse expected postfix operation, found {:?}", rule)
                     }
-                }
-            })
+                },
+            )
             .parse(
                 pair.pest_pair()
                     .clone()
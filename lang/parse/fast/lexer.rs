@@ -0,0 +1,276 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Lexer of the fast parser
+
+use super::*;
+
+/// Kind of a token.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub(super) enum TokenKind {
+    /// Identifier or keyword: `foo`, `use`.
+    Identifier,
+    /// Integer without fraction: `42`.
+    Integer,
+    /// Number with fraction and optional exponent: `4.2`, `.5`, `1.0e3`.
+    Number,
+    /// Unit which directly follows a number or an array: `mm`, `°`.
+    Unit,
+    /// Punctuation or operator: `::`, `+`, `(`.
+    Punct(&'static str),
+    /// End of input.
+    Eof,
+}
+
+/// Single token with position information.
+#[derive(Debug, Clone, Copy)]
+pub(super) struct Token {
+    /// Kind of token.
+    pub kind: TokenKind,
+    /// Byte offset of the first character.
+    pub start: usize,
+    /// Byte offset behind the last character.
+    pub end: usize,
+    /// Whitespace precedes this token.
+    pub ws: bool,
+    /// Whitespace or a comment precedes this token.
+    pub gap: bool,
+}
+
+/// Punctuation sorted by length, so that the longest match wins.
+const PUNCTUATION: &[&str] = &[
+    "::", "..", "==", "!=", "<=", ">=", "->", "+", "-", "*", "/", "|", "&", "^", ">", "<", "=",
+    "~", "!", "(", ")", "[", "]", "{", "}", ",", ";", ":", ".", "@", "#",
+];
+
+/// Lexer which splits µcad source code into tokens.
+pub(super) struct Lexer<'a> {
+    src: &'a str,
+    bytes: &'a [u8],
+    pos: usize,
+}
+
+impl<'a> Lexer<'a> {
+    /// Split `src` into tokens, the last token is always [`TokenKind::Eof`].
+    pub fn tokenize(src: &'a str) -> FastParseResult<Vec<Token>> {
+        let mut lexer = Self {
+            src,
+            bytes: src.as_bytes(),
+            pos: 0,
+        };
+
+        // generated sources are dominated by short tokens
+        let mut tokens = Vec::with_capacity(src.len() / 3 + 1);
+        loop {
+            let (ws, gap) = lexer.skip_trivia()?;
+            let token = lexer.token(ws, gap)?;
+            tokens.push(token);
+
+            match token.kind {
+                TokenKind::Eof => return Ok(tokens),
+                // units are glued to numbers and arrays: `5mm`, `[1, 2]mm`
+                TokenKind::Integer | TokenKind::Number | TokenKind::Punct("]") => {
+                    let start = lexer.pos;
+                    if lexer.unit() {
+                        tokens.push(Token {
+                            kind: TokenKind::Unit,
+                            start,
+                            end: lexer.pos,
+                            ws: false,
+                            gap: false,
+                        });
+                    }
+                }
+                _ => (),
+            }
+        }
+    }
+
+    fn peek(&self, n: usize) -> Option<u8> {
+        self.bytes.get(self.pos + n).copied()
+    }
+
+    /// Advance one byte.
+    fn bump(&mut self) {
+        self.pos += 1;
+    }
+
+    fn bump_str(&mut self, s: &str) {
+        self.pos += s.len();
+    }
+
+    fn starts_with(&self, s: &str) -> bool {
+        self.src[self.pos..].starts_with(s)
+    }
+
+    /// Skip whitespace and comments and return if any whitespace or anything at all was skipped.
+    fn skip_trivia(&mut self) -> FastParseResult<(bool, bool)> {
+        let (mut ws, mut gap) = (false, false);
+        loop {
+            match (self.peek(0), self.peek(1)) {
+                (Some(b' ' | b'\n' | b'\t' | b'\r'), _) => {
+                    self.bump();
+                    ws = true;
+                }
+                (Some(b'/'), Some(b'/')) => {
+                    if self.peek(2) == Some(b'/') {
+                        return Err(FastParseError::Unsupported("doc comment", self.pos));
+                    }
+                    while !matches!(self.peek(0), None | Some(b'\n')) {
+                        self.bump();
+                    }
+                }
+                (Some(b'/'), Some(b'*')) => match self.src[self.pos + 2..].find("*/") {
+                    Some(len) => (0..len + 4).for_each(|_| self.bump()),
+                    None => return Err(FastParseError::Syntax(self.pos)),
+                },
+                _ => return Ok((ws, gap || ws)),
+            }
+            gap = true;
+        }
+    }
+
+    /// Read next token.
+    fn token(&mut self, ws: bool, gap: bool) -> FastParseResult<Token> {
+        let start = self.pos;
+
+        let kind = match (self.peek(0), self.peek(1)) {
+            (None, _) => TokenKind::Eof,
+            (Some(b'a'..=b'z' | b'A'..=b'Z' | b'_'), _) => {
+                while matches!(
+                    self.peek(0),
+                    Some(b'a'..=b'z' | b'A'..=b'Z' | b'0'..=b'9' | b'_')
+                ) {
+                    self.bump();
+                }
+                TokenKind::Identifier
+            }
+            (Some(b'0'..=b'9'), _) | (Some(b'.'), Some(b'0'..=b'9')) => self.number()?,
+            (Some(b'"'), _) => return Err(FastParseError::Unsupported("string", start)),
+            _ => match PUNCTUATION.iter().find(|p| self.starts_with(p)) {
+                Some(punct) => {
+                    self.bump_str(punct);
+                    TokenKind::Punct(*punct)
+                }
+                None => return Err(FastParseError::Unsupported("character", start)),
+            },
+        };
+
+        Ok(Token {
+            kind,
+            start,
+            end: self.pos,
+            ws,
+            gap,
+        })
+    }
+
+    fn digits(&mut self) -> usize {
+        let start = self.pos;
+        while matches!(self.peek(0), Some(b'0'..=b'9')) {
+            self.bump();
+        }
+        self.pos - start
+    }
+
+    /// Read a number like grammar rules `number` and `int` do.
+    fn number(&mut self) -> FastParseResult<TokenKind> {
+        // `int = @{ "0" | ASCII_NONZERO_DIGIT ~ ASCII_DIGIT* }`
+        if self.peek(0) == Some(b'0') && matches!(self.peek(1), Some(b'0'..=b'9')) {
+            return Err(FastParseError::Unsupported("leading zero", self.pos));
+        }
+        self.digits();
+
+        // `1..2` is an integer followed by a range operator
+        if self.peek(0) != Some(b'.') || self.peek(1) == Some(b'.') {
+            return Ok(TokenKind::Integer);
+        }
+        self.bump();
+        self.digits();
+
+        if matches!(self.peek(0), Some(b'e' | b'E')) {
+            let sign = matches!(self.peek(1), Some(b'+' | b'-')) as usize;
+            if !matches!(self.peek(1 + sign), Some(b'0'..=b'9')) {
+                return Err(FastParseError::Unsupported("exponent", self.pos));
+            }
+            (0..=sign).for_each(|_| self.bump());
+            self.digits();
+        }
+        Ok(TokenKind::Number)
+    }
+
+    /// Read a unit like grammar rule `unit` does and return `true` if there was one.
+    fn unit(&mut self) -> bool {
+        const EXPONENTS: [&str; 2] = ["²", "³"];
+
+        match self.peek(0) {
+            Some(b'a'..=b'z') => {
+                while matches!(self.peek(0), Some(b'a'..=b'z')) {
+                    self.bump();
+                }
+                // optional `/denominator` which is only part of the unit if an exponent follows
+                let mut rest = &self.src[self.pos..];
+                let mut len = 0;
+                if let Some(denominator) = rest.strip_prefix('/') {
+                    let n = denominator
+                        .bytes()
+                        .take_while(|b| b.is_ascii_lowercase())
+                        .count();
+                    if n > 0 {
+                        len = n + 1;
+                        rest = &denominator[n..];
+                    }
+                }
+                if let Some(exp) = EXPONENTS.iter().find(|exp| rest.starts_with(**exp)) {
+                    (0..len + exp.len()).for_each(|_| self.bump());
+                }
+                true
+            }
+            Some(b'%' | b'"' | b'\'') => {
+                self.bump();
+                true
+            }
+            _ if self.starts_with("°") => {
+                self.bump_str("°");
+                true
+            }
+            _ => false,
+        }
+    }
+}
+
+#[test]
+fn tokenize() {
+    let tokens =
+        Lexer::tokenize("a::b(x = 5mm, y = [1, 2]°) // comment\n  /* c */ .5").expect("test error");
+    let kinds: Vec<_> = tokens.iter().map(|t| t.kind).collect();
+    use TokenKind as T;
+    assert_eq!(
+        kinds,
+        vec![
+            T::Identifier,
+            T::Punct("::"),
+            T::Identifier,
+            T::Punct("("),
+            T::Identifier,
+            T::Punct("="),
+            T::Integer,
+            T::Unit,
+            T::Punct(","),
+            T::Identifier,
+            T::Punct("="),
+            T::Punct("["),
+            T::Integer,
+            T::Punct(","),
+            T::Integer,
+            T::Punct("]"),
+            T::Unit,
+            T::Punct(")"),
+            T::Number,
+            T::Eof
+        ]
+    );
+    let last = tokens[tokens.len() - 2];
+    assert_eq!(last.start, 49);
+    assert!(last.gap && last.ws);
+}
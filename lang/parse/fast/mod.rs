@@ -0,0 +1,169 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Fast hand-written parser
+//!
+//! Generated µcad code (e.g. large point lists) is dominated by literals, arrays, calls and
+//! assignments.
+//! For those the pest parser spends most of its time in backtracking and building pairs.
+//! This module implements a lexer and a recursive descent parser for this data-heavy subset
+//! of the grammar which directly produces the syntax tree.
+//!
+//! Whenever the fast parser meets something it does not support (e.g. definitions,
+//! strings or attributes) or anything pest might treat differently, it gives up with an error
+//! and the caller falls back to the pest parser.
+//! So the fast parser never changes the accepted language or the resulting syntax tree.
+//!
+//! Use [`cross_check`] to verify that both parsers produce the same syntax tree.
+
+mod lexer;
+mod parser;
+
+use crate::{parse::*, parser::*, src_ref::*, syntax::*, tree_display::*};
+use parser::*;
+
+/// Reason why the fast parser declined to parse some code.
+#[derive(Debug, thiserror::Error)]
+pub enum FastParseError {
+    /// Code uses a construct which is left to the pest parser.
+    #[error("Unsupported {0} at byte {1}")]
+    Unsupported(&'static str, usize),
+    /// Code is not valid (pest will report the proper error).
+    #[error("Syntax error at byte {0}")]
+    Syntax(usize),
+}
+
+/// Result type of the fast parser.
+pub type FastParseResult<T> = std::result::Result<T, FastParseError>;
+
+/// Parse a statement list (e.g. the content of a source file).
+///
+/// - `src`: trimmed source code.
+/// - `hash`: source file hash to store in source references.
+pub fn parse_statement_list(src: &str, hash: u64) -> FastParseResult<StatementList> {
+    let mut parser = FastParser::new(src, hash)?;
+    let statements = parser.statement_list()?;
+    parser.expect_eof()?;
+    Ok(statements)
+}
+
+/// Parse a single expression.
+///
+/// - `src`: trimmed source code.
+/// - `hash`: source file hash to store in source references.
+pub fn parse_expression(src: &str, hash: u64) -> FastParseResult<Expression> {
+    let mut parser = FastParser::new(src, hash)?;
+    let expression = parser.expression()?;
+    parser.expect_eof()?;
+    Ok(expression)
+}
+
+/// Check if the fast parser produces the same syntax tree as pest for `input`.
+///
+/// Only `Rule::source_file` and `Rule::expression` are checked.
+/// Returns `Ok` if both trees match or if the fast parser declines.
+pub fn cross_check(rule: Rule, input: &str) -> Result<(), String> {
+    let input = input.trim();
+
+    // pest is only asked if the fast parser succeeds because it panics on some input
+    let (fast, pest) = match rule {
+        Rule::source_file => {
+            let hash = SourceFile::calculate_hash(input);
+            let Ok(statements) = parse_statement_list(input, hash) else {
+                return Ok(());
+            };
+            let pest = Parser::parse_rule::<SourceFile>(rule, input, 0)
+                .map_err(|err| format!("pest failed where fast parser succeeded: {err}"))?;
+            (
+                FormatTree(&SourceFile::new(statements, input.into(), hash)).to_string(),
+                FormatTree(&pest).to_string(),
+            )
+        }
+        Rule::expression => {
+            let Ok(expression) = parse_expression(input, 0) else {
+                return Ok(());
+            };
+            let pest = Parser::parse_rule::<Expression>(rule, input, 0)
+                .map_err(|err| format!("pest failed where fast parser succeeded: {err}"))?;
+            (
+                FormatTree(&expression).to_string(),
+                FormatTree(&pest).to_string(),
+            )
+        }
+        _ => return Ok(()),
+    };
+
+    match fast == pest {
+        true => Ok(()),
+        false => Err(format!(
+            "fast parser differs from pest for:\n{input}\nfast:\n{fast}\npest:\n{pest}"
+        )),
+    }
+}
+
+#[cfg(test)]
+fn check(input: &str) {
+    assert!(
+        parse_statement_list(input, 0).is_ok(),
+        "fast parser declined: {input}"
+    );
+    if let Err(err) = cross_check(Rule::source_file, input) {
+        panic!("{err}");
+    }
+}
+
+#[test]
+fn fast_parse_statements() {
+    check("a = 1; b = 2.5mm; pub c = [1, 2, 3]mm; const d = -a * (b + 1);");
+    check("use std::geo2d::*; use std::math as m; pub use foo::bar;");
+    check("x = std::geo2d::Circle(radius = 5mm).translate(x = 1mm, y = 2mm);");
+    check("if a > 1 { b = 2; } else if a < 0 { b = 3; } else { b = 4; }");
+    check("t = (x = 1mm, y = 2mm); r = [0..10]; s = [a..b + 1]; p = t.x; q = t#attr;");
+    check("v = !true or false and 1 <= 2; @input; { a = 1; a }");
+    check("points = [[0, 0], [1.5, .5], [1.0e3, -2.0]]mm; angle = 45°; f(a, b,)");
+}
+
+#[test]
+fn fast_parse_fallback() {
+    for input in [
+        "/// doc\na = 1;",
+        "a = \"text\";",
+        "#[color = \"red\"] a = 1;",
+        "fn f() { }",
+        "a: Length = 1mm;",
+        "a = b[1];",
+        "a = 007;",
+        "a = truex;",
+        "f(a = 1, a = 2);",
+        "a = 1xyz;",
+    ] {
+        assert!(parse_statement_list(input, 0).is_err(), "{input}");
+    }
+}
+
+#[test]
+#[ignore = "benchmark"]
+fn fast_parse_benchmark() {
+    use std::fmt::Write;
+
+    let mut input = String::from("points = [[0mm, 0mm]");
+    (1..200_000).for_each(|i| {
+        write!(input, ", [{}.5mm, {}mm]", i, i * 2).expect("test error");
+    });
+    input.push_str("];");
+
+    let mb = input.len() as f64 / 1_000_000.0;
+    let measure = |name: &str, f: &dyn Fn()| {
+        let start = std::time::Instant::now();
+        f();
+        let secs = start.elapsed().as_secs_f64();
+        eprintln!("{name}: {mb:.1} MB in {secs:.3}s = {:.1} MB/s", mb / secs);
+    };
+
+    measure("fast", &|| {
+        parse_statement_list(&input, 0).expect("test error");
+    });
+    measure("pest", &|| {
+        Parser::parse_rule::<SourceFile>(Rule::source_file, &input, 0).expect("test error");
+    });
+}
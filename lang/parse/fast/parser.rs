@@ -0,0 +1,803 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Recursive descent parser of the fast parser
+
+use super::{lexer::*, *};
+use crate::{ord_map::*, rc::*};
+
+/// Keywords which are not allowed as identifiers (see grammar rule `keywords`).
+const KEYWORDS: &[&str] = &[
+    "mod", "part", "sketch", "op", "fn", "if", "else", "use", "return",
+];
+
+/// Recursive descent parser working on a token list.
+pub(super) struct FastParser<'a> {
+    src: &'a str,
+    tokens: Vec<Token>,
+    pos: usize,
+    file: FileId,
+}
+
+impl<'a> FastParser<'a> {
+    /// Create parser for `src` whose source references will point into the file with `hash`.
+    pub fn new(src: &'a str, hash: u64) -> FastParseResult<Self> {
+        Ok(Self {
+            src,
+            tokens: Lexer::tokenize(src)?,
+            pos: 0,
+            file: FileId::from_hash(hash),
+        })
+    }
+
+    /// Return error if there are any tokens left.
+    pub fn expect_eof(&self) -> FastParseResult<()> {
+        match self.peek(0).kind {
+            TokenKind::Eof => Ok(()),
+            _ => Err(self.syntax_error()),
+        }
+    }
+
+    fn peek(&self, n: usize) -> &Token {
+        let last = self.tokens.len() - 1;
+        &self.tokens[(self.pos + n).min(last)]
+    }
+
+    fn text(&self, token: &Token) -> &'a str {
+        &self.src[token.start..token.end]
+    }
+
+    fn peek_text(&self, n: usize) -> &'a str {
+        self.text(self.peek(n))
+    }
+
+    fn is_punct(&self, n: usize, punct: &str) -> bool {
+        matches!(self.peek(n).kind, TokenKind::Punct(p) if p == punct)
+    }
+
+    fn is_identifier(&self, n: usize) -> bool {
+        self.peek(n).kind == TokenKind::Identifier
+    }
+
+    fn bump(&mut self) -> Token {
+        let token = *self.peek(0);
+        self.pos = (self.pos + 1).min(self.tokens.len() - 1);
+        token
+    }
+
+    fn expect_punct(&mut self, punct: &str) -> FastParseResult<Token> {
+        match self.is_punct(0, punct) {
+            true => Ok(self.bump()),
+            false => Err(self.syntax_error()),
+        }
+    }
+
+    fn syntax_error(&self) -> FastParseError {
+        FastParseError::Syntax(self.peek(0).start)
+    }
+
+    fn unsupported(&self, what: &'static str) -> FastParseError {
+        FastParseError::Unsupported(what, self.peek(0).start)
+    }
+
+    /// Source reference from `start` until the last consumed token.
+    fn src_ref_from(&self, start: &Token) -> SrcRef {
+        let end = match self.pos {
+            0 => start.end,
+            pos => self.tokens[pos - 1].end,
+        };
+        SrcRef::new(start.start..end, self.file)
+    }
+
+    /// `statement_list = { (statement ~ ws*)* ~ final_expression_statement? }`
+    pub fn statement_list(&mut self) -> FastParseResult<StatementList> {
+        let mut statements = Vec::new();
+        while !self.at_end_of_list() {
+            let (statement, terminated) = self.statement()?;
+            statements.push(statement);
+            if !terminated && !self.at_end_of_list() {
+                return Err(self.syntax_error());
+            }
+        }
+        Ok(StatementList(statements))
+    }
+
+    fn at_end_of_list(&self) -> bool {
+        matches!(self.peek(0).kind, TokenKind::Eof | TokenKind::Punct("}"))
+    }
+
+    /// Parse a statement and return if it was terminated (by `;` or a body).
+    fn statement(&mut self) -> FastParseResult<(Statement, bool)> {
+        if self.is_punct(0, "#") {
+            return Err(self.unsupported("attribute"));
+        }
+        if !self.is_identifier(0) {
+            return self.expression_statement();
+        }
+
+        let (next, next_ws) = (self.peek(1).kind, self.peek(1).ws);
+        match self.peek_text(0) {
+            "use" => self.use_statement(Visibility::Private),
+            "return" => self.return_statement(),
+            "if" => Ok((Statement::If(self.if_statement()?), true)),
+            "mod" | "fn" | "part" | "sketch" | "op" => Err(self.unsupported("definition")),
+            "init" if self.is_punct(1, "(") => Err(self.unsupported("definition")),
+            "pub" => match (next, self.peek_text(1)) {
+                (TokenKind::Identifier, "use") if next_ws => {
+                    self.bump();
+                    self.use_statement(Visibility::Public)
+                }
+                (TokenKind::Identifier, "mod" | "fn" | "part" | "sketch" | "op") => {
+                    Err(self.unsupported("definition"))
+                }
+                (TokenKind::Identifier, _) if next_ws => self.assignment_statement(),
+                _ => Err(self.unsupported("visibility")),
+            },
+            "const" | "prop" if next == TokenKind::Identifier && next_ws => {
+                self.assignment_statement()
+            }
+            "const" | "prop" if next != TokenKind::Punct("=") => Err(self.unsupported("qualifier")),
+            // `return_statement` and `if_statement` do not check for a word boundary
+            id if id.starts_with("return") || id.starts_with("if") => {
+                Err(self.unsupported("keyword prefix"))
+            }
+            _ if next == TokenKind::Punct(":") => Err(self.unsupported("type annotation")),
+            _ if next == TokenKind::Punct("=") => self.assignment_statement(),
+            _ => self.expression_statement(),
+        }
+    }
+
+    /// `assignment_statement = { (attribute_list ~ ws+)? ~ assignment ~ ws* ~ ";" }`
+    fn assignment_statement(&mut self) -> FastParseResult<(Statement, bool)> {
+        let start = *self.peek(0);
+
+        let mut visibility = Visibility::Private;
+        if self.peek_text(0) == "pub" {
+            self.bump();
+            visibility = Visibility::Public;
+        }
+
+        let mut qualifier = Qualifier::Value;
+        if self.is_identifier(1) && self.peek(1).ws {
+            match self.peek_text(0) {
+                "const" => qualifier = Qualifier::Const,
+                "prop" => qualifier = Qualifier::Prop,
+                _ => (),
+            }
+            if !matches!(qualifier, Qualifier::Value) {
+                self.bump();
+            }
+        }
+
+        let id = self.identifier()?;
+        if self.is_punct(0, ":") {
+            return Err(self.unsupported("type annotation"));
+        }
+        self.expect_punct("=")?;
+        let expression = Rc::new(self.expression()?);
+        let assignment = Assignment::new(
+            visibility,
+            qualifier,
+            id,
+            None,
+            expression,
+            self.src_ref_from(&start),
+        );
+        self.expect_punct(";")?;
+
+        Ok((
+            Statement::Assignment(AssignmentStatement {
+                attribute_list: AttributeList::default(),
+                assignment,
+                src_ref: self.src_ref_from(&start),
+            }),
+            true,
+        ))
+    }
+
+    /// `use_statement = { visibility? ~ ws* ~ "use" ~ ws+ ~ use_declaration ~ ws* ~ ";" }`
+    fn use_statement(&mut self, visibility: Visibility) -> FastParseResult<(Statement, bool)> {
+        let start = match visibility {
+            Visibility::Public => self.tokens[self.pos - 1],
+            _ => *self.peek(0),
+        };
+        self.bump();
+        if !self.peek(0).ws {
+            return Err(self.syntax_error());
+        }
+
+        let name = self.qualified_name()?;
+        let decl = if self.is_punct(0, "::") && self.is_punct(1, "*") {
+            self.pos += 2;
+            UseDeclaration::UseAll(name)
+        } else if self.peek_text(0) == "as" && self.peek(0).ws && self.peek(1).ws {
+            self.bump();
+            UseDeclaration::UseAlias(name, self.identifier()?)
+        } else {
+            UseDeclaration::Use(name)
+        };
+        self.expect_punct(";")?;
+
+        Ok((
+            Statement::Use(UseStatement {
+                visibility,
+                decl,
+                src_ref: self.src_ref_from(&start),
+            }),
+            true,
+        ))
+    }
+
+    /// `return_statement = { "return" ~ ws* ~ expression ~ ws* ~ ";" }`
+    fn return_statement(&mut self) -> FastParseResult<(Statement, bool)> {
+        let start = self.bump();
+        let result = Some(self.expression()?);
+        self.expect_punct(";")?;
+
+        Ok((
+            Statement::Return(ReturnStatement {
+                result,
+                src_ref: self.src_ref_from(&start),
+            }),
+            true,
+        ))
+    }
+
+    /// `if_statement = { "if" ~ ws* ~ expression ~ ws* ~ body ~ (ws* ~ "else" ~ ws* ~ (body | if_statement))? }`
+    fn if_statement(&mut self) -> FastParseResult<IfStatement> {
+        let start = self.bump();
+        let cond = self.expression()?;
+        let body = self.body()?;
+
+        let (mut body_else, mut next_if) = (None, None);
+        if self.is_identifier(0) && self.peek_text(0) == "else" {
+            self.bump();
+            match self.peek_text(0) {
+                "{" => body_else = Some(self.body()?),
+                "if" => next_if = Some(Box::new(self.if_statement()?)),
+                _ => return Err(self.unsupported("else")),
+            }
+        }
+
+        Ok(IfStatement {
+            cond,
+            body,
+            body_else,
+            next_if,
+            src_ref: self.src_ref_from(&start),
+        })
+    }
+
+    /// `expression_statement` or `final_expression_statement`
+    fn expression_statement(&mut self) -> FastParseResult<(Statement, bool)> {
+        let start = *self.peek(0);
+        let expression = self.expression()?;
+        let terminated = self.is_punct(0, ";");
+        if terminated {
+            self.bump();
+        }
+
+        Ok((
+            Statement::Expression(ExpressionStatement {
+                attribute_list: AttributeList::default(),
+                expression,
+                src_ref: self.src_ref_from(&start),
+            }),
+            terminated,
+        ))
+    }
+
+    /// `body = { "{" ~ ws* ~ statement_list ~ ws* ~ "}" }`
+    fn body(&mut self) -> FastParseResult<Body> {
+        let start = self.expect_punct("{")?;
+        let statements = self.statement_list()?;
+        self.expect_punct("}")?;
+
+        Ok(Body {
+            statements,
+            src_ref: self.src_ref_from(&start),
+        })
+    }
+
+    /// Parse an expression.
+    ///
+    /// Like the pratt parser in `Expression::parse`, all operator nodes of one expression
+    /// refer to the source code of the whole expression.
+    pub fn expression(&mut self) -> FastParseResult<Expression> {
+        let start = *self.peek(0);
+        let mut expression = self.binary(0)?;
+        Self::assign_src_ref(&mut expression, &self.src_ref_from(&start));
+        Ok(expression)
+    }
+
+    /// Set source reference of all operator nodes which have none yet.
+    fn assign_src_ref(expression: &mut Expression, src_ref: &SrcRef) {
+        match expression {
+            Expression::BinaryOp {
+                lhs,
+                rhs,
+                src_ref: r,
+                ..
+            } if r.0.is_none() => {
+                *r = src_ref.clone();
+                Self::assign_src_ref(lhs, src_ref);
+                Self::assign_src_ref(rhs, src_ref);
+            }
+            Expression::UnaryOp {
+                rhs, src_ref: r, ..
+            } if r.0.is_none() => {
+                *r = src_ref.clone();
+                Self::assign_src_ref(rhs, src_ref);
+            }
+            Expression::PropertyAccess(lhs, _, r)
+            | Expression::AttributeAccess(lhs, _, r)
+            | Expression::MethodCall(lhs, _, r)
+                if r.0.is_none() =>
+            {
+                *r = src_ref.clone();
+                Self::assign_src_ref(lhs, src_ref);
+            }
+            _ => (),
+        }
+    }
+
+    /// Infix operator at current position and it's precedence (see `PRATT_PARSER`).
+    fn infix_op(&self) -> FastParseResult<Option<(&'static str, u8)>> {
+        Ok(Some(match self.peek(0).kind {
+            TokenKind::Identifier if self.peek_text(0) == "or" => ("|", 1),
+            TokenKind::Identifier if self.peek_text(0) == "and" => ("&", 1),
+            TokenKind::Identifier => return Err(self.unsupported("binary operator")),
+            TokenKind::Punct("==") => ("==", 2),
+            TokenKind::Punct("!=") => ("!=", 2),
+            TokenKind::Punct(">") => (">", 3),
+            TokenKind::Punct("<") => ("<", 3),
+            TokenKind::Punct("<=") => ("≤", 4),
+            TokenKind::Punct(">=") => ("≥", 4),
+            TokenKind::Punct("+") => ("+", 5),
+            TokenKind::Punct("-") => ("-", 5),
+            TokenKind::Punct("*") => ("*", 6),
+            TokenKind::Punct("/") => ("/", 6),
+            TokenKind::Punct("|") => ("|", 7),
+            TokenKind::Punct("&") => ("&", 7),
+            TokenKind::Punct("^") => ("^", 8),
+            TokenKind::Punct("~") => ("~", 9),
+            _ => return Ok(None),
+        }))
+    }
+
+    /// Precedence climbing over binary operators (all are left associative).
+    fn binary(&mut self, min_prec: u8) -> FastParseResult<Expression> {
+        let mut lhs = self.unary()?;
+        while let Some((op, prec)) = self.infix_op()? {
+            if prec <= min_prec {
+                break;
+            }
+            self.bump();
+            let rhs = self.binary(prec)?;
+            lhs = Expression::BinaryOp {
+                lhs: Box::new(lhs),
+                op: op.into(),
+                rhs: Box::new(rhs),
+                src_ref: SrcRef(None),
+            };
+        }
+        Ok(lhs)
+    }
+
+    /// Prefix operators bind stronger than any infix operator.
+    fn unary(&mut self) -> FastParseResult<Expression> {
+        let op = match self.peek(0).kind {
+            TokenKind::Punct("-") => '-',
+            TokenKind::Punct("+") => '+',
+            TokenKind::Punct("!") => '!',
+            _ => return self.postfix(),
+        };
+        self.bump();
+
+        Ok(Expression::UnaryOp {
+            op: op.into(),
+            rhs: Box::new(self.unary()?),
+            src_ref: SrcRef(None),
+        })
+    }
+
+    /// Primary expression followed by element access and method calls.
+    fn postfix(&mut self) -> FastParseResult<Expression> {
+        let mut expression = self.primary()?;
+
+        // whitespace is allowed before the first postfix and after method calls only
+        let mut allow_ws = true;
+        loop {
+            let token = *self.peek(0);
+            if !matches!(token.kind, TokenKind::Punct("." | "#" | "[")) {
+                return Ok(expression);
+            }
+            if token.ws && !allow_ws {
+                return Err(self.unsupported("whitespace before postfix"));
+            }
+
+            self.bump();
+            expression = match token.kind {
+                TokenKind::Punct("[") => return Err(self.unsupported("array element access")),
+                TokenKind::Punct("#") => {
+                    allow_ws = false;
+                    let id = self.adjacent_identifier()?;
+                    Expression::AttributeAccess(Box::new(expression), id, SrcRef(None))
+                }
+                _ if self.is_method_call() => {
+                    allow_ws = true;
+                    let name = self.qualified_name()?;
+                    let argument_list = self.call_arguments()?;
+                    let method_call = MethodCall {
+                        name,
+                        argument_list,
+                        src_ref: self.src_ref_from(&token),
+                    };
+                    Expression::MethodCall(Box::new(expression), method_call, SrcRef(None))
+                }
+                _ => {
+                    allow_ws = false;
+                    let id = self.adjacent_identifier()?;
+                    Expression::PropertyAccess(Box::new(expression), id, SrcRef(None))
+                }
+            };
+        }
+    }
+
+    /// Check for `qualified_name ~ ws* ~ call_op` behind the `.` of a method call.
+    fn is_method_call(&self) -> bool {
+        let mut n = 0;
+        while self.is_identifier(n) {
+            if !self.is_punct(n + 1, "::") || self.peek(n + 1).gap || self.peek(n + 2).gap {
+                return self.is_punct(n + 1, "(");
+            }
+            n += 2;
+        }
+        false
+    }
+
+    fn primary(&mut self) -> FastParseResult<Expression> {
+        let token = *self.peek(0);
+        match token.kind {
+            TokenKind::Integer | TokenKind::Number => Ok(Expression::Literal(self.literal()?)),
+            TokenKind::Identifier => {
+                let text = self.text(&token);
+                match text {
+                    "true" | "false" => {
+                        self.bump();
+                        Ok(Expression::Literal(Literal::Bool(Refer::new(
+                            text == "true",
+                            self.src_ref_from(&token),
+                        ))))
+                    }
+                    // `bool_literal` does not check for a word boundary
+                    _ if text.starts_with("true") || text.starts_with("false") => {
+                        Err(self.unsupported("bool prefix"))
+                    }
+                    // `e5` or `e+5` are numbers (see grammar rule `exp`)
+                    _ if matches!(text.as_bytes(), [b'e' | b'E', b'0'..=b'9', ..])
+                        || (matches!(text, "e" | "E")
+                            && matches!(self.src.as_bytes().get(token.end), Some(b'+' | b'-'))) =>
+                    {
+                        Err(self.unsupported("exponent"))
+                    }
+                    _ => {
+                        let name = self.qualified_name()?;
+                        if !self.is_punct(0, "(") {
+                            return Ok(Expression::QualifiedName(name));
+                        }
+                        let argument_list = self.call_arguments()?;
+                        Ok(Expression::Call(Call {
+                            name,
+                            argument_list,
+                            src_ref: self.src_ref_from(&token),
+                        }))
+                    }
+                }
+            }
+            TokenKind::Punct("@") => {
+                self.bump();
+                let id = self.adjacent_identifier()?;
+                Ok(Expression::Marker(Marker {
+                    id,
+                    src_ref: self.src_ref_from(&token),
+                }))
+            }
+            TokenKind::Punct("{") => Ok(Expression::Body(self.body()?)),
+            TokenKind::Punct("[") => Ok(Expression::ArrayExpression(self.array_expression()?)),
+            TokenKind::Punct("(") => self.parenthesis(),
+            _ => Err(self.syntax_error()),
+        }
+    }
+
+    /// `literal = { number_literal | integer_literal | bool_literal }` (without bools)
+    fn literal(&mut self) -> FastParseResult<Literal> {
+        let token = self.bump();
+        let text = self.text(&token);
+
+        // pest would read `1.` as number in `1..2` (unless it's the beginning of a range)
+        if token.kind == TokenKind::Integer && self.is_punct(0, "..") && !self.peek(0).gap {
+            return Err(self.unsupported("integer followed by range"));
+        }
+
+        let unit = match self.peek(0).kind {
+            TokenKind::Unit => Some(self.unit()?),
+            _ => None,
+        };
+        let src_ref = self.src_ref_from(&token);
+
+        match (token.kind, unit) {
+            (TokenKind::Integer, None) => Ok(Literal::Integer(Refer::new(
+                text.parse::<i64>()
+                    .map_err(|_| FastParseError::Unsupported("integer", token.start))?,
+                src_ref,
+            ))),
+            (_, unit) => Ok(Literal::Number(NumberLiteral(
+                text.parse::<f64>()
+                    .map_err(|_| FastParseError::Unsupported("number", token.start))?,
+                unit.unwrap_or_default(),
+                src_ref,
+            ))),
+        }
+    }
+
+    fn unit(&mut self) -> FastParseResult<Unit> {
+        use std::str::FromStr;
+        let token = self.bump();
+        Unit::from_str(self.text(&token))
+            .map_err(|_| FastParseError::Unsupported("unit", token.start))
+    }
+
+    fn identifier(&mut self) -> FastParseResult<Identifier> {
+        let token = *self.peek(0);
+        if token.kind != TokenKind::Identifier {
+            return Err(self.syntax_error());
+        }
+        let text = self.text(&token);
+
+        // `identifier = { !(keywords ~ !identifier_part) ~ identifier_body }`
+        for keyword in KEYWORDS {
+            if let Some(rest) = text.strip_prefix(keyword) {
+                match rest.bytes().next() {
+                    None => return Err(self.syntax_error()),
+                    Some(b'0'..=b'9') => return Err(self.unsupported("keyword prefix")),
+                    _ => (),
+                }
+            }
+        }
+
+        self.bump();
+        Ok(Identifier(Refer::new(
+            text.into(),
+            self.src_ref_from(&token),
+        )))
+    }
+
+    /// Identifier which must follow the previous token without whitespace.
+    fn adjacent_identifier(&mut self) -> FastParseResult<Identifier> {
+        match self.peek(0).ws {
+            true => Err(self.unsupported("whitespace before identifier")),
+            false => self.identifier(),
+        }
+    }
+
+    /// `qualified_name = { identifier ~ ("::" ~ identifier)* }`
+    fn qualified_name(&mut self) -> FastParseResult<QualifiedName> {
+        let start = *self.peek(0);
+        let mut ids = vec![self.identifier()?];
+        while self.is_punct(0, "::")
+            && !self.peek(0).gap
+            && self.is_identifier(1)
+            && !self.peek(1).gap
+        {
+            self.bump();
+            ids.push(self.identifier()?);
+        }
+        Ok(QualifiedName::new(ids, self.src_ref_from(&start)))
+    }
+
+    /// `call_op = _{ "(" ~ ws* ~ argument_list? ~ ws* ~ ")" }`
+    fn call_arguments(&mut self) -> FastParseResult<ArgumentList> {
+        self.expect_punct("(")?;
+        if self.is_punct(0, ")") {
+            self.bump();
+            return Ok(ArgumentList::default());
+        }
+        let argument_list = self.argument_list(*self.peek(0), Vec::new())?;
+        self.expect_punct(")")?;
+        Ok(argument_list)
+    }
+
+    /// `argument_list = { argument ~ (ws* ~ "," ~ ws* ~ argument)* ~ ws* ~ ","? }`
+    ///
+    /// Continues after already parsed `arguments` and stops in front of `)`.
+    fn argument_list(
+        &mut self,
+        start: Token,
+        mut arguments: Vec<Argument>,
+    ) -> FastParseResult<ArgumentList> {
+        loop {
+            if !arguments.is_empty() {
+                if !self.is_punct(0, ",") {
+                    break;
+                }
+                self.bump();
+                if self.is_punct(0, ")") {
+                    break;
+                }
+            }
+            arguments.push(self.argument()?);
+        }
+
+        let mut argument_list =
+            ArgumentList(Refer::new(OrdMap::default(), self.src_ref_from(&start)));
+        for argument in arguments {
+            argument_list
+                .try_push(argument)
+                .map_err(|_| FastParseError::Unsupported("duplicate argument", start.start))?;
+        }
+        Ok(argument_list)
+    }
+
+    /// `argument = _{ named_argument | positional_argument }`
+    fn argument(&mut self) -> FastParseResult<Argument> {
+        let start = *self.peek(0);
+        let id = match self.is_identifier(0) && self.is_punct(1, "=") {
+            true => {
+                let id = self.identifier()?;
+                self.bump();
+                Some(id)
+            }
+            false => None,
+        };
+        let expression = self.expression()?;
+
+        Ok(Argument {
+            id,
+            expression,
+            src_ref: self.src_ref_from(&start),
+        })
+    }
+
+    /// Parenthesized expression `(a + b)` or tuple expression `(a, b)`, `(x = 1)`.
+    fn parenthesis(&mut self) -> FastParseResult<Expression> {
+        let start = self.bump();
+
+        let mut arguments = Vec::new();
+        let args_start = *self.peek(0);
+        if !(self.is_identifier(0) && self.is_punct(1, "=")) {
+            let expression = self.expression()?;
+            if self.is_punct(0, ")") {
+                self.bump();
+                return Ok(expression);
+            }
+            if !self.is_punct(0, ",") {
+                return Err(self.syntax_error());
+            }
+            arguments.push(Argument {
+                id: None,
+                expression,
+                src_ref: self.src_ref_from(&args_start),
+            });
+        }
+
+        let args = self.argument_list(args_start, arguments)?;
+        self.expect_punct(")")?;
+        Ok(Expression::TupleExpression(TupleExpression {
+            args,
+            src_ref: self.src_ref_from(&start),
+        }))
+    }
+
+    /// Check if an integer (see grammar rule `integer_literal`) starts at token `n`.
+    ///
+    /// Returns the number of tokens of the integer literal (including a leading `-`).
+    fn integer_prefix(&self, n: usize) -> Option<usize> {
+        let starts_with_digit = |n| {
+            matches!(self.peek(n).kind, TokenKind::Integer | TokenKind::Number)
+                && self.peek_text(n).as_bytes()[0].is_ascii_digit()
+        };
+        if starts_with_digit(n) {
+            Some(1)
+        } else if self.is_punct(n, "-") && !self.peek(n + 1).gap && starts_with_digit(n + 1) {
+            Some(2)
+        } else {
+            None
+        }
+    }
+
+    /// Read integer literal which was checked with [`Self::integer_prefix`].
+    fn integer_literal(&mut self, len: usize) -> FastParseResult<Expression> {
+        let start = *self.peek(0);
+        self.pos += len;
+        let src_ref = self.src_ref_from(&start);
+        let value = self.src[start.start..self.tokens[self.pos - 1].end]
+            .parse::<i64>()
+            .map_err(|_| FastParseError::Unsupported("integer", start.start))?;
+        Ok(Expression::Literal(Literal::Integer(Refer::new(
+            value, src_ref,
+        ))))
+    }
+
+    /// `array_expression = { "[" ~ ws* ~ (range_expression | list_expression?) ~ ws* ~ "]" ~ unit? }`
+    fn array_expression(&mut self) -> FastParseResult<ArrayExpression> {
+        let start = self.bump();
+
+        let inner = if self.is_punct(0, "]") {
+            ArrayExpressionInner::List(ListExpression::new())
+        } else if let Some(len) = self.integer_prefix(0) {
+            // `range_start = { integer_literal | expression }` does not backtrack
+            // if an integer is followed by anything else than `..`.
+            if self.peek(len - 1).kind == TokenKind::Integer && self.is_punct(len, "..") {
+                let range_start = *self.peek(0);
+                let first = self.integer_literal(len)?;
+                ArrayExpressionInner::Range(self.range_expression(range_start, first)?)
+            } else {
+                ArrayExpressionInner::List(self.list_expression(Vec::new())?)
+            }
+        } else {
+            let range_start = *self.peek(0);
+            let first = self.expression()?;
+            if self.is_punct(0, "..") {
+                ArrayExpressionInner::Range(self.range_expression(range_start, first)?)
+            } else {
+                ArrayExpressionInner::List(self.list_expression(vec![first])?)
+            }
+        };
+        self.expect_punct("]")?;
+
+        let unit = match self.peek(0).kind {
+            TokenKind::Unit => self.unit()?,
+            _ => Unit::None,
+        };
+
+        Ok(ArrayExpression {
+            inner,
+            unit,
+            src_ref: self.src_ref_from(&start),
+        })
+    }
+
+    /// `range_expression = { range_start ~ ws* ~ ".." ~ ws* ~ range_end }`
+    fn range_expression(
+        &mut self,
+        start: Token,
+        first: Expression,
+    ) -> FastParseResult<RangeExpression> {
+        self.expect_punct("..")?;
+
+        // `range_end = { integer_literal | expression }` does not backtrack either
+        let last = match self.integer_prefix(0) {
+            Some(len)
+                if self.peek(len - 1).kind == TokenKind::Integer && self.is_punct(len, "]") =>
+            {
+                self.integer_literal(len)?
+            }
+            Some(_) => return Err(self.unsupported("range end")),
+            None => self.expression()?,
+        };
+
+        Ok(RangeExpression {
+            first: RangeFirst(Box::new(first)),
+            last: RangeLast(Box::new(last)),
+            src_ref: self.src_ref_from(&start),
+        })
+    }
+
+    /// `list_expression = { expression ~ (ws* ~ "," ~ ws* ~ expression)* }`
+    ///
+    /// Continues after already parsed `expressions`.
+    fn list_expression(
+        &mut self,
+        mut expressions: ListExpression,
+    ) -> FastParseResult<ListExpression> {
+        if expressions.is_empty() {
+            expressions.push(self.expression()?);
+        }
+        while self.is_punct(0, ",") {
+            self.bump();
+            expressions.push(self.expression()?);
+        }
+        Ok(expressions)
+    }
+}
@@ -0,0 +1,223 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Incremental reparsing of edited source files
+//!
+//! Editors change source code in small steps.
+//! Instead of parsing the whole file after each change, [`SourceFile::reparse`] only parses
+//! the top level statements within the lines touched by an edit.
+//! Statements in front of the edit are kept as they are, statements behind the edit are
+//! kept and their source references are moved (see [`Relocate`]).
+
+use crate::{parse::*, parser::*, rc::*, src_ref::*};
+
+/// Replacement of a byte range within source code.
+#[derive(Clone, Debug)]
+pub struct TextEdit {
+    /// Byte range to replace.
+    pub range: std::ops::Range<usize>,
+    /// Replacement text.
+    pub text: String,
+}
+
+impl TextEdit {
+    /// Create new text edit.
+    pub fn new(range: std::ops::Range<usize>, text: impl Into<String>) -> Self {
+        Self {
+            range,
+            text: text.into(),
+        }
+    }
+}
+
+impl SourceFile {
+    /// Create a new version of this source file by applying a text `edit`.
+    ///
+    /// Only the top level statements within the lines touched by `edit` are parsed again.
+    /// If that is not possible (e.g. a block comment has been opened), the whole
+    /// file will be parsed.
+    pub fn reparse(&self, edit: &TextEdit) -> ParseResult<Rc<Self>> {
+        let TextEdit { range, text } = edit;
+        if range.start > range.end
+            || range.end > self.source.len()
+            || !self.source.is_char_boundary(range.start)
+            || !self.source.is_char_boundary(range.end)
+        {
+            return Err(ParseError::InvalidTextEdit(range.clone()));
+        }
+
+        let mut source = String::with_capacity(self.source.len() + text.len());
+        source.push_str(&self.source[..range.start]);
+        source.push_str(text);
+        source.push_str(&self.source[range.end..]);
+
+        let source_file = match self.reparse_statements(edit, &source) {
+            Some(source_file) => source_file,
+            None => {
+                log::trace!("Incremental parsing not possible, parsing whole file");
+                let source_file = Self::parse_source(source)?;
+                self.with_source(source_file.statements, source_file.source, source_file.hash)
+            }
+        };
+        Ok(Rc::new(source_file))
+    }
+
+    /// Parse statements touched by `edit` and return `None` if the whole file must be parsed.
+    fn reparse_statements(&self, edit: &TextEdit, source: &str) -> Option<Self> {
+        let TextEdit { range, text } = edit;
+
+        // source code is always stored trimmed
+        if source.trim().len() != source.len() {
+            return None;
+        }
+        // comments and strings may change the meaning of code far away from the edit
+        let window = |src: &str, start: usize, end: usize| {
+            let mut start = start.saturating_sub(1);
+            while !src.is_char_boundary(start) {
+                start -= 1;
+            }
+            let mut end = (end + 1).min(src.len());
+            while !src.is_char_boundary(end) {
+                end += 1;
+            }
+            let window = &src[start..end];
+            window.contains("/*") || window.contains("*/") || window.contains('"')
+        };
+        if window(&self.source, range.start, range.end)
+            || window(source, range.start, range.start + text.len())
+        {
+            return None;
+        }
+
+        // the lines touched by the edit in the old source
+        let touched_start = self.source[..range.start]
+            .rfind('\n')
+            .map(|n| n + 1)
+            .unwrap_or(0);
+        let touched_end = self.source[range.end..]
+            .find('\n')
+            .map(|n| range.end + n)
+            .unwrap_or(self.source.len());
+
+        let mut ranges = Vec::with_capacity(self.statements.len());
+        for statement in self.statements.iter() {
+            ranges.push(statement.src_ref().0?.range());
+        }
+        let first = ranges.partition_point(|r| r.end < touched_start);
+        let last = ranges.partition_point(|r| r.start <= touched_end);
+
+        // region between untouched statements in the old source
+        let region_start = first.checked_sub(1).map(|n| ranges[n].end).unwrap_or(0);
+        let old_region_end = ranges
+            .get(last)
+            .map(|r| r.start)
+            .unwrap_or(self.source.len());
+        let delta = text.len() as isize - range.len() as isize;
+        let region_end = old_region_end.checked_add_signed(delta)?;
+
+        // parse region as separate code
+        let region = &source[region_start..region_end];
+        let trimmed = region.trim_start();
+        let region_start = region_start + region.len() - trimmed.len();
+        let region = trimmed.trim_end();
+        let hash = Self::calculate_hash(source);
+        let mut region_statements = match fast::parse_statement_list(region, hash) {
+            Ok(statements) => statements,
+            Err(_) => {
+                Parser::parse_rule::<Self>(Rule::source_file, region, 0)
+                    .ok()?
+                    .statements
+            }
+        };
+
+        // a final expression statement without `;` cannot be followed by other statements
+        if last < ranges.len()
+            && matches!(region_statements.last(), Some(Statement::Expression(_)))
+            && !region.ends_with(';')
+        {
+            return None;
+        }
+
+        let file = FileId::from_hash(hash);
+        region_statements.relocate(&Relocation {
+            from: 0,
+            bytes: region_start as isize,
+            file,
+        });
+
+        let rehash = Relocation::rehash(file);
+        let shift = Relocation {
+            from: old_region_end,
+            bytes: delta,
+            file,
+        };
+
+        let mut statements =
+            Vec::with_capacity(first + region_statements.len() + ranges.len() - last);
+        for statement in &self.statements[..first] {
+            let mut statement = statement.clone();
+            statement.relocate(&rehash);
+            statements.push(statement);
+        }
+        statements.append(&mut region_statements.0);
+        for statement in &self.statements[last..] {
+            let mut statement = statement.clone();
+            statement.relocate(&shift);
+            statements.push(statement);
+        }
+
+        log::trace!(
+            "Reparsed statements {first}..{last} of {} in bytes {region_start}..{}",
+            ranges.len(),
+            region_start + region.len()
+        );
+        Some(self.with_source(StatementList(statements), source.to_string(), hash))
+    }
+}
+
+#[cfg(test)]
+fn check_reparse(source: &str, range: std::ops::Range<usize>, text: &str) {
+    use crate::tree_display::*;
+
+    let summary = |source_file: &SourceFile| {
+        let src_refs: Vec<_> = source_file
+            .statements
+            .iter()
+            .map(|statement| format!("{:?}", statement.src_ref()))
+            .collect();
+        format!("{}{src_refs:?}", FormatTree(source_file))
+    };
+
+    let source_file = SourceFile::load_from_str("test", source).expect("test error");
+    let edit = TextEdit::new(range, text);
+    let incremental = source_file.reparse(&edit).expect("test error");
+    let full = SourceFile::load_from_str("test", &incremental.source).expect("test error");
+
+    assert_eq!(incremental.hash, full.hash);
+    assert_eq!(summary(&incremental), summary(&full));
+}
+
+#[test]
+fn reparse_source_file() {
+    let source = "a = 1;\nb = [1, 2, 3]mm;\nc = std::geo2d::Circle(radius = 1mm);\nfn f() { return 1; }\nd = 4;";
+
+    // change value in the middle
+    check_reparse(source, 12..13, "42");
+    // insert a line
+    check_reparse(source, 7..7, "x = 5;\n");
+    // remove a line
+    check_reparse(source, 7..24, "");
+    // edit within a function
+    check_reparse(source, 78..79, "2");
+    // multi-byte characters in front of following statements
+    check_reparse(source, 20..23, "°; e = 2°;");
+    // edit at the end
+    check_reparse(source, 87..89, "5; g = 6");
+}
+
+#[test]
+fn reparse_invalid_edit() {
+    let source_file = SourceFile::load_from_str("test", "a = 1;").expect("test error");
+    assert!(source_file.reparse(&TextEdit::new(4..10, "")).is_err());
+    assert!(source_file.reparse(&TextEdit::new(4..5, "+")).is_err());
+}
@@ -30,6 +30,7 @@ mod expression;
 mod format_string;
 mod function;
 mod identifier;
+mod incremental;
 mod init_definition;
 mod lang_type;
 mod literal;
@@ -41,10 +42,12 @@ mod r#type;
 mod r#use;
 mod workbench;
 
+pub mod fast;
 pub(crate) mod find_rule;
 pub(crate) mod parse_error;
 
 pub use find_rule::*;
+pub use incremental::*;
 pub use parse_error::*;
 
 use crate::{src_ref::*, syntax::*};
@@ -144,6 +144,10 @@ pub enum ParseError {
     /// Unknown type
     #[error("Unknown type: {0}")]
     UnknownType(String),
+
+    /// Text edit does not fit into the source code
+    #[error("Invalid text edit at {0:?}")]
+    InvalidTextEdit(std::ops::Range<usize>),
 }
 
 /// Result with parse error
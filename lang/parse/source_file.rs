@@ -2,7 +2,13 @@
 // SPDX-License-Identifier: AGPL-3.0-or-later
 
 use crate::{parse::*, parser::*, rc::*, tree_display::*};
-use std::io::Read;
+use std::{cell::RefCell, collections::HashMap, io::Read};
+
+thread_local! {
+    /// Library image: syntax trees of library files which have been loaded in this thread.
+    static LIBRARY: RefCell<HashMap<std::path::PathBuf, Rc<SourceFile>>> =
+        RefCell::new(HashMap::new());
+}
 
 impl SourceFile {
     /// Load µcad source file from given `path`
@@ -23,22 +29,68 @@ impl SourceFile {
         name: QualifiedName,
     ) -> ParseResult<Rc<Self>> {
         log::trace!("{load} file {path:?} [{name}]", load = crate::mark!(LOAD));
+        Self::parse_file(path.as_ref(), name, Self::read_file(path.as_ref())?)
+    }
+
+    /// Load a library file like [`SourceFile::load_with_name()`] but share the syntax tree
+    /// with earlier loads of the unchanged file within the current thread.
+    ///
+    /// This helps long-running processes like watch mode and the language server, which create
+    /// a new context for each evaluation: only the first context parses libraries like `std`.
+    /// The file is read and hashed on every load, so any change of its content is noticed.
+    /// Syntax trees cannot be shared between threads or processes, so a new process or thread
+    /// parses the libraries again.
+    pub fn load_library(
+        path: impl AsRef<std::path::Path> + std::fmt::Debug,
+        name: QualifiedName,
+    ) -> ParseResult<Rc<Self>> {
+        let path = path.as_ref();
+        let source = Self::read_file(path)?;
+        let hash = Self::calculate_hash(source.trim());
+
+        if let Some(source_file) = LIBRARY.with_borrow(|library| {
+            library
+                .get(path)
+                .filter(|source_file| source_file.hash == hash && source_file.name == name)
+                .cloned()
+        }) {
+            log::trace!(
+                "{load} file {path:?} [{name}] from library image",
+                load = crate::mark!(LOAD)
+            );
+            return Ok(source_file);
+        }
+
+        log::trace!("{load} file {path:?} [{name}]", load = crate::mark!(LOAD));
+        let source_file = Self::parse_file(path, name, source)?;
+        LIBRARY.with_borrow_mut(|library| library.insert(path.to_path_buf(), source_file.clone()));
+        Ok(source_file)
+    }
 
-        let mut file = match std::fs::File::open(&path) {
+    fn read_file(path: &std::path::Path) -> ParseResult<String> {
+        let mut file = match std::fs::File::open(path) {
             Ok(file) => file,
-            _ => return Err(ParseError::LoadSource(path.as_ref().into())),
+            _ => return Err(ParseError::LoadSource(path.into())),
         };
 
         let mut buf = String::new();
         file.read_to_string(&mut buf)?;
+        Ok(buf)
+    }
 
-        let mut source_file: Self = Parser::parse_rule(crate::parser::Rule::source_file, &buf, 0)?;
+    fn parse_file(
+        path: &std::path::Path,
+        name: QualifiedName,
+        buf: String,
+    ) -> ParseResult<Rc<Self>> {
+        let _span = crate::trace_span!("parse", "{}", path.display());
+        let mut source_file = Self::parse_source(buf)?;
         assert_ne!(source_file.hash, 0);
-        source_file.set_filename(path.as_ref());
+        source_file.set_filename(path);
         source_file.name = name;
         log::debug!(
             "Successfully loaded external file {} to {}",
-            path.as_ref().to_string_lossy(),
+            path.to_string_lossy(),
             source_file.name
         );
         log::trace!("Syntax tree:\n{}", FormatTree(&source_file));
@@ -50,14 +102,33 @@ impl SourceFile {
     /// The hash of the result will be of `crate::from_str!()`.
     pub fn load_from_str(name: &str, s: &str) -> ParseResult<Rc<Self>> {
         log::trace!("{load} source from string", load = crate::mark!(LOAD));
-        let mut source_file: Self = Parser::parse_rule(crate::parser::Rule::source_file, s, 0)?;
+        let _span = crate::trace_span!("parse", "{name}");
+        let mut source_file = Self::parse_source(s.to_string())?;
         source_file.set_name(QualifiedName::from_id(Identifier::no_ref(name)));
         log::debug!("Successfully loaded source from string");
         log::trace!("Syntax tree:\n{}", FormatTree(&source_file));
         Ok(Rc::new(source_file))
     }
 
-    fn calculate_hash(value: &str) -> u64 {
+    /// Parse source code with the fast parser and fall back to pest if it declines.
+    pub(crate) fn parse_source(mut source: String) -> ParseResult<Self> {
+        // pest parses trimmed code only
+        let trimmed = source.trim();
+        if trimmed.len() != source.len() {
+            source = trimmed.to_string();
+        }
+
+        let hash = Self::calculate_hash(&source);
+        match fast::parse_statement_list(&source, hash) {
+            Ok(statements) => Ok(SourceFile::new(statements, source, hash)),
+            Err(err) => {
+                log::trace!("Fast parser declined ({err}), using pest");
+                Parser::parse_rule(crate::parser::Rule::source_file, &source, 0)
+            }
+        }
+    }
+
+    pub(crate) fn calculate_hash(value: &str) -> u64 {
         use std::hash::{Hash, Hasher};
         let mut hasher = rustc_hash::FxHasher::default();
         value.hash(&mut hasher);
@@ -69,7 +140,7 @@ impl Parse for SourceFile {
     fn parse(mut pair: Pair) -> ParseResult<Self> {
         // calculate hash over complete file content
         let hash = Self::calculate_hash(pair.as_str());
-        pair.set_source_hash(hash);
+        pair.set_file(FileId::from_hash(hash));
 
         Ok(SourceFile::new(
             crate::find_rule!(pair, statement_list)?,
@@ -95,3 +166,21 @@ fn parse_source_file() {
 
     assert_eq!(source_file.statements.len(), 3);
 }
+
+#[test]
+fn load_library_shared() {
+    let path = std::env::temp_dir().join(format!("load_library_{}.µcad", std::process::id()));
+    let name = QualifiedName::from_id(Identifier::no_ref("lib"));
+
+    std::fs::write(&path, "const A = 1;").expect("test file");
+    let first = SourceFile::load_library(&path, name.clone()).expect("load");
+    let second = SourceFile::load_library(&path, name.clone()).expect("load");
+    assert!(Rc::ptr_eq(&first, &second));
+
+    // changed files are parsed again, even if the size stays the same
+    std::fs::write(&path, "const A = 2;").expect("test file");
+    let changed = SourceFile::load_library(&path, name).expect("load");
+    assert!(!Rc::ptr_eq(&first, &changed));
+
+    let _ = std::fs::remove_file(&path);
+}
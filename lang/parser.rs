@@ -11,22 +11,22 @@
 pub struct Parser;
 
 use crate::parse::{self, ParseResult};
-use crate::src_ref::{SrcRef, SrcReferrer};
+use crate::src_ref::{FileId, SrcRef, SrcReferrer};
 
 #[derive(Debug, Clone)]
-pub struct Pair<'i>(pest::iterators::Pair<'i, Rule>, u64);
+pub struct Pair<'i>(pest::iterators::Pair<'i, Rule>, FileId);
 
 impl<'i> Pair<'i> {
-    pub fn new(pest_pair: pest::iterators::Pair<'i, Rule>, source_hash: u64) -> Self {
-        Self(pest_pair, source_hash)
+    pub fn new(pest_pair: pest::iterators::Pair<'i, Rule>, file: FileId) -> Self {
+        Self(pest_pair, file)
     }
 
-    pub fn source_hash(&self) -> u64 {
+    pub fn file(&self) -> FileId {
         self.1
     }
 
-    pub fn set_source_hash(&mut self, hash: u64) {
-        self.1 = hash
+    pub fn set_file(&mut self, file: FileId) {
+        self.1 = file
     }
 
     pub fn pest_pair(&self) -> &pest::iterators::Pair<'i, Rule> {
@@ -52,14 +52,8 @@ impl<'i> Pair<'i> {
 
 impl SrcReferrer for Pair<'_> {
     fn src_ref(&self) -> SrcRef {
-        let pair = &self.0;
-        let (line, col) = pair.line_col();
-        SrcRef::new(
-            pair.as_span().start()..pair.as_span().end(),
-            line,
-            col,
-            self.1,
-        )
+        let span = self.0.as_span();
+        SrcRef::new(span.start()..span.end(), self.1)
     }
 }
 
@@ -99,9 +93,10 @@ impl Parser {
         T: Parse + Clone,
     {
         use pest::Parser as _;
+        let _span = crate::trace_span!("parse", "{rule:?}");
 
         match Parser::parse(rule, input.trim()).map_err(Box::new)?.next() {
-            Some(pair) => Ok(T::parse(Pair(pair, src_hash))?),
+            Some(pair) => Ok(T::parse(Pair(pair, FileId::from_hash(src_hash)))?),
             None => Err(parse::ParseError::RuleError(Box::new(rule))),
         }
     }
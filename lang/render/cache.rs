@@ -3,6 +3,8 @@
 
 //! Render cache.
 
+use microcad_core::HeapSize;
+
 use crate::render::{GeometryOutput, HashId};
 
 /// An item in the [`RenderCache`].
@@ -138,6 +140,21 @@ impl RenderCache {
     }
 }
 
+impl HeapSize for RenderCache {
+    /// Estimate the memory of all cached items.
+    ///
+    /// Geometry shared between cache items is counted for each item.
+    fn heap_size(&self) -> usize {
+        self.items.capacity()
+            * (std::mem::size_of::<HashId>() + std::mem::size_of::<RenderCacheItem>())
+            + self
+                .items
+                .values()
+                .map(|item| item.content.heap_size())
+                .sum::<usize>()
+    }
+}
+
 impl Default for RenderCache {
     fn default() -> Self {
         Self::new()
@@ -57,6 +57,7 @@ impl RenderContext {
         f: impl FnOnce(&mut RenderContext, Model) -> RenderResult<T>,
     ) -> RenderResult<Geometry2DOutput> {
         let model = self.model();
+        let _span = crate::trace_span!("render", "2D {}", model.borrow().element);
         let hash = model.computed_hash();
 
         match self.cache.clone() {
@@ -85,6 +86,7 @@ impl RenderContext {
         f: impl FnOnce(&mut RenderContext, Model) -> RenderResult<T>,
     ) -> RenderResult<Geometry3DOutput> {
         let model = self.model();
+        let _span = crate::trace_span!("render", "3D {}", model.borrow().element);
         let hash = model.computed_hash();
         match self.cache.clone() {
             Some(cache) => {
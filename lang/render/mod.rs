@@ -35,6 +35,10 @@ pub enum RenderError {
     /// Nothing to render.
     #[error("Nothing to render")]
     NothingToRender,
+
+    /// Core error.
+    #[error("Core error: {0}")]
+    CoreError(#[from] CoreError),
 }
 
 /// A result from rendering a model.
@@ -102,6 +106,7 @@ impl Model {
                 let mut model_ = model.borrow_mut();
                 let output = model_.output.as_mut().expect("Output");
                 let world_matrix = matrix * output.local_matrix().unwrap_or(Mat4::identity());
+                output.set_parent_matrix(matrix);
                 output.set_world_matrix(world_matrix);
                 world_matrix
             };
@@ -114,12 +119,21 @@ impl Model {
         }
 
         /// Set the resolution for this model.
+        ///
+        /// A `resolution` attribute overrides the resolution for the whole subtree.
         pub fn set_resolution(model: &Model, resolution: RenderResolution) {
             let new_resolution = {
                 let mut model_ = model.borrow_mut();
+                let attribute = model_.attributes.get_resolution();
                 let output = model_.output.as_mut().expect("Output");
 
                 let resolution = resolution * output.local_matrix().unwrap_or(Mat4::identity());
+                let resolution = match attribute {
+                    Some(attribute) => {
+                        attribute.render_resolution(resolution, output.world_matrix())
+                    }
+                    None => resolution,
+                };
                 output.set_resolution(resolution.clone());
                 resolution
             };
@@ -129,6 +143,30 @@ impl Model {
             });
         }
 
+        /// Add the resolutions of the model and its children to the model hash.
+        ///
+        /// The same model rendered with a different resolution must not hit the same cache item.
+        pub fn set_resolution_hash(model: &Model) -> HashId {
+            use std::hash::{Hash, Hasher};
+
+            let children: Vec<_> = model
+                .borrow()
+                .children
+                .iter()
+                .map(set_resolution_hash)
+                .collect();
+
+            let mut model_ = model.borrow_mut();
+            let output = model_.output.as_mut().expect("Output");
+            let mut hasher = rustc_hash::FxHasher::default();
+            output.computed_hash().hash(&mut hasher);
+            output.resolution().hash(&mut hasher);
+            children.hash(&mut hasher);
+            let hash = hasher.finish();
+            output.set_hash(hash);
+            hash
+        }
+
         // Create specific render output with local matrix.
         create_render_output(self)?;
 
@@ -138,12 +176,80 @@ impl Model {
         // Calculate the resolution for the model.
         set_resolution(self, resolution);
 
+        // Make the cache keys depend on the resolution.
+        set_resolution_hash(self);
+
         log::trace!("Finished prerender:\n{}", FormatTree(self));
 
         Ok(())
     }
 }
 
+impl Model {
+    /// Render the model part by part and pass each rendered part to `f`.
+    ///
+    /// Groups and workpieces are not rendered as a whole, their children are visited instead.
+    /// Each built-in workpiece is rendered as one part and its geometry is released after `f`
+    /// returned, so apart from the render cache only one part is held in memory at a time.
+    /// The geometry of a part which is a transformation already contains its local matrix, so
+    /// parts must be placed with their parent matrix (see [`RenderOutput::parent_matrix`]).
+    ///
+    /// It is assumed the model has been pre-rendered.
+    pub fn render_parts<E: From<RenderError>>(
+        &self,
+        context: &mut RenderContext,
+        f: &mut impl FnMut(&Model) -> Result<(), E>,
+    ) -> Result<(), E> {
+        if matches!(self.borrow().element(), Element::BuiltinWorkpiece(_)) {
+            let _: Model = self.render_with_context(context)?;
+            let result = f(self);
+            self.release_geometry();
+            result
+        } else {
+            let children: Models = self.borrow().children.clone();
+            children
+                .iter()
+                .try_for_each(|child| child.render_parts(context, f))
+        }
+    }
+
+    /// Drop the rendered geometry of this model and all its descendants.
+    pub fn release_geometry(&self) {
+        if let Some(output) = self.borrow_mut().output.as_mut() {
+            output.clear_geometry();
+        }
+        self.borrow().children().for_each(Model::release_geometry);
+    }
+}
+
+impl HeapSize for Model {
+    /// Estimate the memory of the model tree and its geometry.
+    ///
+    /// Geometry of child models is mostly shared with or consumed into the geometry of their
+    /// parent, so only the topmost geometry of each branch is counted.
+    fn heap_size(&self) -> usize {
+        fn node_size(model: &Model, count_geometry: bool) -> usize {
+            let model_ = model.borrow();
+            let geometry = match (count_geometry, &model_.output) {
+                (true, Some(output)) => output.geometry_heap_size(),
+                _ => None,
+            };
+            let children_size = model_
+                .children()
+                .map(|child| node_size(child, geometry.is_none()))
+                .sum::<usize>();
+
+            2 * std::mem::size_of::<usize>()
+                + std::mem::size_of::<std::cell::RefCell<ModelInner>>()
+                + model_.children.capacity() * std::mem::size_of::<Model>()
+                + geometry.unwrap_or_default()
+                + children_size
+        }
+
+        node_size(self, true)
+    }
+}
+
 impl CalcBounds2D for Model {
     fn calc_bounds_2d(&self) -> Bounds2D {
         let self_ = self.borrow();
@@ -260,9 +366,22 @@ impl RenderWithContext<Geometry2DOutput> for Models {
         match self.len() {
             0 => Err(RenderError::NothingToRender),
             1 => self.first().expect("One item").render_with_context(context),
-            _ => Ok(Rc::new(
-                Geometry2D::Collection(self.render_with_context(context)?).into(),
-            )),
+            _ => {
+                // combine the bounds of the children instead of calculating them again
+                let mut bounds = Bounds2D::default();
+                let mut geometries = Vec::new();
+                for model in self.iter() {
+                    let geo: Geometry2DOutput = model.render_with_context(context)?;
+                    if geo.bounds.is_valid() {
+                        bounds = bounds.extend(geo.bounds.clone());
+                    }
+                    geometries.push(Rc::new(geo.inner.clone()));
+                }
+                Ok(Rc::new(WithBounds2D {
+                    bounds,
+                    inner: Geometry2D::Collection(geometries.into_iter().collect()),
+                }))
+            }
         }
     }
 }
@@ -283,9 +402,20 @@ impl RenderWithContext<Geometry3DOutput> for Models {
         match self.len() {
             0 => Err(RenderError::NothingToRender),
             1 => self.first().expect("One item").render_with_context(context),
-            _ => Ok(Rc::new(
-                Geometry3D::Collection(self.render_with_context(context)?).into(),
-            )),
+            _ => {
+                // combine the bounds of the children instead of calculating them again
+                let mut bounds = Bounds3D::default();
+                let mut geometries = Vec::new();
+                for model in self.iter() {
+                    let geo: Geometry3DOutput = model.render_with_context(context)?;
+                    bounds = bounds.extend(geo.bounds.clone());
+                    geometries.push(Rc::new(geo.inner.clone()));
+                }
+                Ok(Rc::new(WithBounds3D::new(
+                    Geometry3D::Collection(geometries.into_iter().collect()),
+                    bounds,
+                )))
+            }
         }
     }
 }
@@ -300,7 +430,7 @@ impl RenderWithContext<Geometry2DOutput> for BuiltinWorkpiece {
                 let model = context.model();
                 let model_ = model.borrow();
                 let output: Geometry2DOutput = model_.children.render_with_context(context)?;
-                Ok(Rc::new(output.transformed_2d(&transform.mat2d())))
+                Ok(Rc::new(output.lazy_transformed_2d(&transform.mat2d())))
             }
             BuiltinWorkpieceOutput::Operation(operation) => operation.process_2d(context),
             _ => unreachable!(),
@@ -318,7 +448,7 @@ impl RenderWithContext<Geometry3DOutput> for BuiltinWorkpiece {
                 let model = context.model();
                 let model_ = model.borrow();
                 let output: Geometry3DOutput = model_.children.render_with_context(context)?;
-                Ok(Rc::new(output.transformed_3d(&transform.mat3d())))
+                Ok(Rc::new(output.lazy_transformed_3d(&transform.mat3d())))
             }
             BuiltinWorkpieceOutput::Operation(operation) => operation.process_3d(context),
             _ => unreachable!(),
@@ -8,7 +8,7 @@ use std::{
     rc::Rc,
 };
 
-use microcad_core::{Geometry2D, Geometry3D, Mat3, Mat4, RenderResolution};
+use microcad_core::{Geometry2D, Geometry3D, HeapSize, Mat3, Mat4, RenderResolution, rc_heap_size};
 
 use crate::{model::*, render::*};
 
@@ -51,6 +51,15 @@ impl From<Geometry3DOutput> for GeometryOutput {
     }
 }
 
+impl HeapSize for GeometryOutput {
+    fn heap_size(&self) -> usize {
+        match self {
+            GeometryOutput::Geometry2D(geometry) => rc_heap_size(geometry),
+            GeometryOutput::Geometry3D(geometry) => rc_heap_size(geometry),
+        }
+    }
+}
+
 /// The model output when a model has been processed.
 #[derive(Debug, Clone)]
 pub enum RenderOutput {
@@ -60,6 +69,10 @@ pub enum RenderOutput {
         local_matrix: Option<Mat3>,
         /// World transformation matrix.
         world_matrix: Option<Mat3>,
+        /// World transformation matrix of the parent, which places the output geometry.
+        ///
+        /// The geometry of a transformation already contains its local matrix.
+        parent_matrix: Option<Mat3>,
         /// The render resolution, calculated from transformation matrix.
         resolution: Option<RenderResolution>,
         /// The output geometry.
@@ -74,6 +87,10 @@ pub enum RenderOutput {
         local_matrix: Option<Mat4>,
         /// World transformation matrix.
         world_matrix: Option<Mat4>,
+        /// World transformation matrix of the parent, which places the output geometry.
+        ///
+        /// The geometry of a transformation already contains its local matrix.
+        parent_matrix: Option<Mat4>,
         /// The render resolution, calculated from transformation matrix.
         resolution: Option<RenderResolution>,
         /// The output geometry.
@@ -102,6 +119,7 @@ impl RenderOutput {
                 Ok(RenderOutput::Geometry2D {
                     local_matrix,
                     world_matrix: None,
+                    parent_matrix: None,
                     resolution: None,
                     geometry: None,
                     hash,
@@ -118,6 +136,7 @@ impl RenderOutput {
                 Ok(RenderOutput::Geometry3D {
                     local_matrix,
                     world_matrix: None,
+                    parent_matrix: None,
                     resolution: None,
                     geometry: None,
                     hash,
@@ -137,6 +156,16 @@ impl RenderOutput {
         }
     }
 
+    /// Set the world matrix of the parent.
+    pub fn set_parent_matrix(&mut self, m: Mat4) {
+        match self {
+            RenderOutput::Geometry2D { parent_matrix, .. } => {
+                *parent_matrix = Some(mat4_to_mat3(&m))
+            }
+            RenderOutput::Geometry3D { parent_matrix, .. } => *parent_matrix = Some(m),
+        }
+    }
+
     /// Set the 2D geometry as render output.
     pub fn set_geometry_2d(&mut self, geo: Geometry2DOutput) {
         match self {
@@ -153,6 +182,22 @@ impl RenderOutput {
         }
     }
 
+    /// Drop the geometry of the render output.
+    pub fn clear_geometry(&mut self) {
+        match self {
+            RenderOutput::Geometry2D { geometry, .. } => *geometry = None,
+            RenderOutput::Geometry3D { geometry, .. } => *geometry = None,
+        }
+    }
+
+    /// Estimated heap size of the geometry or `None` if there is no geometry.
+    pub fn geometry_heap_size(&self) -> Option<usize> {
+        match self {
+            RenderOutput::Geometry2D { geometry, .. } => geometry.as_ref().map(rc_heap_size),
+            RenderOutput::Geometry3D { geometry, .. } => geometry.as_ref().map(rc_heap_size),
+        }
+    }
+
     /// Get render resolution.
     pub fn resolution(&self) -> &Option<RenderResolution> {
         match self {
@@ -169,6 +214,15 @@ impl RenderOutput {
         }
     }
 
+    /// Set computed model hash.
+    pub fn set_hash(&mut self, new_hash: HashId) {
+        match self {
+            RenderOutput::Geometry2D { hash, .. } | RenderOutput::Geometry3D { hash, .. } => {
+                *hash = new_hash
+            }
+        }
+    }
+
     /// Local matrix.
     pub fn local_matrix(&self) -> Option<Mat4> {
         match self {
@@ -188,6 +242,16 @@ impl RenderOutput {
             RenderOutput::Geometry3D { world_matrix, .. } => world_matrix.expect("World matrix"),
         }
     }
+
+    /// Get world matrix of the parent, which places the output geometry into the world.
+    pub fn parent_matrix(&self) -> Mat4 {
+        match self {
+            RenderOutput::Geometry2D { parent_matrix, .. } => {
+                mat3_to_mat4(&parent_matrix.expect("Parent matrix"))
+            }
+            RenderOutput::Geometry3D { parent_matrix, .. } => parent_matrix.expect("Parent matrix"),
+        }
+    }
 }
 
 fn mat4_to_mat3(m: &Mat4) -> Mat3 {
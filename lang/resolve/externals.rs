@@ -10,7 +10,7 @@ use derive_more::Deref;
 ///
 /// A map of *qualified name* -> *source file path* which is generated at creation
 /// by scanning in the given `search_paths`.
-#[derive(Default, Deref)]
+#[derive(Clone, Default, Deref)]
 pub struct Externals(std::collections::HashMap<QualifiedName, std::path::PathBuf>);
 
 impl Externals {
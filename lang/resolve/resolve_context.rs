@@ -61,7 +61,38 @@ impl ResolveContext {
         builtin: Option<Symbol>,
         diag: DiagHandler,
     ) -> ResolveResult<Self> {
-        match Self::create_ex(root, search_paths, builtin, diag, ResolveMode::Checked) {
+        let _span = crate::trace_span!("resolve", "resolve {}", root.filename_as_str());
+        Self::or_failed(Self::create_ex(
+            root,
+            search_paths,
+            builtin,
+            diag,
+            ResolveMode::Checked,
+        ))
+    }
+
+    /// Resolve and check a changed root file with the already loaded files of `sources`.
+    ///
+    /// Other than [`ResolveContext::create()`] this does not scan the search paths
+    /// and does not load or parse any file again.
+    pub fn recreate(
+        sources: &Sources,
+        root: Rc<SourceFile>,
+        builtin: Option<Symbol>,
+        diag: DiagHandler,
+    ) -> ResolveResult<Self> {
+        let _span = crate::trace_span!("resolve", "resolve {}", root.filename_as_str());
+        let context = Self {
+            sources: sources.with_root(root),
+            diag,
+            ..Default::default()
+        };
+        Self::or_failed(context.process(builtin, ResolveMode::Checked))
+    }
+
+    /// Return the given context or an empty failed context which holds the error.
+    fn or_failed(result: ResolveResult<Self>) -> ResolveResult<Self> {
+        match result {
             Ok(context) => Ok(context),
             Err(err) => {
                 // create empty context which might be given to following stages like export.
@@ -82,20 +113,24 @@ impl ResolveContext {
         diag: DiagHandler,
         mode: ResolveMode,
     ) -> ResolveResult<Self> {
-        let mut context = Self::new(root, search_paths, diag)?;
-        context.symbolize()?;
-        log::trace!("Symbolized Context:\n{context:?}");
+        Self::new(root, search_paths, diag)?.process(builtin, mode)
+    }
+
+    /// Symbolize loaded sources and run the stages up to `mode`.
+    fn process(mut self, builtin: Option<Symbol>, mode: ResolveMode) -> ResolveResult<Self> {
+        self.symbolize()?;
+        log::trace!("Symbolized Context:\n{self:?}");
         if let Some(builtin) = builtin {
             log::trace!("Added builtin library {id}.", id = builtin.id());
-            context.symbol_table.add_symbol(builtin)?;
+            self.symbol_table.add_symbol(builtin)?;
         }
         if matches!(mode, ResolveMode::Resolved | ResolveMode::Checked) {
-            context.resolve()?;
+            self.resolve()?;
             if matches!(mode, ResolveMode::Checked) {
-                context.check()?;
+                self.check()?;
             }
         }
-        Ok(context)
+        Ok(self)
     }
 
     #[cfg(test)]
@@ -265,6 +300,10 @@ impl Diag for ResolveContext {
         self.diag.pretty_print(f, self)
     }
 
+    fn fmt_diagnosis_json(&self, f: &mut dyn std::fmt::Write) -> std::fmt::Result {
+        self.diag.write_json(f, self)
+    }
+
     fn warning_count(&self) -> u32 {
         self.diag.error_count()
     }
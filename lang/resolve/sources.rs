@@ -39,6 +39,7 @@ impl Sources {
     /// Create source cache
     ///
     /// Inserts the `root` file and loads all files from `search_paths`.
+    /// Syntax trees of library files are shared with earlier loads (see [`SourceFile::load_library()`]).
     pub fn load(
         root: Rc<SourceFile>,
         search_paths: &[impl AsRef<std::path::Path>],
@@ -62,7 +63,7 @@ impl Sources {
         externals
             .iter()
             .try_for_each(|(name, path)| -> Result<(), ParseError> {
-                let source_file = SourceFile::load_with_name(path.clone(), name.clone())?;
+                let source_file = SourceFile::load_library(path.clone(), name.clone())?;
                 let index = source_files.len();
                 by_hash.insert(source_file.hash, index);
                 by_path.insert(source_file.filename(), index);
@@ -90,6 +91,37 @@ impl Sources {
         self.root.clone()
     }
 
+    /// Create a copy of this cache with a replaced root file.
+    ///
+    /// All other source files are shared and not loaded again.
+    pub fn with_root(&self, root: Rc<SourceFile>) -> Self {
+        let mut by_hash = self.by_hash.clone();
+        let mut by_path = self.by_path.clone();
+        let mut by_name = self.by_name.clone();
+        by_hash.remove(&self.root.hash);
+        by_path.remove(&self.root.filename());
+        by_name.remove(&self.root.name);
+        by_hash.insert(root.hash, 0);
+        by_path.insert(root.filename(), 0);
+        by_name.insert(root.name.clone(), 0);
+
+        let mut source_files = self.source_files.clone();
+        match source_files.first_mut() {
+            Some(first) => *first = root.clone(),
+            None => source_files.push(root.clone()),
+        }
+
+        Self {
+            externals: self.externals.clone(),
+            by_hash,
+            by_path,
+            by_name,
+            root,
+            source_files,
+            search_paths: self.search_paths.clone(),
+        }
+    }
+
     /// Insert a file to the sources.
     pub fn insert(&mut self, source_file: Rc<SourceFile>) {
         let index = self.source_files.len();
@@ -302,6 +302,11 @@ impl Symbol {
         f(&self.inner.borrow().def)
     }
 
+    /// Return a copy of the symbol definition.
+    pub fn definition(&self) -> SymbolDefinition {
+        self.inner.borrow().def.clone()
+    }
+
     /// Work with the mutable symbol definition.
     pub(crate) fn with_def_mut<T>(&self, mut f: impl FnMut(&mut SymbolDefinition) -> T) -> T {
         f(&mut self.inner.borrow_mut().def)
@@ -603,6 +608,17 @@ impl FullyQualify for Symbol {
     }
 }
 
+/// Source code reference of the definition (builtin symbols have none).
+impl SrcReferrer for Symbol {
+    fn src_ref(&self) -> SrcRef {
+        let inner = self.inner.borrow();
+        match &inner.def {
+            SymbolDefinition::Builtin(_) => SrcRef(None),
+            _ => inner.src_ref(),
+        }
+    }
+}
+
 impl Default for Symbol {
     fn default() -> Self {
         Self {
@@ -7,18 +7,24 @@
 //! therefore need to address a place in the code where they did appear.
 //! A bunch of structs from this module provide this functionality:
 //!
-//! - [`SrcRef`] boxes a [`SrcRefInner`] which itself includes all necessary reference
-//!   information like *line*/*column* and a hash to identify the source file.
+//! - [`SrcRef`] holds a [`SrcRefInner`] which itself includes the byte range and a [`FileId`]
+//!   to identify the source file. *Line*/*column* are computed on demand from a line index
+//!   of the source file (see [`FileId::register()`]).
 //! - [`Refer`] encapsulates any syntax element and puts a [`SrcRef`] beside it.
 //! - [`SrcReferrer`] is a trait which provides unified access to the [`SrcRef`]
 //!   (e.g. implemented by [`Refer`]).
+//! - [`Relocate`] is a trait to move source references after the source code has been edited.
 
 mod line_col;
 mod refer;
+mod relocate;
+mod source_map;
 mod src_referrer;
 
 pub use line_col::*;
 pub use refer::*;
+pub use relocate::*;
+pub use source_map::*;
 pub use src_referrer::*;
 
 use crate::parser::*;
@@ -27,42 +33,59 @@ use derive_more::Deref;
 /// Reference into a source file.
 ///
 /// *Hint*: Source file is not part of `SrcRef` and must be provided from outside
+///
+/// A `SrcRef` is twelve bytes which can be cloned without any allocation.
 #[derive(Clone, Default, Deref)]
-pub struct SrcRef(pub Option<Box<SrcRefInner>>);
+pub struct SrcRef(pub Option<SrcRefInner>);
 
 impl SrcRef {
     /// Create new `SrcRef`
     /// - `range`: Position in file
-    /// - `line`: Line number within file
-    /// - `col`: Column number within file
-    pub fn new(
-        range: std::ops::Range<usize>,
-        line: usize,
-        col: usize,
-        source_file_hash: u64,
-    ) -> Self {
-        Self(Some(Box::new(SrcRefInner {
-            range,
-            at: LineCol { line, col },
-            source_file_hash,
-        })))
+    /// - `file`: Source file
+    pub fn new(range: std::ops::Range<usize>, file: FileId) -> Self {
+        Self(Some(SrcRefInner {
+            file,
+            start: range.start as u32,
+            len: range.len() as u32,
+        }))
     }
 }
 /// A reference into the source code
-#[derive(Clone, Default)]
+#[derive(Clone, Copy)]
 pub struct SrcRefInner {
+    /// Source code file to map `SrcRef` -> `SourceFile`
+    pub file: FileId,
+    /// Start in bytes
+    pub start: u32,
+    /// Length in bytes
+    pub len: u32,
+}
+
+impl SrcRefInner {
     /// Range in bytes
-    pub range: std::ops::Range<usize>,
-    /// Line and column
-    pub at: LineCol,
+    pub fn range(&self) -> std::ops::Range<usize> {
+        self.start as usize..self.end() as usize
+    }
+
+    /// Line and column or `None` if the source code has not been registered.
+    pub fn at(&self) -> Option<LineCol> {
+        self.file.line_col(self.start as usize)
+    }
+
     /// Hash of the source code file to map `SrcRef` -> `SourceFile`
-    pub source_file_hash: u64,
+    pub fn source_file_hash(&self) -> u64 {
+        self.file.hash()
+    }
+
+    fn end(&self) -> u32 {
+        self.start + self.len
+    }
 }
 
 impl std::fmt::Display for SrcRef {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
-        match &self.0 {
-            Some(s) => write!(f, "{}", s.at),
+        match self.at() {
+            Some(at) => write!(f, "{at}"),
             _ => write!(f, crate::invalid_no_ansi!(REF)),
         }
     }
@@ -73,8 +96,10 @@ impl std::fmt::Debug for SrcRef {
         match &self.0 {
             Some(s) => write!(
                 f,
-                "{} ({}..{}) in {:#x}",
-                s.at, s.range.start, s.range.end, s.source_file_hash
+                "{self} ({}..{}) in {:#x}",
+                s.start,
+                s.end(),
+                s.source_file_hash()
             ),
             _ => write!(f, crate::invalid!(REF)),
         }
@@ -104,7 +129,7 @@ impl Ord for SrcRef {
 impl SrcRef {
     /// return length of `SrcRef`
     pub fn len(&self) -> usize {
-        self.0.as_ref().map(|s| s.range.len()).unwrap_or(0)
+        self.0.map(|s| s.len as usize).unwrap_or(0)
     }
 
     /// return true if code base is empty
@@ -119,12 +144,12 @@ impl SrcRef {
     ///
     /// This is used to map `SrcRef` -> `SourceFile`
     pub fn source_hash(&self) -> u64 {
-        self.0.as_ref().map(|s| s.source_file_hash).unwrap_or(0)
+        self.0.map(|s| s.source_file_hash()).unwrap_or(0)
     }
 
     /// Return slice to code base.
     pub fn source_slice<'a>(&self, src: &'a str) -> &'a str {
-        &src[self.0.as_ref().expect("SrcRef").range.to_owned()]
+        &src[self.0.expect("SrcRef").range()]
     }
 
     /// Merge two `SrcRef` into a single one.
@@ -136,24 +161,19 @@ impl SrcRef {
     pub fn merge(lhs: &impl SrcReferrer, rhs: &impl SrcReferrer) -> SrcRef {
         match (lhs.src_ref(), rhs.src_ref()) {
             (SrcRef(Some(lhs)), SrcRef(Some(rhs))) => {
-                if lhs.source_file_hash == rhs.source_file_hash {
-                    let source_file_hash = lhs.source_file_hash;
-
-                    if lhs.range.end > rhs.range.start || lhs.range.start > rhs.range.end {
+                if lhs.file == rhs.file {
+                    if lhs.end() > rhs.start || lhs.start > rhs.end() {
                         log::warn!("ranges not in correct order");
                         SrcRef(None)
                     } else {
-                        SrcRef(Some(Box::new(SrcRefInner {
-                            range: {
-                                // paranoia check
-                                assert!(lhs.range.end <= rhs.range.end);
-                                assert!(lhs.range.start <= rhs.range.start);
-
-                                lhs.range.start..rhs.range.end
-                            },
-                            at: lhs.at,
-                            source_file_hash,
-                        })))
+                        // paranoia check
+                        assert!(lhs.end() <= rhs.end());
+                        assert!(lhs.start <= rhs.start);
+
+                        SrcRef(Some(SrcRefInner {
+                            len: rhs.end() - lhs.start,
+                            ..lhs
+                        }))
                     }
                 } else {
                     log::warn!("references are not in the same file");
@@ -169,71 +189,66 @@ impl SrcRef {
     ///
     /// All  given source references must have the same hash otherwise panics!
     pub fn merge_all<S: SrcReferrer>(referrers: impl Iterator<Item = S>) -> SrcRef {
-        let mut result = SrcRef(None);
+        let mut result: Option<SrcRefInner> = None;
         for referrer in referrers {
             if let Some(src_ref) = referrer.src_ref().0 {
-                if let SrcRef(Some(result)) = &mut result {
-                    if result.source_file_hash != src_ref.source_file_hash {
+                if let Some(result) = &mut result {
+                    if result.file != src_ref.file {
                         panic!("can only merge source references of the same file");
                     }
-                    if src_ref.range.start < result.range.start {
-                        result.range.start = src_ref.range.start;
-                        result.at = src_ref.at;
-                    }
-                    result.range.end = std::cmp::max(src_ref.range.end, result.range.end);
+                    let end = std::cmp::max(src_ref.end(), result.end());
+                    result.start = std::cmp::min(src_ref.start, result.start);
+                    result.len = end - result.start;
                 } else {
-                    result = SrcRef(Some(src_ref));
+                    result = Some(src_ref);
                 }
             }
         }
-        result
+        SrcRef(result)
     }
 
     /// Return line and column in source code or `None` if not available.
     pub fn at(&self) -> Option<LineCol> {
-        self.0.as_ref().map(|s| s.at.clone())
+        self.0.and_then(|s| s.at())
     }
 }
 
 #[test]
 fn merge_all() {
-    use std::ops::Range;
-    assert_eq!(
-        SrcRef::merge_all(
-            [
-                SrcRef::new(Range { start: 5, end: 8 }, 1, 6, 123),
-                SrcRef::new(Range { start: 8, end: 10 }, 2, 1, 123),
-                SrcRef::new(Range { start: 12, end: 16 }, 3, 1, 123),
-                SrcRef::new(Range { start: 0, end: 10 }, 1, 1, 123),
-            ]
-            .iter(),
-        ),
-        SrcRef::new(Range { start: 0, end: 16 }, 1, 1, 123),
+    let file = FileId::from_hash(123);
+    let merged = SrcRef::merge_all(
+        [
+            SrcRef::new(5..8, file),
+            SrcRef::new(8..10, file),
+            SrcRef::new(12..16, file),
+            SrcRef::new(0..10, file),
+        ]
+        .iter(),
     );
+    assert_eq!(merged.0.map(|s| s.range()), Some(0..16));
+    assert_eq!(merged.source_hash(), 123);
+    assert_eq!(std::mem::size_of::<SrcRef>(), 12);
 }
 
 impl From<Pair<'_>> for SrcRef {
     fn from(pair: Pair) -> Self {
-        let (line, col) = pair.line_col();
-        Self::new(
-            pair.as_span().start()..pair.as_span().end(),
-            line,
-            col,
-            pair.source_hash(),
-        )
+        Self::new(pair.as_span().start()..pair.as_span().end(), pair.file())
     }
 }
 
 #[test]
 fn test_src_ref() {
     let input = "geo3d::Cube(size_x = 3.0, size_y = 3.0, size_z = 3.0);";
+    let registration = FileId::register(0xc0be, input);
+    let file = registration.id();
 
     let cube = 7..11;
     let size_y = 26..32;
 
-    let cube = SrcRef::new(cube, 1, 0, 0);
-    let size_y = SrcRef::new(size_y, 1, 0, 0);
+    let cube = SrcRef::new(cube, file);
+    let size_y = SrcRef::new(size_y, file);
 
     assert_eq!(cube.source_slice(input), "Cube");
     assert_eq!(size_y.source_slice(input), "size_y");
+    assert_eq!(size_y.to_string(), "1:27");
 }
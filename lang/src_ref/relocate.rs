@@ -0,0 +1,102 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Trait to move source references after the source code has been edited
+
+use crate::{rc::*, src_ref::*};
+
+/// Describes how source references move after an edit of the source code.
+///
+/// All references are moved into the new source file `file`.
+/// References starting at or behind byte offset `from` are moved by `bytes`.
+/// Line and column follow, because they are computed from the byte offset.
+#[derive(Clone, Debug)]
+pub struct Relocation {
+    /// Byte offset from which references will be moved.
+    pub from: usize,
+    /// Number of bytes to move.
+    pub bytes: isize,
+    /// New source file.
+    pub file: FileId,
+}
+
+impl Relocation {
+    /// Relocation which only changes the source file.
+    pub fn rehash(file: FileId) -> Self {
+        Self {
+            from: usize::MAX,
+            bytes: 0,
+            file,
+        }
+    }
+}
+
+/// Elements holding source code references which can be moved.
+pub trait Relocate {
+    /// Move all source code references within this element.
+    fn relocate(&mut self, relocation: &Relocation);
+}
+
+impl Relocate for SrcRef {
+    fn relocate(&mut self, relocation: &Relocation) {
+        if let Some(inner) = &mut self.0 {
+            inner.file = relocation.file;
+            if inner.start as usize >= relocation.from {
+                inner.start = (inner.start as usize).saturating_add_signed(relocation.bytes) as u32;
+            }
+        }
+    }
+}
+
+impl<T: Relocate> Relocate for Option<T> {
+    fn relocate(&mut self, relocation: &Relocation) {
+        if let Some(inner) = self {
+            inner.relocate(relocation)
+        }
+    }
+}
+
+impl<T: Relocate> Relocate for Vec<T> {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.iter_mut().for_each(|item| item.relocate(relocation))
+    }
+}
+
+impl<T: Relocate> Relocate for Box<T> {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.as_mut().relocate(relocation)
+    }
+}
+
+/// Shared elements will be cloned before they get moved.
+impl<T: Relocate + Clone> Relocate for Rc<T> {
+    fn relocate(&mut self, relocation: &Relocation) {
+        Rc::make_mut(self).relocate(relocation)
+    }
+}
+
+#[test]
+fn relocate_src_ref() {
+    let old = FileId::from_hash(0);
+    let registration = FileId::register(0x7e10c, "0123456789\nabcdefghijklmno\nopqrstuvwxyz");
+    let relocation = Relocation {
+        from: 10,
+        bytes: 3,
+        file: registration.id(),
+    };
+
+    // in front of the edit: hash only
+    let mut src_ref = SrcRef::new(0..5, old);
+    src_ref.relocate(&relocation);
+    assert_eq!(format!("{src_ref:?}"), "1:1 (0..5) in 0x7e10c");
+
+    // behind the edit
+    let mut src_ref = SrcRef::new(12..14, old);
+    src_ref.relocate(&relocation);
+    assert_eq!(format!("{src_ref:?}"), "2:5 (15..17) in 0x7e10c");
+
+    // following line
+    let mut src_ref = SrcRef::new(24..26, old);
+    src_ref.relocate(&relocation);
+    assert_eq!(format!("{src_ref:?}"), "3:1 (27..29) in 0x7e10c");
+}
@@ -0,0 +1,216 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Registry of source files to compute line and column of source references.
+
+use super::LineCol;
+use std::{
+    collections::HashMap,
+    sync::{LazyLock, RwLock, RwLockReadGuard, RwLockWriteGuard},
+};
+
+/// Identifies a source file (by its hash) within a [`SrcRef`](super::SrcRef).
+///
+/// Ids are interned process-wide.
+/// The line index of registered code is released together with the [`SourceRegistration`],
+/// then the id stays reserved, so that stale references cannot point into other code.
+#[derive(Clone, Copy, Debug, PartialEq, Eq, Hash)]
+pub struct FileId(std::num::NonZeroU32);
+
+/// Line index of a source file to map byte offsets to line and column.
+struct LineIndex {
+    /// Byte offsets of all line starts.
+    lines: Vec<u32>,
+    /// Byte offsets behind multi-byte characters, each with the number of extra bytes up to there.
+    wide: Vec<(u32, u32)>,
+}
+
+impl LineIndex {
+    fn new(source: &str) -> Self {
+        let mut lines = vec![0];
+        let mut wide = Vec::new();
+        let mut extra = 0;
+        for (pos, c) in source.char_indices() {
+            match c.len_utf8() {
+                1 if c == '\n' => lines.push(pos as u32 + 1),
+                1 => (),
+                len => {
+                    extra += len as u32 - 1;
+                    wide.push(((pos + len) as u32, extra));
+                }
+            }
+        }
+        Self { lines, wide }
+    }
+
+    /// Number of extra bytes of multi-byte characters in front of `offset`.
+    fn extra(&self, offset: u32) -> u32 {
+        match self.wide.partition_point(|(pos, _)| *pos <= offset) {
+            0 => 0,
+            n => self.wide[n - 1].1,
+        }
+    }
+
+    fn line_col(&self, offset: u32) -> LineCol {
+        let line = self.lines.partition_point(|start| *start <= offset);
+        let start = self.lines[line - 1];
+        LineCol {
+            line,
+            col: (offset - start - (self.extra(offset) - self.extra(start))) as usize + 1,
+        }
+    }
+}
+
+/// Registered source file.
+struct SourceEntry {
+    hash: u64,
+    /// Number of living registrations of the code.
+    owners: usize,
+    lines: Option<LineIndex>,
+}
+
+#[derive(Default)]
+struct SourceMap {
+    entries: Vec<SourceEntry>,
+    ids: HashMap<u64, FileId>,
+}
+
+impl SourceMap {
+    fn intern(&mut self, hash: u64) -> FileId {
+        if let Some(id) = self.ids.get(&hash) {
+            return *id;
+        }
+        self.entries.push(SourceEntry {
+            hash,
+            owners: 0,
+            lines: None,
+        });
+        let id = FileId(
+            std::num::NonZeroU32::new(self.entries.len() as u32).expect("too many source files"),
+        );
+        self.ids.insert(hash, id);
+        id
+    }
+
+    /// Drop a registration and the line index of its code if it was the last one.
+    fn release(&mut self, id: FileId) {
+        let entry = &mut self.entries[id.index()];
+        entry.owners -= 1;
+        if entry.owners == 0 && entry.hash != 0 {
+            entry.lines = None;
+            let hash = entry.hash;
+            self.ids.remove(&hash);
+        }
+    }
+}
+
+static SOURCE_MAP: LazyLock<RwLock<SourceMap>> = LazyLock::new(Default::default);
+
+fn read() -> RwLockReadGuard<'static, SourceMap> {
+    SOURCE_MAP.read().unwrap_or_else(|err| err.into_inner())
+}
+
+fn write() -> RwLockWriteGuard<'static, SourceMap> {
+    SOURCE_MAP.write().unwrap_or_else(|err| err.into_inner())
+}
+
+impl FileId {
+    /// Get the id of the source file with the given hash.
+    pub fn from_hash(hash: u64) -> Self {
+        let id = read().ids.get(&hash).copied();
+        id.unwrap_or_else(|| write().intern(hash))
+    }
+
+    /// Register the code of a source file, so that line and column of references into it can
+    /// be computed as long as the returned registration or one of its clones is alive.
+    ///
+    /// Code with hash `0` (snippets parsed without a source file) is not registered.
+    pub fn register(hash: u64, source: &str) -> SourceRegistration {
+        let mut map = write();
+        let id = map.intern(hash);
+        let entry = &mut map.entries[id.index()];
+        entry.owners += 1;
+        if hash != 0 && entry.lines.is_none() {
+            entry.lines = Some(LineIndex::new(source));
+        }
+        SourceRegistration(id)
+    }
+
+    /// Hash of the source code.
+    pub fn hash(self) -> u64 {
+        read().entries[self.index()].hash
+    }
+
+    /// Line and column of a byte `offset` or `None` if the code has not been registered.
+    pub fn line_col(self, offset: usize) -> Option<LineCol> {
+        read().entries[self.index()]
+            .lines
+            .as_ref()
+            .map(|lines| lines.line_col(offset as u32))
+    }
+
+    fn index(self) -> usize {
+        self.0.get() as usize - 1
+    }
+}
+
+/// Registration of the code of a source file (see [`FileId::register()`]).
+///
+/// The line index of the code is dropped with the last clone of the registration.
+#[derive(Debug, PartialEq, Eq)]
+pub struct SourceRegistration(FileId);
+
+impl SourceRegistration {
+    /// Id of the registered source file.
+    pub fn id(&self) -> FileId {
+        self.0
+    }
+}
+
+impl Clone for SourceRegistration {
+    fn clone(&self) -> Self {
+        write().entries[self.0.index()].owners += 1;
+        Self(self.0)
+    }
+}
+
+impl Drop for SourceRegistration {
+    fn drop(&mut self) {
+        write().release(self.0);
+    }
+}
+
+#[test]
+fn line_index() {
+    let source = "a = 1;\n// µ-meter\nb = µ;";
+    let registration = FileId::register(0x5eed, source);
+    let file = registration.id();
+    assert_eq!(FileId::from_hash(0x5eed), file);
+    assert_eq!(file.hash(), 0x5eed);
+
+    let at = |pattern: &str| {
+        let line_col = file.line_col(source.find(pattern).expect("pattern"));
+        line_col.map(|at| (at.line, at.col))
+    };
+    assert_eq!(at("a"), Some((1, 1)));
+    assert_eq!(at("-meter"), Some((2, 5)));
+    assert_eq!(at("b"), Some((3, 1)));
+    assert_eq!(at(";").map(|(line, _)| line), Some(1));
+    assert_eq!(
+        file.line_col(source.len()).map(|at| (at.line, at.col)),
+        Some((3, 7))
+    );
+
+    assert_eq!(
+        FileId::register(0, "x").id().line_col(0).map(|at| at.line),
+        None
+    );
+
+    // the line index lives as long as any registration of the code
+    let clone = registration.clone();
+    drop(registration);
+    assert!(file.line_col(0).is_some());
+    drop(clone);
+    assert!(file.line_col(0).is_none());
+    assert_ne!(FileId::from_hash(0x5eed), file);
+}
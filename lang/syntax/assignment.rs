@@ -57,6 +57,15 @@ impl SrcReferrer for Assignment {
     }
 }
 
+impl Relocate for Assignment {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.id.relocate(relocation);
+        self.specified_type.relocate(relocation);
+        self.expression.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for Assignment {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         match &self.specified_type {
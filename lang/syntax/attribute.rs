@@ -75,6 +75,18 @@ impl SrcReferrer for AttributeCommand {
     }
 }
 
+impl Relocate for AttributeCommand {
+    fn relocate(&mut self, relocation: &Relocation) {
+        match self {
+            AttributeCommand::Call(id, argument_list) => {
+                id.relocate(relocation);
+                argument_list.relocate(relocation);
+            }
+            AttributeCommand::Expression(expression) => expression.relocate(relocation),
+        }
+    }
+}
+
 /// An attribute item.
 #[derive(Clone)]
 pub struct Attribute {
@@ -139,6 +151,14 @@ impl SrcReferrer for Attribute {
     }
 }
 
+impl Relocate for Attribute {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.id.relocate(relocation);
+        self.commands.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 /// A list of attributes, e.g. `#foo #[bar, baz = 42]`
 #[derive(Clone, Default, Deref, DerefMut)]
 pub struct AttributeList(Vec<Attribute>);
@@ -167,3 +187,9 @@ impl SrcReferrer for AttributeList {
         }
     }
 }
+
+impl Relocate for AttributeList {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.0.relocate(relocation)
+    }
+}
@@ -23,6 +23,13 @@ impl SrcReferrer for Body {
     }
 }
 
+impl Relocate for Body {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.statements.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for Body {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         writeln!(f, " {{")?;
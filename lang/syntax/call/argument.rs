@@ -32,6 +32,14 @@ impl SrcReferrer for Argument {
     }
 }
 
+impl Relocate for Argument {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.id.relocate(relocation);
+        self.expression.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl OrdMapValue<Identifier> for Argument {
     fn key(&self) -> Option<Identifier> {
         self.id.clone()
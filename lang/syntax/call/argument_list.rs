@@ -16,6 +16,16 @@ impl SrcReferrer for ArgumentList {
     }
 }
 
+impl Relocate for ArgumentList {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.0
+            .value
+            .iter_mut()
+            .for_each(|argument| argument.relocate(relocation));
+        self.0.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for ArgumentList {
     fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
         write!(f, "{}", {
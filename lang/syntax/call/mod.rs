@@ -40,6 +40,14 @@ impl SrcReferrer for Call {
     }
 }
 
+impl Relocate for Call {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.name.relocate(relocation);
+        self.argument_list.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for Call {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         write!(f, "{}({})", self.name, self.argument_list)
@@ -20,6 +20,12 @@ impl SrcReferrer for DocBlock {
     }
 }
 
+impl Relocate for DocBlock {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.src_ref.relocate(relocation)
+    }
+}
+
 impl std::fmt::Display for DocBlock {
     fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
         self.lines
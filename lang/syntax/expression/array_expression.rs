@@ -76,6 +76,15 @@ impl SrcReferrer for ArrayExpressionInner {
     }
 }
 
+impl Relocate for ArrayExpressionInner {
+    fn relocate(&mut self, relocation: &Relocation) {
+        match self {
+            ArrayExpressionInner::List(expressions) => expressions.relocate(relocation),
+            ArrayExpressionInner::Range(range) => range.relocate(relocation),
+        }
+    }
+}
+
 impl TreeDisplay for ArrayExpressionInner {
     fn tree_print(&self, f: &mut std::fmt::Formatter, mut depth: TreeState) -> std::fmt::Result {
         match &self {
@@ -110,6 +119,13 @@ impl SrcReferrer for ArrayExpression {
     }
 }
 
+impl Relocate for ArrayExpression {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.inner.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for ArrayExpression {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         write!(f, "[{}]{}", self.inner, self.unit)
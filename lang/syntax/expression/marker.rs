@@ -27,6 +27,13 @@ impl SrcReferrer for Marker {
     }
 }
 
+impl Relocate for Marker {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.id.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for Marker {
     fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
         write!(f, "@{}", self.id)
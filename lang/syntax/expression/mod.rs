@@ -81,6 +81,18 @@ impl Expression {
             _ => None,
         }
     }
+
+    /// Return `true` if the expression consists of literals only, e.g. `-2 * 3mm`.
+    ///
+    /// The value of a constant expression does not depend on the context it is evaluated in.
+    pub fn is_constant(&self) -> bool {
+        match self {
+            Self::Literal(_) => true,
+            Self::UnaryOp { rhs, .. } => rhs.is_constant(),
+            Self::BinaryOp { lhs, rhs, .. } => lhs.is_constant() && rhs.is_constant(),
+            _ => false,
+        }
+    }
 }
 
 impl SrcReferrer for Expression {
@@ -114,6 +126,48 @@ impl SrcReferrer for Expression {
     }
 }
 
+impl Relocate for Expression {
+    fn relocate(&mut self, relocation: &Relocation) {
+        match self {
+            Self::Invalid => (),
+            Self::Literal(l) => l.relocate(relocation),
+            Self::FormatString(fs) => fs.relocate(relocation),
+            Self::ArrayExpression(ae) => ae.relocate(relocation),
+            Self::TupleExpression(te) => te.relocate(relocation),
+            Self::Body(b) => b.relocate(relocation),
+            Self::Call(c) => c.relocate(relocation),
+            Self::QualifiedName(q) => q.relocate(relocation),
+            Self::Marker(m) => m.relocate(relocation),
+            Self::BinaryOp {
+                lhs, rhs, src_ref, ..
+            } => {
+                lhs.relocate(relocation);
+                rhs.relocate(relocation);
+                src_ref.relocate(relocation);
+            }
+            Self::UnaryOp { rhs, src_ref, .. } => {
+                rhs.relocate(relocation);
+                src_ref.relocate(relocation);
+            }
+            Self::ArrayElementAccess(lhs, rhs, src_ref) => {
+                lhs.relocate(relocation);
+                rhs.relocate(relocation);
+                src_ref.relocate(relocation);
+            }
+            Self::PropertyAccess(lhs, id, src_ref) | Self::AttributeAccess(lhs, id, src_ref) => {
+                lhs.relocate(relocation);
+                id.relocate(relocation);
+                src_ref.relocate(relocation);
+            }
+            Self::MethodCall(lhs, method_call, src_ref) => {
+                lhs.relocate(relocation);
+                method_call.relocate(relocation);
+                src_ref.relocate(relocation);
+            }
+        }
+    }
+}
+
 impl std::fmt::Display for Expression {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         match self {
@@ -84,6 +84,14 @@ impl SrcReferrer for RangeExpression {
     }
 }
 
+impl Relocate for RangeExpression {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.first.0.relocate(relocation);
+        self.last.0.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for RangeExpression {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         write!(f, "{}..{}", self.first, self.last)
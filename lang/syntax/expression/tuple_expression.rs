@@ -20,6 +20,13 @@ impl SrcReferrer for TupleExpression {
     }
 }
 
+impl Relocate for TupleExpression {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.args.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for TupleExpression {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         write!(
@@ -54,6 +54,14 @@ impl SrcReferrer for FormatExpression {
     }
 }
 
+impl Relocate for FormatExpression {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.spec.relocate(relocation);
+        self.expression.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl TreeDisplay for FormatExpression {
     fn tree_print(&self, f: &mut std::fmt::Formatter, mut depth: TreeState) -> std::fmt::Result {
         writeln!(f, "{:depth$}FormatExpression:", "")?;
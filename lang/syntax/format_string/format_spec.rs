@@ -22,6 +22,12 @@ impl SrcReferrer for FormatSpec {
     }
 }
 
+impl Relocate for FormatSpec {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.src_ref.relocate(relocation)
+    }
+}
+
 impl std::fmt::Display for FormatSpec {
     fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
         match (self.width, self.precision) {
@@ -29,6 +29,15 @@ impl SrcReferrer for FormatStringInner {
     }
 }
 
+impl Relocate for FormatStringInner {
+    fn relocate(&mut self, relocation: &Relocation) {
+        match self {
+            FormatStringInner::String(s) => s.src_ref.relocate(relocation),
+            FormatStringInner::FormatExpression(e) => e.relocate(relocation),
+        }
+    }
+}
+
 /// Format string.
 #[derive(Default, Clone, PartialEq)]
 pub struct FormatString(pub Refer<Vec<FormatStringInner>>);
@@ -57,6 +66,13 @@ impl SrcReferrer for FormatString {
     }
 }
 
+impl Relocate for FormatString {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.0.value.relocate(relocation);
+        self.0.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for FormatString {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         write!(f, r#"""#)?;
@@ -26,6 +26,15 @@ impl SrcReferrer for FunctionDefinition {
     }
 }
 
+impl Relocate for FunctionDefinition {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.id.relocate(relocation);
+        self.signature.relocate(relocation);
+        self.body.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl TreeDisplay for FunctionDefinition {
     fn tree_print(&self, f: &mut std::fmt::Formatter, mut depth: TreeState) -> std::fmt::Result {
         writeln!(f, "{:depth$}FunctionDefinition '{}':", "", self.id)?;
@@ -22,6 +22,14 @@ impl SrcReferrer for FunctionSignature {
     }
 }
 
+impl Relocate for FunctionSignature {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.parameters.relocate(relocation);
+        self.return_type.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl FunctionSignature {
     /// Get parameter by name
     pub fn parameter_by_name(&self, name: &Identifier) -> Option<&Parameter> {
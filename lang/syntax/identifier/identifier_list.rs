@@ -24,6 +24,13 @@ impl SrcReferrer for IdentifierList {
     }
 }
 
+impl Relocate for IdentifierList {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.0.value.relocate(relocation);
+        self.0.src_ref.relocate(relocation);
+    }
+}
+
 impl FromIterator<Identifier> for IdentifierList {
     fn from_iter<T: IntoIterator<Item = Identifier>>(iter: T) -> Self {
         let v: Vec<_> = iter.into_iter().collect();
@@ -147,6 +147,12 @@ impl SrcReferrer for Identifier {
     }
 }
 
+impl Relocate for Identifier {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.0.src_ref.relocate(relocation)
+    }
+}
+
 impl std::hash::Hash for Identifier {
     fn hash<H: std::hash::Hasher>(&self, hasher: &mut H) {
         self.0.hash(hasher)
@@ -253,7 +259,10 @@ fn identifier_comparison() {
 
     // same id but different src refs
     let id1 = Identifier::no_ref("x");
-    let id2 = Identifier(Refer::new("x".into(), SrcRef::new(0..5, 0, 1, 1)));
+    let id2 = Identifier(Refer::new(
+        "x".into(),
+        SrcRef::new(0..5, FileId::from_hash(1)),
+    ));
 
     // shall be equal
     assert!(id1 == id2);
@@ -266,7 +275,10 @@ fn identifier_hash() {
 
     // same id but different src refs
     let id1 = Identifier(Refer::none("x".into()));
-    let id2 = Identifier(Refer::new("x".into(), SrcRef::new(0..5, 0, 1, 1)));
+    let id2 = Identifier(Refer::new(
+        "x".into(),
+        SrcRef::new(0..5, FileId::from_hash(1)),
+    ));
 
     let mut hasher = std::hash::DefaultHasher::new();
     id1.hash(&mut hasher);
@@ -244,6 +244,13 @@ impl SrcReferrer for QualifiedName {
     }
 }
 
+impl Relocate for QualifiedName {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.0.value.relocate(relocation);
+        self.0.src_ref.relocate(relocation);
+    }
+}
+
 impl From<Refer<Vec<Identifier>>> for QualifiedName {
     fn from(value: Refer<Vec<Identifier>>) -> Self {
         Self(value)
@@ -30,6 +30,14 @@ impl SrcReferrer for InitDefinition {
     }
 }
 
+impl Relocate for InitDefinition {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.parameters.relocate(relocation);
+        self.body.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for InitDefinition {
     fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
         write!(f, "init({parameters}) ", parameters = self.parameters)?;
@@ -43,6 +43,16 @@ impl SrcReferrer for Literal {
     }
 }
 
+impl Relocate for Literal {
+    fn relocate(&mut self, relocation: &Relocation) {
+        match self {
+            Literal::Number(n) => n.relocate(relocation),
+            Literal::Integer(i) => i.src_ref.relocate(relocation),
+            Literal::Bool(b) => b.src_ref.relocate(relocation),
+        }
+    }
+}
+
 impl crate::ty::Ty for Literal {
     fn ty(&self) -> Type {
         match self {
@@ -43,6 +43,12 @@ impl SrcReferrer for NumberLiteral {
     }
 }
 
+impl Relocate for NumberLiteral {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.2.relocate(relocation)
+    }
+}
+
 impl std::fmt::Display for NumberLiteral {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         write!(f, "{}{}", self.0, self.1)
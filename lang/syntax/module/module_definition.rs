@@ -35,6 +35,14 @@ impl SrcReferrer for ModuleDefinition {
     }
 }
 
+impl Relocate for ModuleDefinition {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.id.relocate(relocation);
+        self.body.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl TreeDisplay for ModuleDefinition {
     fn tree_print(&self, f: &mut std::fmt::Formatter, mut depth: TreeState) -> std::fmt::Result {
         if let Some(body) = &self.body {
@@ -84,6 +84,15 @@ impl SrcReferrer for Parameter {
     }
 }
 
+impl Relocate for Parameter {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.id.relocate(relocation);
+        self.specified_type.relocate(relocation);
+        self.default_value.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl OrdMapValue<Identifier> for Parameter {
     fn key(&self) -> Option<Identifier> {
         Some(self.id.clone())
@@ -20,6 +20,15 @@ impl ParameterList {
     pub fn contains_key(&self, id: &Identifier) -> bool {
         self.iter().any(|p| *id == p.id)
     }
+
+    /// Return `true` if all default values are constant expressions.
+    pub fn is_constant(&self) -> bool {
+        self.iter().all(|p| {
+            p.default_value
+                .as_ref()
+                .is_none_or(|expression| expression.is_constant())
+        })
+    }
 }
 
 impl SrcReferrer for ParameterList {
@@ -28,6 +37,16 @@ impl SrcReferrer for ParameterList {
     }
 }
 
+impl Relocate for ParameterList {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.0
+            .value
+            .iter_mut()
+            .for_each(|parameter| parameter.relocate(relocation));
+        self.0.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for ParameterList {
     fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
         write!(
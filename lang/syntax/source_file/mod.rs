@@ -22,18 +22,40 @@ pub struct SourceFile {
     /// This hash is calculated from the source code itself
     /// This is used to map `SrcRef` -> `SourceFile`
     pub hash: u64,
+
+    /// Keeps line and column of references into the source code computable while this
+    /// source file is alive.
+    registration: Option<SourceRegistration>,
 }
 
 impl SourceFile {
     /// Create new source file from existing source.
+    ///
+    /// The source code is registered to compute line and column of source references.
     pub fn new(statements: StatementList, source: String, hash: u64) -> Self {
         Self {
             statements,
+            registration: Some(FileId::register(hash, &source)),
             source,
             hash,
             ..Default::default()
         }
     }
+
+    /// Create a new version of this source file with changed source code.
+    ///
+    /// Name and file name are taken from this source file.
+    pub fn with_source(&self, statements: StatementList, source: String, hash: u64) -> Self {
+        Self {
+            name: self.name.clone(),
+            statements,
+            filename: self.filename.clone(),
+            registration: Some(FileId::register(hash, &source)),
+            source,
+            hash,
+        }
+    }
+
     /// Return filename of loaded file or `<no file>`
     pub fn filename(&self) -> std::path::PathBuf {
         self.filename
@@ -110,7 +132,7 @@ impl TreeDisplay for SourceFile {
 
 impl SrcReferrer for SourceFile {
     fn src_ref(&self) -> crate::src_ref::SrcRef {
-        SrcRef::new(0..self.num_lines(), 0, 0, self.hash)
+        SrcRef::new(0..self.source.len(), FileId::from_hash(self.hash))
     }
 }
 
@@ -22,6 +22,14 @@ impl SrcReferrer for AssignmentStatement {
     }
 }
 
+impl Relocate for AssignmentStatement {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.attribute_list.relocate(relocation);
+        self.assignment.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl TreeDisplay for AssignmentStatement {
     fn tree_print(&self, f: &mut std::fmt::Formatter, depth: TreeState) -> std::fmt::Result {
         writeln!(f, "{:depth$}Assignment {}", "", self.assignment)
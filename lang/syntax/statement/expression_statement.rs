@@ -22,6 +22,14 @@ impl SrcReferrer for ExpressionStatement {
     }
 }
 
+impl Relocate for ExpressionStatement {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.attribute_list.relocate(relocation);
+        self.expression.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl TreeDisplay for ExpressionStatement {
     fn tree_print(&self, f: &mut std::fmt::Formatter, depth: TreeState) -> std::fmt::Result {
         self.expression.tree_print(f, depth)
@@ -26,6 +26,16 @@ impl SrcReferrer for IfStatement {
     }
 }
 
+impl Relocate for IfStatement {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.cond.relocate(relocation);
+        self.body.relocate(relocation);
+        self.body_else.relocate(relocation);
+        self.next_if.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for IfStatement {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         writeln!(f, "if {cond} {body}", cond = self.cond, body = self.body)?;
@@ -63,6 +63,25 @@ impl SrcReferrer for Statement {
     }
 }
 
+impl Relocate for Statement {
+    fn relocate(&mut self, relocation: &Relocation) {
+        match self {
+            Self::Workbench(w) => w.relocate(relocation),
+            Self::Module(m) => m.relocate(relocation),
+            Self::Function(fd) => fd.relocate(relocation),
+            Self::Init(mid) => mid.relocate(relocation),
+
+            Self::Use(us) => us.relocate(relocation),
+            Self::Return(r) => r.relocate(relocation),
+            Self::If(i) => i.relocate(relocation),
+            Self::InnerAttribute(i) => i.relocate(relocation),
+
+            Self::Assignment(a) => a.relocate(relocation),
+            Self::Expression(e) => e.relocate(relocation),
+        }
+    }
+}
+
 impl std::fmt::Display for Statement {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         match self {
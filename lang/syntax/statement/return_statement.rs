@@ -20,6 +20,13 @@ impl SrcReferrer for ReturnStatement {
     }
 }
 
+impl Relocate for ReturnStatement {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.result.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for ReturnStatement {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         if let Some(result) = &self.result {
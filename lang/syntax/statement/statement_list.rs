@@ -37,3 +37,9 @@ impl SrcReferrer for StatementList {
         }
     }
 }
+
+impl Relocate for StatementList {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.0.relocate(relocation)
+    }
+}
@@ -15,6 +15,12 @@ impl SrcReferrer for TypeAnnotation {
     }
 }
 
+impl Relocate for TypeAnnotation {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.0.src_ref.relocate(relocation)
+    }
+}
+
 impl std::fmt::Display for TypeAnnotation {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         self.0.fmt(f)
@@ -37,6 +37,18 @@ impl SrcReferrer for UseDeclaration {
     }
 }
 
+impl Relocate for UseDeclaration {
+    fn relocate(&mut self, relocation: &Relocation) {
+        match self {
+            Self::Use(name) | Self::UseAll(name) => name.relocate(relocation),
+            Self::UseAlias(name, id) => {
+                name.relocate(relocation);
+                id.relocate(relocation);
+            }
+        }
+    }
+}
+
 impl std::fmt::Display for UseDeclaration {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         match self {
@@ -27,6 +27,13 @@ impl SrcReferrer for UseStatement {
     }
 }
 
+impl Relocate for UseStatement {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.decl.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for UseStatement {
     fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
         match &self.visibility {
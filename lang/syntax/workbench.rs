@@ -76,6 +76,18 @@ impl SrcReferrer for WorkbenchDefinition {
     }
 }
 
+impl Relocate for WorkbenchDefinition {
+    fn relocate(&mut self, relocation: &Relocation) {
+        self.doc.relocate(relocation);
+        self.attribute_list.relocate(relocation);
+        self.kind.src_ref.relocate(relocation);
+        self.id.relocate(relocation);
+        self.plan.relocate(relocation);
+        self.body.relocate(relocation);
+        self.src_ref.relocate(relocation);
+    }
+}
+
 impl std::fmt::Display for WorkbenchDefinition {
     fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
         write!(
@@ -0,0 +1,182 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Structured tracing spans.
+//!
+//! Spans measure the duration of the processing stages (parse, resolve, eval, render and export).
+//! Recording is disabled by default, then a span costs a single atomic load and its name is never
+//! formatted.
+//! After [`enable()`], all finished spans of all threads are recorded and can be written into a file
+//! in *Chrome trace event format* with [`write_chrome_trace()`], which can be viewed with
+//! `chrome://tracing` or [Perfetto](https://ui.perfetto.dev).
+//! Only the most recent [`MAX_EVENTS`] spans are kept, so that long-running processes like a
+//! language server do not grow without bounds.
+
+use std::{
+    collections::VecDeque,
+    sync::{
+        Mutex, OnceLock,
+        atomic::{AtomicBool, AtomicU64, Ordering},
+    },
+    time::{Duration, Instant},
+};
+
+/// Maximum number of recorded spans which have not been written yet.
+pub const MAX_EVENTS: usize = 1 << 20;
+
+static ENABLED: AtomicBool = AtomicBool::new(false);
+static EPOCH: OnceLock<Instant> = OnceLock::new();
+static EVENTS: Mutex<VecDeque<Event>> = Mutex::new(VecDeque::new());
+static NEXT_THREAD_ID: AtomicU64 = AtomicU64::new(0);
+
+thread_local! {
+    static THREAD_ID: u64 = NEXT_THREAD_ID.fetch_add(1, Ordering::Relaxed);
+}
+
+/// Begin a [`Span`] with a category and a name which is formatted only if tracing is enabled.
+///
+/// The span ends when the returned value is dropped:
+///
+/// ```
+/// let _span = microcad_lang::trace_span!("eval", "call {}", "foo");
+/// ```
+#[macro_export]
+macro_rules! trace_span {
+    ($category:literal, $($arg:tt)*) => {
+        $crate::trace::Span::begin($category, || format!($($arg)*))
+    };
+}
+
+/// Finished span.
+struct Event {
+    category: &'static str,
+    name: String,
+    start: Duration,
+    duration: Duration,
+    thread: u64,
+}
+
+/// Start recording spans.
+pub fn enable() {
+    EPOCH.get_or_init(Instant::now);
+    ENABLED.store(true, Ordering::Relaxed);
+}
+
+/// Stop recording spans. Recorded spans are kept.
+pub fn disable() {
+    ENABLED.store(false, Ordering::Relaxed);
+}
+
+/// Return `true` if spans are recorded.
+pub fn is_enabled() -> bool {
+    ENABLED.load(Ordering::Relaxed)
+}
+
+/// A running span which is recorded when it is dropped.
+pub struct Span {
+    category: &'static str,
+    name: String,
+    start: Instant,
+}
+
+impl Span {
+    /// Begin a span if tracing is enabled.
+    ///
+    /// `name` is only called when tracing is enabled.
+    pub fn begin(category: &'static str, name: impl FnOnce() -> String) -> Option<Self> {
+        is_enabled().then(|| Self {
+            category,
+            name: name(),
+            start: Instant::now(),
+        })
+    }
+}
+
+impl Drop for Span {
+    fn drop(&mut self) {
+        let event = Event {
+            category: self.category,
+            name: std::mem::take(&mut self.name),
+            start: self
+                .start
+                .saturating_duration_since(*EPOCH.get_or_init(Instant::now)),
+            duration: self.start.elapsed(),
+            thread: THREAD_ID.with(|id| *id),
+        };
+        if let Ok(mut events) = EVENTS.lock() {
+            if events.len() >= MAX_EVENTS {
+                events.pop_front();
+            }
+            events.push_back(event);
+        }
+    }
+}
+
+/// Write all spans recorded so far into a file in Chrome trace event format.
+///
+/// The written spans are removed from the record.
+pub fn write_chrome_trace(path: impl AsRef<std::path::Path>) -> std::io::Result<()> {
+    use std::io::Write;
+
+    let events = match EVENTS.lock() {
+        Ok(mut events) => std::mem::take(&mut *events),
+        Err(_) => VecDeque::new(),
+    };
+
+    let mut file = std::io::BufWriter::new(std::fs::File::create(path)?);
+    write!(file, "{{\"traceEvents\":[")?;
+    for (n, event) in events.iter().enumerate() {
+        if n > 0 {
+            writeln!(file, ",")?;
+        }
+        write!(
+            file,
+            "{{\"name\":\"{name}\",\"cat\":\"{category}\",\"ph\":\"X\",\"ts\":{ts},\"dur\":{dur},\"pid\":{pid},\"tid\":{tid}}}",
+            name = escape_json(&event.name),
+            category = event.category,
+            ts = event.start.as_secs_f64() * 1e6,
+            dur = event.duration.as_secs_f64() * 1e6,
+            pid = std::process::id(),
+            tid = event.thread,
+        )?;
+    }
+    writeln!(file, "],\"displayTimeUnit\":\"ms\"}}")?;
+    file.flush()
+}
+
+/// Escape a string for a JSON string literal.
+pub(crate) fn escape_json(s: &str) -> String {
+    let mut escaped = String::with_capacity(s.len());
+    for c in s.chars() {
+        match c {
+            '"' => escaped.push_str("\\\""),
+            '\\' => escaped.push_str("\\\\"),
+            '\n' => escaped.push_str("\\n"),
+            '\r' => escaped.push_str("\\r"),
+            '\t' => escaped.push_str("\\t"),
+            c if (c as u32) < 0x20 => escaped.push_str(&format!("\\u{:04x}", c as u32)),
+            c => escaped.push(c),
+        }
+    }
+    escaped
+}
+
+#[test]
+fn chrome_trace() {
+    let enabled = is_enabled();
+    enable();
+    {
+        let _span = trace_span!("test", "span \"{}\"", 1);
+    }
+    if !enabled {
+        disable();
+    }
+    let path = std::env::temp_dir().join(format!("chrome_trace_{}.json", std::process::id()));
+    write_chrome_trace(&path).expect("trace file");
+
+    let trace = std::fs::read_to_string(&path).expect("trace file");
+    assert!(trace.starts_with("{\"traceEvents\":["));
+    assert!(trace.contains("\"name\":\"span \\\"1\\\"\",\"cat\":\"test\",\"ph\":\"X\""));
+
+    let _ = std::fs::remove_file(&path);
+}
@@ -4,15 +4,139 @@
 //! Typed list of values evaluation entity
 
 use crate::{ty::*, value::*};
-use derive_more::{Deref, DerefMut};
+use microcad_core::{Integer, Scalar};
+
+/// Storage of the array items.
+///
+/// Arrays of integers or of quantities with the same quantity type are stored packed,
+/// so that element-wise arithmetic runs on plain numbers without unit checks per element.
+/// Ranges stay lazy sequences until they are iterated.
+#[derive(Clone)]
+enum Items {
+    /// Values of any type.
+    Values(ValueList),
+    /// Packed integers.
+    Integers(Vec<Integer>),
+    /// Packed quantities of one quantity type.
+    Scalars(QuantityType, Vec<Scalar>),
+    /// Lazy integer sequence.
+    IntegerRange(Sequence<Integer>),
+    /// Lazy sequence of quantities of one quantity type.
+    ScalarRange(QuantityType, Sequence<Scalar>),
+}
+
+impl Items {
+    /// Compute the items of a divided scalar sequence.
+    ///
+    /// Each item of `[0..10] / 10` is rounded once by the division, like an item of a
+    /// materialized list. Adding, multiplying or dividing lazily would round differently than
+    /// the same operation on the materialized items, e.g. for `[0..10] / 10 * 3`.
+    /// Negation is exact and keeps the sequence lazy.
+    fn materialize_divided(self) -> Self {
+        match self {
+            Items::ScalarRange(quantity_type, sequence) if sequence.is_divided() => {
+                Items::Scalars(quantity_type, sequence.iter().collect())
+            }
+            items => items,
+        }
+    }
+
+    /// Pack values if all of them are integers or quantities of type `ty`.
+    fn pack(values: ValueList, ty: &Type) -> Self {
+        match ty {
+            Type::Integer => {
+                let integers = values
+                    .iter()
+                    .map(|value| match value {
+                        Value::Integer(i) => Some(*i),
+                        _ => None,
+                    })
+                    .collect::<Option<Vec<_>>>();
+                if let Some(integers) = integers {
+                    return Self::Integers(integers);
+                }
+            }
+            Type::Quantity(quantity_type) => {
+                let scalars = values
+                    .iter()
+                    .map(|value| match value {
+                        Value::Quantity(q) if q.quantity_type == *quantity_type => Some(q.value),
+                        _ => None,
+                    })
+                    .collect::<Option<Vec<_>>>();
+                if let Some(scalars) = scalars {
+                    return Self::Scalars(quantity_type.clone(), scalars);
+                }
+            }
+            _ => {}
+        }
+        Self::Values(values)
+    }
+
+    fn len(&self) -> usize {
+        match self {
+            Items::Values(values) => values.len(),
+            Items::Integers(integers) => integers.len(),
+            Items::Scalars(_, scalars) => scalars.len(),
+            Items::IntegerRange(sequence) => sequence.len,
+            Items::ScalarRange(_, sequence) => sequence.len,
+        }
+    }
+
+    fn get(&self, index: usize) -> Option<Value> {
+        match self {
+            Items::Values(values) => values.get(index).cloned(),
+            Items::Integers(integers) => integers.get(index).map(|i| Value::Integer(*i)),
+            Items::Scalars(quantity_type, scalars) => scalars
+                .get(index)
+                .map(|value| Value::Quantity(Quantity::new(*value, quantity_type.clone()))),
+            Items::IntegerRange(sequence) => sequence.get(index).map(Value::Integer),
+            Items::ScalarRange(quantity_type, sequence) => sequence
+                .get(index)
+                .map(|value| Value::Quantity(Quantity::new(value, quantity_type.clone()))),
+        }
+    }
+
+    /// Turn lazy sequences into packed items.
+    fn materialize(self) -> Self {
+        match self {
+            Items::IntegerRange(sequence) => Items::Integers(sequence.iter().collect()),
+            Items::ScalarRange(quantity_type, sequence) => {
+                Items::Scalars(quantity_type, sequence.iter().collect())
+            }
+            items => items,
+        }
+    }
+
+    fn into_values(self) -> ValueList {
+        match self.materialize() {
+            Items::Values(values) => values,
+            Items::Integers(integers) => integers.into_iter().map(Value::Integer).collect(),
+            Items::Scalars(quantity_type, scalars) => scalars
+                .into_iter()
+                .map(|value| Value::Quantity(Quantity::new(value, quantity_type.clone())))
+                .collect(),
+            Items::IntegerRange(_) | Items::ScalarRange(..) => unreachable!(),
+        }
+    }
+}
+
+/// Sum of scalars with four independent accumulators, so that the loop can be vectorized.
+fn sum_scalars(scalars: &[Scalar]) -> Scalar {
+    let chunks = scalars.chunks_exact(4);
+    let rest: Scalar = chunks.remainder().iter().sum();
+    let lanes = chunks.fold([0.0; 4], |mut lanes, chunk| {
+        lanes.iter_mut().zip(chunk).for_each(|(lane, x)| *lane += x);
+        lanes
+    });
+    lanes.iter().sum::<Scalar>() + rest
+}
 
 /// Collection of values of the same type.
-#[derive(Clone, Deref, DerefMut)]
+#[derive(Clone)]
 pub struct Array {
     /// List of values
-    #[deref]
-    #[deref_mut]
-    items: ValueList,
+    items: Items,
     /// Element type.
     ty: Type,
 }
@@ -20,26 +144,295 @@ pub struct Array {
 impl Array {
     /// Create new list
     pub fn new(ty: Type) -> Self {
+        Self::from_values(ValueList::default(), ty)
+    }
+
+    /// Create new list from `ValueList`.
+    pub fn from_values(items: ValueList, ty: Type) -> Self {
         Self {
-            items: ValueList::default(),
+            items: Items::pack(items, &ty),
             ty,
         }
     }
 
-    /// Create new list from `ValueList`.
-    pub fn from_values(items: ValueList, ty: Type) -> Self {
-        Self { items, ty }
+    /// Create new list of integers.
+    pub fn from_integers(integers: Vec<Integer>) -> Self {
+        Self {
+            items: Items::Integers(integers),
+            ty: Type::Integer,
+        }
+    }
+
+    /// Create new list of quantities with the same quantity type.
+    pub fn from_scalars(scalars: Vec<Scalar>, quantity_type: QuantityType) -> Self {
+        Self {
+            ty: Type::Quantity(quantity_type.clone()),
+            items: Items::Scalars(quantity_type, scalars),
+        }
+    }
+
+    /// Create new lazy list of integers.
+    pub fn from_integer_sequence(sequence: Sequence<Integer>) -> Self {
+        Self {
+            items: Items::IntegerRange(sequence),
+            ty: Type::Integer,
+        }
+    }
+
+    /// Create new lazy list of quantities with the same quantity type.
+    pub fn from_scalar_sequence(sequence: Sequence<Scalar>, quantity_type: QuantityType) -> Self {
+        Self {
+            ty: Type::Quantity(quantity_type.clone()),
+            items: Items::ScalarRange(quantity_type, sequence),
+        }
+    }
+
+    /// Create a lazy list of integers from `first` to `last` (inclusive).
+    pub fn range(first: Integer, last: Integer) -> Self {
+        Self::from_integer_sequence(Sequence::range(first, last))
+    }
+
+    /// Number of items.
+    pub fn len(&self) -> usize {
+        self.items.len()
+    }
+
+    /// Return `true` if the list has no items.
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Get item at `index`.
+    pub fn get(&self, index: usize) -> Option<Value> {
+        self.items.get(index)
+    }
+
+    /// Get first item.
+    pub fn first(&self) -> Option<Value> {
+        self.get(0)
+    }
+
+    /// Iterate over all items.
+    pub fn iter(&self) -> Box<dyn Iterator<Item = Value> + '_> {
+        match &self.items {
+            Items::Values(values) => Box::new(values.iter().cloned()),
+            Items::Integers(integers) => Box::new(integers.iter().map(|i| Value::Integer(*i))),
+            Items::Scalars(quantity_type, scalars) => Box::new(
+                scalars
+                    .iter()
+                    .map(|value| Value::Quantity(Quantity::new(*value, quantity_type.clone()))),
+            ),
+            Items::IntegerRange(sequence) => Box::new(sequence.iter().map(Value::Integer)),
+            Items::ScalarRange(quantity_type, sequence) => Box::new(
+                sequence
+                    .iter()
+                    .map(|value| Value::Quantity(Quantity::new(value, quantity_type.clone()))),
+            ),
+        }
+    }
+
+    /// Append an item.
+    pub fn push(&mut self, value: Value) {
+        let items = std::mem::replace(&mut self.items, Items::Values(ValueList::default()));
+        self.items = match (items.materialize(), value) {
+            (Items::Values(mut values), value) => {
+                values.push(value);
+                Items::Values(values)
+            }
+            (Items::Integers(mut integers), Value::Integer(i)) => {
+                integers.push(i);
+                Items::Integers(integers)
+            }
+            (Items::Scalars(quantity_type, mut scalars), Value::Quantity(q))
+                if q.quantity_type == quantity_type =>
+            {
+                scalars.push(q.value);
+                Items::Scalars(quantity_type, scalars)
+            }
+            (items, value) => {
+                let mut values = items.into_values();
+                values.push(value);
+                Items::Values(values)
+            }
+        };
+    }
+
+    /// Concatenate two lists.
+    pub fn concat(self, rhs: Array) -> Self {
+        let items = match (self.items.materialize(), rhs.items.materialize()) {
+            (Items::Integers(mut lhs), Items::Integers(rhs)) => {
+                lhs.extend(rhs);
+                Items::Integers(lhs)
+            }
+            (Items::Scalars(quantity_type, mut lhs), Items::Scalars(rhs_type, rhs))
+                if quantity_type == rhs_type =>
+            {
+                lhs.extend(rhs);
+                Items::Scalars(quantity_type, lhs)
+            }
+            (lhs, rhs) => Items::Values(
+                lhs.into_values()
+                    .into_iter()
+                    .chain(rhs.into_values())
+                    .collect(),
+            ),
+        };
+        Self { items, ty: self.ty }
     }
 
     /// Fetch all values as `Vec<Value>`
     pub fn fetch(&self) -> Vec<Value> {
-        self.items.iter().cloned().collect::<Vec<_>>()
+        self.iter().collect::<Vec<_>>()
+    }
+
+    /// Sum of all items.
+    ///
+    /// The sum of an empty integer or quantity list is zero, for other empty lists it is [`Value::None`].
+    pub fn sum(&self) -> ValueResult {
+        match &self.items {
+            Items::Integers(integers) => Ok(Value::Integer(integers.iter().sum())),
+            Items::Scalars(quantity_type, scalars) => Ok(Value::Quantity(Quantity::new(
+                sum_scalars(scalars),
+                quantity_type.clone(),
+            ))),
+            Items::IntegerRange(sequence) => Ok(Value::Integer(sequence.sum())),
+            Items::ScalarRange(quantity_type, sequence) => Ok(Value::Quantity(Quantity::new(
+                sequence.sum(),
+                quantity_type.clone(),
+            ))),
+            Items::Values(values) => {
+                let mut iter = values.iter().cloned();
+                match iter.next() {
+                    Some(first) => iter.try_fold(first, |sum, value| sum + value),
+                    None => Ok(Value::None),
+                }
+            }
+        }
+    }
+
+    /// Smallest item or [`Value::None`] if the list is empty or cannot be ordered.
+    pub fn min(&self) -> Value {
+        match &self.items {
+            Items::IntegerRange(sequence) => sequence.min().map(Value::Integer).unwrap_or_default(),
+            Items::ScalarRange(quantity_type, sequence) => sequence
+                .min()
+                .map(|value| Value::Quantity(Quantity::new(value, quantity_type.clone())))
+                .unwrap_or_default(),
+            _ => self.extreme(std::cmp::Ordering::Less),
+        }
+    }
+
+    /// Greatest item or [`Value::None`] if the list is empty or cannot be ordered.
+    pub fn max(&self) -> Value {
+        match &self.items {
+            Items::IntegerRange(sequence) => sequence.max().map(Value::Integer).unwrap_or_default(),
+            Items::ScalarRange(quantity_type, sequence) => sequence
+                .max()
+                .map(|value| Value::Quantity(Quantity::new(value, quantity_type.clone())))
+                .unwrap_or_default(),
+            _ => self.extreme(std::cmp::Ordering::Greater),
+        }
+    }
+
+    /// Return `true` if all items are equal.
+    pub fn all_equal(&self) -> bool {
+        match &self.items {
+            Items::IntegerRange(sequence) => sequence.all_equal(),
+            Items::ScalarRange(_, sequence) => sequence.all_equal(),
+            _ => {
+                let mut iter = self.iter();
+                match iter.next() {
+                    Some(first) => iter.all(|x| x == first),
+                    None => true,
+                }
+            }
+        }
+    }
+
+    /// Return `true` if each item is not less than its predecessor.
+    pub fn is_ascending(&self) -> bool {
+        match &self.items {
+            Items::IntegerRange(sequence) => sequence.is_ascending(),
+            Items::ScalarRange(_, sequence) => sequence.is_ascending(),
+            _ => self.iter().zip(self.iter().skip(1)).all(|(a, b)| a <= b),
+        }
+    }
+
+    /// Return `true` if each item is not greater than its predecessor.
+    pub fn is_descending(&self) -> bool {
+        match &self.items {
+            Items::IntegerRange(sequence) => sequence.is_descending(),
+            Items::ScalarRange(_, sequence) => sequence.is_descending(),
+            _ => self.iter().zip(self.iter().skip(1)).all(|(a, b)| a >= b),
+        }
+    }
+
+    fn extreme(&self, ordering: std::cmp::Ordering) -> Value {
+        let pick = |a: Scalar, b: Scalar| {
+            if b.partial_cmp(&a) == Some(ordering) {
+                b
+            } else {
+                a
+            }
+        };
+        match &self.items {
+            Items::Integers(integers) => match ordering {
+                std::cmp::Ordering::Less => integers.iter().min(),
+                _ => integers.iter().max(),
+            }
+            .map(|i| Value::Integer(*i))
+            .unwrap_or_default(),
+            Items::Scalars(quantity_type, scalars) => match scalars.split_first() {
+                Some((first, rest)) => Value::Quantity(Quantity::new(
+                    rest.iter().fold(*first, |a, b| pick(a, *b)),
+                    quantity_type.clone(),
+                )),
+                None => Value::None,
+            },
+            _ => {
+                let values = self.fetch();
+                let mut iter = values.iter();
+                let Some(first) = iter.next() else {
+                    return Value::None;
+                };
+                let mut extreme = first;
+                for value in iter {
+                    match value.partial_cmp(extreme) {
+                        Some(o) if o == ordering => extreme = value,
+                        Some(_) => {}
+                        None => return Value::None,
+                    }
+                }
+                extreme.clone()
+            }
+        }
+    }
+
+    /// Apply an element-wise operation to all items.
+    fn map(self, f: impl Fn(Value) -> ValueResult) -> ValueResult<ValueList> {
+        self.items.into_values().into_iter().map(f).collect()
     }
 }
 
 impl PartialEq for Array {
     fn eq(&self, other: &Self) -> bool {
-        self.ty == other.ty && self.items == other.items
+        if self.ty != other.ty || self.len() != other.len() {
+            return false;
+        }
+        match (&self.items, &other.items) {
+            (Items::Integers(lhs), Items::Integers(rhs)) => lhs == rhs,
+            (Items::Scalars(_, lhs), Items::Scalars(_, rhs)) => lhs == rhs,
+            (Items::IntegerRange(lhs), Items::IntegerRange(rhs)) if lhs == rhs => true,
+            (Items::ScalarRange(_, lhs), Items::ScalarRange(_, rhs)) if lhs == rhs => true,
+            _ => self.iter().eq(other.iter()),
+        }
+    }
+}
+
+impl std::hash::Hash for Array {
+    fn hash<H: std::hash::Hasher>(&self, state: &mut H) {
+        self.len().hash(state);
+        self.iter().for_each(|value| value.hash(state));
     }
 }
 
@@ -48,7 +441,7 @@ impl IntoIterator for Array {
     type IntoIter = std::vec::IntoIter<Self::Item>;
 
     fn into_iter(self) -> Self::IntoIter {
-        self.items.into_iter()
+        self.items.into_values().into_iter()
     }
 }
 
@@ -66,7 +459,7 @@ impl FromIterator<Value> for Array {
     fn from_iter<T: IntoIterator<Item = Value>>(iter: T) -> Self {
         let items: ValueList = iter.into_iter().collect();
         let ty = items.types().common_type().expect("Common type");
-        Self { ty, items }
+        Self::from_values(items, ty)
     }
 }
 
@@ -76,7 +469,6 @@ impl std::fmt::Display for Array {
             f,
             "[{items}]",
             items = self
-                .items
                 .iter()
                 .map(|v| v.to_string())
                 .collect::<Vec<_>>()
@@ -91,7 +483,6 @@ impl std::fmt::Debug for Array {
             f,
             "[{items}]",
             items = self
-                .items
                 .iter()
                 .map(|v| format!("{v:?}"))
                 .collect::<Vec<_>>()
@@ -111,18 +502,34 @@ impl std::ops::Add<Value> for Array {
     type Output = ValueResult;
 
     fn add(self, rhs: Value) -> Self::Output {
-        if self.ty.is_add_compatible_to(&rhs.ty()) {
-            Ok(Value::Array(Self::from_values(
-                ValueList::new(
-                    self.items
-                        .iter()
-                        .map(|value| value.clone() + rhs.clone())
-                        .collect::<Result<Vec<_>, _>>()?,
-                ),
-                self.ty,
-            )))
-        } else {
-            Err(ValueError::InvalidOperator("+".into()))
+        if !self.ty.is_add_compatible_to(&rhs.ty()) {
+            return Err(ValueError::InvalidOperator("+".into()));
+        }
+        // The type check above ensures that a quantity `rhs` has the quantity type of the items
+        match (self.items.materialize_divided(), rhs) {
+            (Items::Integers(mut lhs), Value::Integer(rhs)) => {
+                lhs.iter_mut().for_each(|x| *x += rhs);
+                Ok(Value::Array(Self::from_integers(lhs)))
+            }
+            (Items::IntegerRange(lhs), Value::Integer(rhs)) => {
+                Ok(Value::Array(Self::from_integer_sequence(lhs.offset(rhs))))
+            }
+            (Items::Scalars(quantity_type, mut lhs), rhs) if is_number(&rhs) => {
+                let rhs = rhs.try_scalar()?;
+                lhs.iter_mut().for_each(|x| *x += rhs);
+                Ok(Value::Array(Self::from_scalars(lhs, quantity_type)))
+            }
+            (Items::ScalarRange(quantity_type, lhs), rhs) if is_number(&rhs) => Ok(Value::Array(
+                Self::from_scalar_sequence(lhs.offset(rhs.try_scalar()?), quantity_type),
+            )),
+            (items, rhs) => {
+                let lhs = Self { items, ty: self.ty };
+                let ty = lhs.ty.clone();
+                Ok(Value::Array(Self::from_values(
+                    lhs.map(|value| value + rhs.clone())?,
+                    ty,
+                )))
+            }
         }
     }
 }
@@ -132,19 +539,56 @@ impl std::ops::Sub<Value> for Array {
     type Output = ValueResult;
 
     fn sub(self, rhs: Value) -> Self::Output {
-        if self.ty.is_add_compatible_to(&rhs.ty()) {
-            Ok(Value::Array(Self::from_values(
-                ValueList::new(
-                    self.items
-                        .iter()
-                        .map(|value| value.clone() - rhs.clone())
-                        .collect::<Result<Vec<_>, _>>()?,
-                ),
-                self.ty,
-            )))
-        } else {
-            Err(ValueError::InvalidOperator("-".into()))
+        if !self.ty.is_add_compatible_to(&rhs.ty()) {
+            return Err(ValueError::InvalidOperator("-".into()));
         }
+        // The type check above ensures that a quantity `rhs` has the quantity type of the items
+        match (self.items.materialize_divided(), rhs) {
+            (Items::Integers(mut lhs), Value::Integer(rhs)) => {
+                lhs.iter_mut().for_each(|x| *x -= rhs);
+                Ok(Value::Array(Self::from_integers(lhs)))
+            }
+            (Items::IntegerRange(lhs), Value::Integer(rhs)) => {
+                Ok(Value::Array(Self::from_integer_sequence(lhs.offset(-rhs))))
+            }
+            (Items::Scalars(quantity_type, mut lhs), rhs) if is_number(&rhs) => {
+                let rhs = rhs.try_scalar()?;
+                lhs.iter_mut().for_each(|x| *x -= rhs);
+                Ok(Value::Array(Self::from_scalars(lhs, quantity_type)))
+            }
+            (Items::ScalarRange(quantity_type, lhs), rhs) if is_number(&rhs) => Ok(Value::Array(
+                Self::from_scalar_sequence(lhs.offset(-rhs.try_scalar()?), quantity_type),
+            )),
+            (items, rhs) => {
+                let lhs = Self { items, ty: self.ty };
+                let ty = lhs.ty.clone();
+                Ok(Value::Array(Self::from_values(
+                    lhs.map(|value| value - rhs.clone())?,
+                    ty,
+                )))
+            }
+        }
+    }
+}
+
+/// Return `true` if the value is an integer or a quantity.
+fn is_number(value: &Value) -> bool {
+    matches!(value, Value::Integer(_) | Value::Quantity(_))
+}
+
+/// Quantity type of an element-wise operation of packed items of `lhs` type with `rhs`.
+///
+/// Returns `None` if the operation cannot be applied to the packed scalars.
+fn packed_type(
+    lhs: &QuantityType,
+    rhs: &Value,
+    op: impl Fn(QuantityType, QuantityType) -> QuantityType,
+) -> Option<QuantityType> {
+    match rhs {
+        Value::Integer(_) => Some(lhs.clone()),
+        Value::Quantity(rhs) => Some(op(lhs.clone(), rhs.quantity_type.clone()))
+            .filter(|quantity_type| *quantity_type != QuantityType::Invalid),
+        _ => None,
     }
 }
 
@@ -153,17 +597,62 @@ impl std::ops::Mul<Value> for Array {
     type Output = ValueResult;
 
     fn mul(self, rhs: Value) -> Self::Output {
-        match self.ty {
-            // List * Scalar or List * Integer
-            Type::Quantity(_) | Type::Integer => Ok(Value::Array(Array::from_values(
-                ValueList::new({
-                    self.iter()
-                        .map(|value| value.clone() * rhs.clone())
-                        .collect::<Result<Vec<_>, _>>()?
-                }),
-                self.ty * rhs.ty().clone(),
-            ))),
-            _ => Err(ValueError::InvalidOperator("*".into())),
+        if !matches!(self.ty, Type::Quantity(_) | Type::Integer) {
+            return Err(ValueError::InvalidOperator("*".into()));
+        }
+
+        let product_type = match (&self.items, &rhs) {
+            (Items::Integers(_) | Items::IntegerRange(_), Value::Quantity(_)) => {
+                packed_type(&QuantityType::Scalar, &rhs, |a, b| a * b)
+            }
+            (Items::Scalars(quantity_type, _) | Items::ScalarRange(quantity_type, _), _) => {
+                packed_type(quantity_type, &rhs, |a, b| a * b)
+            }
+            _ => None,
+        };
+
+        match (self.items.materialize_divided(), rhs, product_type) {
+            (Items::Integers(mut lhs), Value::Integer(rhs), _) => {
+                lhs.iter_mut().for_each(|x| *x *= rhs);
+                Ok(Value::Array(Self::from_integers(lhs)))
+            }
+            (Items::IntegerRange(lhs), Value::Integer(rhs), _) => Ok(Value::Array(
+                Self::from_integer_sequence(lhs.scale_with(|x| x * rhs)),
+            )),
+            (Items::Integers(lhs), rhs, Some(quantity_type)) => {
+                let factor = rhs.try_scalar()?;
+                Ok(Value::Array(Self::from_scalars(
+                    lhs.into_iter().map(|x| x as Scalar * factor).collect(),
+                    quantity_type,
+                )))
+            }
+            (Items::IntegerRange(lhs), rhs, Some(quantity_type)) => {
+                let factor = rhs.try_scalar()?;
+                Ok(Value::Array(Self::from_scalar_sequence(
+                    lhs.to_scalars().scale_with(|x| x * factor),
+                    quantity_type,
+                )))
+            }
+            (Items::Scalars(_, mut lhs), rhs, Some(quantity_type)) => {
+                let factor = rhs.try_scalar()?;
+                lhs.iter_mut().for_each(|x| *x *= factor);
+                Ok(Value::Array(Self::from_scalars(lhs, quantity_type)))
+            }
+            (Items::ScalarRange(_, lhs), rhs, Some(quantity_type)) => {
+                let factor = rhs.try_scalar()?;
+                Ok(Value::Array(Self::from_scalar_sequence(
+                    lhs.scale_with(|x| x * factor),
+                    quantity_type,
+                )))
+            }
+            (items, rhs, _) => {
+                let ty = self.ty.clone() * rhs.ty();
+                let lhs = Self { items, ty: self.ty };
+                Ok(Value::Array(Array::from_values(
+                    lhs.map(|value| value * rhs.clone())?,
+                    ty,
+                )))
+            }
         }
     }
 }
@@ -173,20 +662,58 @@ impl std::ops::Div<Value> for Array {
     type Output = ValueResult;
 
     fn div(self, rhs: Value) -> Self::Output {
-        let values = ValueList::new(
-            self.iter()
-                .map(|value| value.clone() / rhs.clone())
-                .collect::<Result<Vec<_>, _>>()?,
-        );
-
-        match (&self.ty, rhs.ty()) {
+        let quotient_type = match (&self.items, &rhs) {
+            _ if self.is_empty() => None,
             // Integer / Integer => Scalar
-            (Type::Integer, Type::Integer) => Ok(Value::Array(Array::from_values(
-                values,
-                self.ty / rhs.ty().clone(),
-            ))),
-            (Type::Quantity(_), _) => Ok(Value::Array(values.try_into()?)),
-            _ => Err(ValueError::InvalidOperator("/".into())),
+            (Items::Integers(_) | Items::IntegerRange(_), Value::Integer(_)) => {
+                Some(QuantityType::Scalar)
+            }
+            (Items::Scalars(quantity_type, _) | Items::ScalarRange(quantity_type, _), _) => {
+                packed_type(quantity_type, &rhs, |a, b| a / b)
+            }
+            _ => None,
+        };
+
+        match (self.items.materialize_divided(), rhs, quotient_type) {
+            (Items::Integers(lhs), rhs, Some(quantity_type)) => {
+                let divisor = rhs.try_scalar()?;
+                Ok(Value::Array(Self::from_scalars(
+                    lhs.into_iter().map(|x| x as Scalar / divisor).collect(),
+                    quantity_type,
+                )))
+            }
+            (Items::IntegerRange(lhs), rhs, Some(quantity_type)) => {
+                let divisor = rhs.try_scalar()?;
+                Ok(Value::Array(Self::from_scalar_sequence(
+                    lhs.to_scalars().divide(divisor),
+                    quantity_type,
+                )))
+            }
+            (Items::Scalars(_, mut lhs), rhs, Some(quantity_type)) => {
+                let divisor = rhs.try_scalar()?;
+                lhs.iter_mut().for_each(|x| *x /= divisor);
+                Ok(Value::Array(Self::from_scalars(lhs, quantity_type)))
+            }
+            (Items::ScalarRange(_, lhs), rhs, Some(quantity_type)) => {
+                let divisor = rhs.try_scalar()?;
+                Ok(Value::Array(Self::from_scalar_sequence(
+                    lhs.divide(divisor),
+                    quantity_type,
+                )))
+            }
+            (items, rhs, _) => {
+                let lhs_ty = self.ty.clone();
+                let values = Self { items, ty: self.ty }.map(|value| value / rhs.clone())?;
+
+                match (&lhs_ty, rhs.ty()) {
+                    (Type::Integer, Type::Integer) => Ok(Value::Array(Array::from_values(
+                        values,
+                        lhs_ty / rhs.ty().clone(),
+                    ))),
+                    (Type::Quantity(_), _) => Ok(Value::Array(values.try_into()?)),
+                    _ => Err(ValueError::InvalidOperator("/".into())),
+                }
+            }
         }
     }
 }
@@ -195,13 +722,36 @@ impl std::ops::Neg for Array {
     type Output = ValueResult;
 
     fn neg(self) -> Self::Output {
-        let items: ValueList = self
-            .iter()
-            .map(|value| -value.clone())
-            .collect::<Result<Vec<_>, _>>()?
-            .into_iter()
-            .collect();
-        Ok(Value::Array(items.try_into()?))
+        if self.is_empty() {
+            // an empty list has no common type
+            return Err(ValueError::CommonTypeExpected);
+        }
+        match self.items {
+            Items::Integers(mut integers) => {
+                integers.iter_mut().for_each(|x| *x = -*x);
+                Ok(Value::Array(Self::from_integers(integers)))
+            }
+            Items::IntegerRange(sequence) => Ok(Value::Array(Self::from_integer_sequence(
+                sequence.scale_with(|x| -x),
+            ))),
+            Items::Scalars(quantity_type, mut scalars) => {
+                scalars.iter_mut().for_each(|x| *x = -*x);
+                Ok(Value::Array(Self::from_scalars(scalars, quantity_type)))
+            }
+            Items::ScalarRange(quantity_type, sequence) => Ok(Value::Array(
+                Self::from_scalar_sequence(sequence.scale_with(|x| -x), quantity_type),
+            )),
+            items => {
+                let items: ValueList = items
+                    .into_values()
+                    .into_iter()
+                    .map(|value| -value)
+                    .collect::<Result<Vec<_>, _>>()?
+                    .into_iter()
+                    .collect();
+                Ok(Value::Array(items.try_into()?))
+            }
+        }
     }
 }
 
@@ -217,3 +767,115 @@ fn test_array_debug() {
     log::info!("{array}");
     log::info!("{array:?}");
 }
+
+#[test]
+fn test_packed_array_ops() {
+    let mm = |value| Value::Quantity(Quantity::new(value, QuantityType::Length));
+
+    let array = Array::range(1, 3);
+    assert_eq!(
+        array,
+        Array::from_values(
+            ValueList::new(vec![
+                Value::Integer(1),
+                Value::Integer(2),
+                Value::Integer(3)
+            ]),
+            Type::Integer
+        )
+    );
+
+    // unit bundling: `[1,2,3]mm`
+    let Ok(Value::Array(lengths)) = array * mm(1.0) else {
+        panic!("Length array expected");
+    };
+    assert_eq!(
+        lengths.ty(),
+        Type::Array(Box::new(Type::Quantity(QuantityType::Length)))
+    );
+    assert_eq!(lengths.get(2), Some(mm(3.0)));
+
+    let Ok(Value::Array(shifted)) = lengths.clone() + mm(1.0) else {
+        panic!("Length array expected");
+    };
+    assert_eq!(shifted.fetch(), vec![mm(2.0), mm(3.0), mm(4.0)]);
+    assert!((lengths.clone() + Value::Integer(1)).is_err());
+
+    let Ok(Value::Array(areas)) = lengths.clone() * mm(2.0) else {
+        panic!("Area array expected");
+    };
+    assert_eq!(
+        areas.ty(),
+        Type::Array(Box::new(Type::Quantity(QuantityType::Area)))
+    );
+
+    assert_eq!(lengths.sum().expect("Sum"), mm(6.0));
+    assert_eq!(lengths.min(), mm(1.0));
+    assert_eq!(lengths.max(), mm(3.0));
+
+    let mut mixed = lengths.concat(shifted);
+    mixed.push(Value::Integer(1));
+    assert_eq!(mixed.len(), 7);
+    assert_eq!(mixed.get(6), Some(Value::Integer(1)));
+}
+
+#[test]
+fn test_lazy_range() {
+    let deg = |value| Value::Quantity(Quantity::new(value, QuantityType::Angle));
+
+    // `[0..1_000_000] * 0.1mm` does not allocate any items
+    let Ok(Value::Array(lengths)) =
+        Array::range(0, 1_000_000) * Value::Quantity(Quantity::new(0.1, QuantityType::Length))
+    else {
+        panic!("Length array expected");
+    };
+    assert!(matches!(lengths.items, Items::ScalarRange(..)));
+    assert_eq!(lengths.len(), 1_000_001);
+    assert!(lengths.is_ascending() && !lengths.is_descending() && !lengths.all_equal());
+
+    // `[0..3] / 4 * 360°`
+    let Ok(Value::Array(angles)) =
+        (Array::range(0, 3) / Value::Integer(4)).and_then(|array| array * deg(360.0))
+    else {
+        panic!("Angle array expected");
+    };
+    assert_eq!(
+        angles.fetch(),
+        vec![deg(0.0), deg(90.0), deg(180.0), deg(270.0)]
+    );
+    assert_eq!(
+        angles,
+        Array::from_scalars(vec![0.0, 90.0, 180.0, 270.0], QuantityType::Angle)
+    );
+    assert_eq!(angles.sum().expect("Sum"), deg(540.0));
+    assert_eq!(angles.max(), deg(270.0));
+
+    let mut angles = angles;
+    angles.push(deg(360.0));
+    assert_eq!(angles.len(), 5);
+
+    // `[0..10] / 10 * 3` has the items of the materialized list
+    let Ok(Value::Array(tenths)) = Array::range(0, 10) / Value::Integer(10) else {
+        panic!("Scalar array expected");
+    };
+    assert!(matches!(tenths.items, Items::ScalarRange(..)));
+    let materialized = Array::from_scalars(
+        (0..=10).map(|i| i as Scalar / 10.0).collect(),
+        QuantityType::Scalar,
+    );
+    let three = || Value::Quantity(Quantity::new(3.0, QuantityType::Scalar));
+    let (Ok(Value::Array(lazy)), Ok(Value::Array(materialized))) =
+        (tenths.clone() * three(), materialized * three())
+    else {
+        panic!("Scalar arrays expected");
+    };
+    assert_eq!(lazy.fetch(), materialized.fetch());
+    assert_ne!(
+        lazy.fetch()[1],
+        Value::Quantity(Quantity::new(0.3, QuantityType::Scalar))
+    );
+    let Ok(Value::Array(negative)) = -tenths else {
+        panic!("Scalar array expected");
+    };
+    assert!(matches!(negative.items, Items::ScalarRange(..)));
+}
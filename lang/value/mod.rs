@@ -13,6 +13,7 @@ mod matrix;
 mod parameter_value;
 mod parameter_value_list;
 mod quantity;
+mod sequence;
 mod target;
 mod tuple;
 mod value_access;
@@ -26,6 +27,7 @@ pub use matrix::*;
 pub use parameter_value::*;
 pub use parameter_value_list::*;
 pub use quantity::*;
+pub use sequence::*;
 pub use target::*;
 pub use tuple::*;
 pub use value_access::*;
@@ -224,10 +226,7 @@ impl std::ops::Add for Value {
                     ));
                 }
 
-                Ok(Value::Array(Array::from_values(
-                    lhs.iter().chain(rhs.iter()).cloned().collect(),
-                    lhs.ty(),
-                )))
+                Ok(Value::Array(lhs.concat(rhs)))
             }
             // Add a value to an array.
             (Value::Array(lhs), rhs) => Ok((lhs + rhs)?),
@@ -7,9 +7,9 @@ use crate::value::*;
 use compact_str::CompactStringExt;
 use derive_more::Deref;
 
-/// List of parameter values
+/// List of parameter values in order of declaration
 #[derive(Clone, Default, Deref)]
-pub struct ParameterValueList(std::collections::HashMap<Identifier, ParameterValue>);
+pub struct ParameterValueList(indexmap::IndexMap<Identifier, ParameterValue>);
 
 impl ParameterValueList {
     /// Push parameter value
@@ -0,0 +1,216 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Lazy arithmetic sequence
+
+use microcad_core::{Integer, Scalar};
+
+/// Number type which can be an item of a [`Sequence`].
+pub trait SequenceItem:
+    Copy
+    + PartialOrd
+    + std::ops::Add<Output = Self>
+    + std::ops::Mul<Output = Self>
+    + std::ops::Div<Output = Self>
+    + std::ops::Neg<Output = Self>
+{
+    /// Convert an index or count into a number.
+    fn from_index(index: usize) -> Self;
+}
+
+impl SequenceItem for Integer {
+    fn from_index(index: usize) -> Self {
+        index as Integer
+    }
+}
+
+impl SequenceItem for Scalar {
+    fn from_index(index: usize) -> Self {
+        index as Scalar
+    }
+}
+
+/// Arithmetic sequence `(start + i * step) / divisor` for `i` in `0..len`, which is not
+/// materialized.
+///
+/// Adding a number or scaling the sequence only changes `start`, `step` and `divisor`,
+/// so a range like `[0..1_000_000] * 0.1mm` stays O(1) until it is iterated.
+/// Divisions are kept apart from `start` and `step`, so that each item of `[0..10] / 10` is
+/// rounded once like the item of a materialized list instead of summing rounded fractions.
+/// Offsets and factors of a divided sequence do not round like the same operations on the
+/// materialized items, so arrays compute the items before (see [`Self::is_divided`]).
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub struct Sequence<T: SequenceItem> {
+    /// First item before the division.
+    pub start: T,
+    /// Difference between two consecutive items before the division.
+    pub step: T,
+    /// Positive divisor of all items.
+    pub divisor: T,
+    /// Number of items.
+    pub len: usize,
+}
+
+impl<T: SequenceItem> Sequence<T> {
+    /// Create a new sequence.
+    pub fn new(start: T, step: T, len: usize) -> Self {
+        Self {
+            start,
+            step,
+            divisor: T::from_index(1),
+            len,
+        }
+    }
+
+    /// Return `true` if the items are divided, see [`Self::divide`].
+    pub fn is_divided(&self) -> bool {
+        self.divisor != T::from_index(1)
+    }
+
+    /// Get item at `index`.
+    pub fn get(&self, index: usize) -> Option<T> {
+        (index < self.len).then(|| self.item(index))
+    }
+
+    /// Iterate over all items.
+    pub fn iter(self) -> impl Iterator<Item = T> {
+        (0..self.len).map(move |index| self.item(index))
+    }
+
+    fn item(&self, index: usize) -> T {
+        let item = self.start + self.step * T::from_index(index);
+        match self.is_divided() {
+            true => item / self.divisor,
+            false => item,
+        }
+    }
+
+    /// Add `offset` to each item.
+    pub fn offset(self, offset: T) -> Self {
+        Self {
+            start: self.start + offset * self.divisor,
+            ..self
+        }
+    }
+
+    /// Apply a linear function (e.g. a multiplication) to each item.
+    pub fn scale_with(self, f: impl Fn(T) -> T) -> Self {
+        Self {
+            start: f(self.start),
+            step: f(self.step),
+            ..self
+        }
+    }
+
+    /// Divide each item by `divisor`.
+    pub fn divide(self, divisor: T) -> Self {
+        match divisor < T::from_index(0) {
+            true => Self {
+                start: -self.start,
+                step: -self.step,
+                divisor: self.divisor * -divisor,
+                len: self.len,
+            },
+            false => Self {
+                divisor: self.divisor * divisor,
+                ..self
+            },
+        }
+    }
+
+    /// Sum of all items.
+    pub fn sum(&self) -> T {
+        let triangular = if self.len > 1 {
+            self.len * (self.len - 1) / 2
+        } else {
+            0
+        };
+        let sum = self.start * T::from_index(self.len) + self.step * T::from_index(triangular);
+        match self.is_divided() {
+            true => sum / self.divisor,
+            false => sum,
+        }
+    }
+
+    /// Smallest item.
+    pub fn min(&self) -> Option<T> {
+        self.endpoints()
+            .map(|(first, last)| if last < first { last } else { first })
+    }
+
+    /// Greatest item.
+    pub fn max(&self) -> Option<T> {
+        self.endpoints()
+            .map(|(first, last)| if last > first { last } else { first })
+    }
+
+    /// Return `true` if each item is not less than its predecessor.
+    pub fn is_ascending(&self) -> bool {
+        self.len < 2 || self.step >= T::from_index(0)
+    }
+
+    /// Return `true` if each item is not greater than its predecessor.
+    pub fn is_descending(&self) -> bool {
+        self.len < 2 || self.step <= T::from_index(0)
+    }
+
+    /// Return `true` if all items are equal.
+    pub fn all_equal(&self) -> bool {
+        self.len < 2 || self.step == T::from_index(0)
+    }
+
+    fn endpoints(&self) -> Option<(T, T)> {
+        Some((self.get(0)?, self.get(self.len - 1)?))
+    }
+}
+
+impl Sequence<Integer> {
+    /// Inclusive integer range `first..=last`.
+    pub fn range(first: Integer, last: Integer) -> Self {
+        Self::new(first, 1, (last - first + 1).max(0) as usize)
+    }
+
+    /// Convert into a sequence of scalars.
+    pub fn to_scalars(self) -> Sequence<Scalar> {
+        Sequence {
+            start: self.start as Scalar,
+            step: self.step as Scalar,
+            divisor: self.divisor as Scalar,
+            len: self.len,
+        }
+    }
+}
+
+#[test]
+fn sequence_range() {
+    let range = Sequence::range(1, 4);
+    assert_eq!(range.iter().collect::<Vec<_>>(), vec![1, 2, 3, 4]);
+    assert_eq!(range.sum(), 10);
+    assert!(range.is_ascending() && !range.is_descending());
+
+    let scaled = range.to_scalars().scale_with(|x| x * -0.5).offset(1.0);
+    assert_eq!(
+        scaled.iter().collect::<Vec<_>>(),
+        vec![0.5, 0.0, -0.5, -1.0]
+    );
+    assert_eq!(scaled.sum(), -1.0);
+    assert_eq!(scaled.min(), Some(-1.0));
+    assert_eq!(scaled.max(), Some(0.5));
+
+    // each item is rounded once like the items of a materialized list
+    let divided = Sequence::range(0, 10).to_scalars().divide(10.0);
+    assert_eq!(
+        divided.iter().collect::<Vec<_>>(),
+        (0..=10).map(|i| i as Scalar / 10.0).collect::<Vec<_>>()
+    );
+    assert_eq!(divided.get(3), Some(0.3));
+    assert_eq!(divided.offset(1.0).get(3), Some(1.3));
+    assert_eq!(divided.sum(), 5.5);
+
+    let negative = Sequence::range(0, 10).to_scalars().divide(-10.0);
+    assert_eq!(negative.get(3), Some(-0.3));
+    assert!(negative.is_descending() && !negative.is_ascending());
+
+    assert_eq!(Sequence::range(3, 1).len, 0);
+    assert_eq!(Sequence::range(3, 1).min(), None);
+}
@@ -250,7 +250,7 @@ impl Tuple {
                         if let Some((count, len)) = counts.get_mut(id) {
                             let item = (
                                 id.clone(),
-                                array.get(*count).expect("array index not found").clone(),
+                                array.get(*count).expect("array index not found"),
                             );
                             if !counted {
                                 *count += 1;
@@ -5,9 +5,10 @@
 
 /// pest test main
 fn main() {
-    microcad_pest_test::generate(
+    microcad_pest_test::generate_with_cross_check(
         "microcad_lang::parser::Parser",
         "microcad_lang::parser::Rule",
+        Some("microcad_lang::parse::fast::cross_check"),
         "../lang/grammar.pest",
     );
 
@@ -24,6 +24,17 @@ pub fn generate(
     parser_struct_name: &str,
     rule_enum_name: &str,
     grammar_file: impl AsRef<std::path::Path> + std::fmt::Debug,
+) {
+    generate_with_cross_check(parser_struct_name, rule_enum_name, None, grammar_file)
+}
+
+/// Generates tests from Pest grammar file which additionally call function `cross_check`
+/// (`fn(Rule, &str) -> Result<(), String>`) for every successfully parsed input.
+pub fn generate_with_cross_check(
+    parser_struct_name: &str,
+    rule_enum_name: &str,
+    cross_check: Option<&str>,
+    grammar_file: impl AsRef<std::path::Path> + std::fmt::Debug,
 ) {
     use std::{env::*, fs::*, path::*};
 
@@ -35,6 +46,7 @@ pub fn generate(
         .generate_test_rs(
             parser_struct_name,
             rule_enum_name,
+            cross_check,
             &mut File::create(dest_path).unwrap(),
         )
         .unwrap();
@@ -43,10 +43,14 @@ impl PestFile {
     }
 
     /// generate rust test
+    ///
+    /// If `cross_check` names a function `fn(Rule, &str) -> Result<(), String>`, it is called
+    /// for any input which was parsed successfully.
     pub fn generate_test_rs(
         &self,
         parser_struct_name: &str,
         rule_enum_name: &str,
+        cross_check: Option<&str>,
         w: &mut impl std::io::Write,
     ) -> Result<(), std::io::Error> {
         let mut r = RustWriter::new(w);
@@ -79,7 +83,22 @@ impl PestFile {
 
                 match &test.result {
                     PestResult::Ok(s) => {
-                        r.writeln("Ok(pairs) =>  assert_eq!(input, pairs.as_str()),")?;
+                        match cross_check {
+                            Some(cross_check) => {
+                                r.begin_scope("Ok(pairs) =>")?;
+                                r.writeln("assert_eq!(input, pairs.as_str());")?;
+                                r.begin_scope(&format!(
+                                    "if let Err(e) = {cross_check}({rule_enum_name}::r#{}, input)",
+                                    rule.name
+                                ))?;
+                                r.writeln("panic!(\"{} at `{}`:{}\", e, input, test_line);")?;
+                                r.end_scope()?;
+                                r.end_scope()?;
+                            }
+                            None => {
+                                r.writeln("Ok(pairs) =>  assert_eq!(input, pairs.as_str()),")?
+                            }
+                        }
                         r.writeln(&format!(
                             "Err(e) => panic!(\"{{}} at `{{}}`:{{}} {s}\", e, input, test_line),"
                         ))?;
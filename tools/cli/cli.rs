@@ -7,6 +7,7 @@ use clap::Parser;
 
 use crate::commands::*;
 use crate::config::Config;
+use microcad_lang::diag::Diag;
 
 /// µcad cli
 #[derive(Parser)]
@@ -16,6 +17,18 @@ pub struct Cli {
     #[arg(short = 'T', long, default_value = "false", action = clap::ArgAction::SetTrue)]
     pub(crate) time: bool,
 
+    /// Print a memory report per processing stage as JSON.
+    #[arg(long, global = true, default_value = "false", action = clap::ArgAction::SetTrue)]
+    pub(crate) mem_report: bool,
+
+    /// Print diagnostics as JSON.
+    #[arg(long, global = true, default_value = "false", action = clap::ArgAction::SetTrue)]
+    pub(crate) diag_json: bool,
+
+    /// Record processing spans and write them into a Chrome trace file.
+    #[arg(long, global = true)]
+    trace: Option<std::path::PathBuf>,
+
     /// Load config from file.
     #[arg(short = 'C', long)]
     config: Option<std::path::PathBuf>,
@@ -70,7 +83,31 @@ impl Cli {
     /// Run the CLI.
     pub fn run(&self) -> anyhow::Result<()> {
         let start = std::time::Instant::now();
+        if self.trace.is_some() {
+            microcad_lang::trace::enable();
+        }
+
+        // write the trace of failed commands, too
+        let result = self.run_command();
+        let written = self.write_trace();
+        result?;
+        written?;
+
+        if self.time {
+            eprintln!(
+                "Overall Time   : {}",
+                Self::time_to_string(&start.elapsed())
+            );
+        }
+
+        if self.mem_report {
+            println!("{}", crate::mem::report()?);
+        }
+        Ok(())
+    }
 
+    /// Run the selected command.
+    fn run_command(&self) -> anyhow::Result<()> {
         match &self.command {
             Commands::Parse(parse) => {
                 parse.run(self)?;
@@ -87,19 +124,26 @@ impl Cli {
             Commands::Create(create) => {
                 create.run(self)?;
             }
+            Commands::Sweep(sweep) => {
+                sweep.run(self)?;
+            }
             Commands::Watch(watch) => {
                 watch.run(self)?;
             }
             Commands::Install(install) => {
                 install.run(self)?;
             }
+            Commands::Lsp(lsp) => {
+                lsp.run(self)?;
+            }
         }
+        Ok(())
+    }
 
-        if self.time {
-            eprintln!(
-                "Overall Time   : {}",
-                Self::time_to_string(&start.elapsed())
-            );
+    /// Write the spans recorded so far into the trace file if tracing was requested.
+    pub(crate) fn write_trace(&self) -> anyhow::Result<()> {
+        if let Some(trace) = &self.trace {
+            microcad_lang::trace::write_chrome_trace(trace)?;
         }
         Ok(())
     }
@@ -128,6 +172,19 @@ impl Cli {
         matches!(self.command, Commands::Export(..))
     }
 
+    /// Print the diagnosis of a context to stderr (as JSON if requested).
+    pub(super) fn print_diagnosis(&self, context: &impl Diag) {
+        match self.diag_json {
+            true => eprint!("{}", context.json_diagnosis()),
+            false => eprint!("{}", context.diagnosis()),
+        }
+    }
+
+    /// Begin to measure the memory of a stage if a memory report was requested.
+    pub(super) fn begin_stage(&self, stage: &'static str) -> Option<crate::mem::Stage> {
+        self.mem_report.then(|| crate::mem::Stage::begin(stage))
+    }
+
     pub(super) fn time_to_string(duration: &std::time::Duration) -> String {
         use num_format::{Locale, ToFormattedString};
         format!(
@@ -3,6 +3,7 @@
 
 //! µcad CLI eval commands
 
+use microcad_core::HeapSize;
 use microcad_lang::{diag::*, eval::*, model::Model, tree_display::*};
 
 use crate::{
@@ -27,6 +28,7 @@ impl RunCommand<(EvalContext, Option<Model>)> for Eval {
         let resolve_context = self.resolve.run(cli)?;
 
         let start = std::time::Instant::now();
+        let stage = cli.begin_stage("eval");
 
         let mut context = EvalContext::new(
             resolve_context,
@@ -37,16 +39,27 @@ impl RunCommand<(EvalContext, Option<Model>)> for Eval {
 
         let result = context.eval();
 
+        if let Some(stage) = stage {
+            stage.end(|| {
+                let model_size = match &result {
+                    Result::Ok(Some(model)) => model.heap_size(),
+                    _ => 0,
+                };
+                [("model", model_size)]
+            });
+        }
+
         if cli.time {
             eprintln!("Evaluation Time: {}", Cli::time_to_string(&start.elapsed()));
         }
 
-        match context.has_errors() {
-            true => {
+        match (context.has_errors(), cli.diag_json) {
+            (_, true) => cli.print_diagnosis(&context),
+            (true, false) => {
                 eprintln!("Evaluation failed:");
                 eprintln!("{}", context.diagnosis());
             }
-            false => log::info!("Evaluated successfully!"),
+            (false, false) => log::info!("Evaluated successfully!"),
         }
 
         match result {
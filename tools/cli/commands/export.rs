@@ -5,11 +5,44 @@
 
 use anyhow::anyhow;
 use microcad_builtin::*;
-use microcad_core::RenderResolution;
-use microcad_lang::{model::*, ty::*, value::*};
+use microcad_core::{HeapSize, RenderResolution};
+use microcad_lang::{
+    diag::*,
+    eval::{Capture, EvalSnapshot},
+    model::*,
+    rc::RcMut,
+    render::RenderCache,
+    ty::*,
+    value::*,
+};
 
 use crate::{config::Config, *};
 
+/// Parse a render resolution like `0.05mm` or use the default resolution.
+pub fn parse_resolution(resolution: &str) -> RenderResolution {
+    use microcad_lang::*;
+
+    use std::str::FromStr;
+    let value = syntax::NumberLiteral::from_str(resolution)
+        .map(|literal| literal.value())
+        .unwrap_or(value::Value::None);
+
+    match value {
+        value::Value::Quantity(Quantity {
+            value,
+            quantity_type: QuantityType::Length,
+        }) => RenderResolution::new(value),
+        _ => {
+            let default = RenderResolution::default();
+            log::warn!(
+                "Invalid resolution `{resolution}`. Using default resolution: {value}mm",
+                value = default.linear
+            );
+            default
+        }
+    }
+}
+
 /// Parse and evaluate and export a µcad file.
 #[derive(clap::Parser)]
 pub struct Export {
@@ -27,15 +60,39 @@ pub struct Export {
     #[arg(short, long)]
     pub dry_run: bool,
 
+    /// Export all targets, even those which are up to date.
+    ///
+    /// Without this flag, each export writes a stamp of the pre-rendered model, the resolution
+    /// and the exporter into a sidecar file (e.g. `gear.stl.hash`) and targets whose output
+    /// matches the stamp are skipped without rendering.
+    #[arg(short, long)]
+    pub force: bool,
+
     /// The resolution of this export.
     ///
     /// The resolution can changed relatively `200%` or to an absolute value `0.05mm`.
     #[arg(short, long, default_value = "0.1mm")]
     pub resolution: String,
+
+    /// Export one variant for each `[[variant]]` table of parameters in this TOML file.
+    ///
+    /// The parameters override top-level values and each output file gets the variant index
+    /// as suffix (e.g. `gear_3.stl`).
+    #[arg(long)]
+    pub sweep: Option<std::path::PathBuf>,
+
+    /// Number of worker threads for `--sweep` (default: number of CPUs).
+    #[arg(short, long)]
+    pub jobs: Option<usize>,
 }
 
 impl RunCommand<Vec<(Model, ExportCommand)>> for Export {
     fn run(&self, cli: &Cli) -> anyhow::Result<Vec<(Model, ExportCommand)>> {
+        if let Some(params) = &self.sweep {
+            self.export_sweep(cli, params)?;
+            return Ok(Vec::new());
+        }
+
         // run prior parse step
         let (context, model) = self.eval.run(cli)?;
 
@@ -48,9 +105,10 @@ impl RunCommand<Vec<(Model, ExportCommand)>> for Export {
                 self.list_targets(&target_models)?;
             }
 
+            let mut exported = 0;
             if !self.dry_run {
                 let start = std::time::Instant::now();
-                self.export_targets(&target_models)?;
+                exported = self.export_targets(cli, &target_models)?;
 
                 if cli.time {
                     eprintln!("Exporting Time : {}", Cli::time_to_string(&start.elapsed()));
@@ -60,8 +118,13 @@ impl RunCommand<Vec<(Model, ExportCommand)>> for Export {
             if cli.is_export() {
                 if self.dry_run {
                     eprintln!("Did not export {} file(s) (dry-run!).", target_models.len());
+                } else if exported < target_models.len() {
+                    eprintln!(
+                        "Exported {exported} file(s) successfully, {} file(s) up to date.",
+                        target_models.len() - exported
+                    );
                 } else {
-                    eprintln!("Exported {} file(s) successfully!", target_models.len());
+                    eprintln!("Exported {exported} file(s) successfully!");
                 }
             }
             Ok(target_models)
@@ -92,28 +155,7 @@ impl Export {
 
     /// Parse render resolution.
     pub fn resolution(&self) -> RenderResolution {
-        use microcad_lang::*;
-
-        use std::str::FromStr;
-        let value = syntax::NumberLiteral::from_str(&self.resolution)
-            .map(|literal| literal.value())
-            .unwrap_or(value::Value::None);
-
-        match value {
-            value::Value::Quantity(Quantity {
-                value,
-                quantity_type: QuantityType::Length,
-            }) => RenderResolution::new(value),
-            _ => {
-                let default = RenderResolution::default();
-                log::warn!(
-                    "Invalid resolution `{resolution}`. Using default resolution: {value}mm",
-                    resolution = self.resolution,
-                    value = default.linear
-                );
-                default
-            }
-        }
+        parse_resolution(&self.resolution)
     }
 
     /// Get default export attribute.
@@ -194,17 +236,145 @@ impl Export {
         Ok(models)
     }
 
-    pub fn export_targets(&self, models: &[(Model, ExportCommand)]) -> anyhow::Result<()> {
+    /// Render and export a target unless it is up to date (see `--force`).
+    ///
+    /// Returns `None` if the target has been skipped.
+    fn export_target(
+        &self,
+        model: &Model,
+        export: &ExportCommand,
+        render_cache: RcMut<RenderCache>,
+    ) -> anyhow::Result<Option<Value>> {
+        Ok(match self.force {
+            true => Some(export.render_and_export_with_cache(model, render_cache)?),
+            false => export.render_and_export_if_changed(model, render_cache)?,
+        })
+    }
+
+    /// Export all targets and return the number of exported (not up to date) targets.
+    pub fn export_targets(
+        &self,
+        cli: &Cli,
+        models: &[(Model, ExportCommand)],
+    ) -> anyhow::Result<usize> {
+        let mut exported = 0;
         models
             .iter()
             .try_for_each(|(model, export)| -> anyhow::Result<()> {
-                let value = export.render_and_export(model)?;
-                if !matches!(value, Value::None) {
-                    log::info!("{value}");
-                };
+                let stage = cli
+                    .mem_report
+                    .then(|| mem::Stage::begin_target("export", export.filename.display()));
+                let render_cache = RcMut::new(RenderCache::default());
+
+                let value = self.export_target(model, export, render_cache.clone())?;
+                match value {
+                    Some(Value::None) => exported += 1,
+                    Some(value) => {
+                        exported += 1;
+                        log::info!("{value}");
+                    }
+                    None => eprintln!("{} is up to date.", export.filename.display()),
+                }
+
+                if let Some(stage) = stage {
+                    stage.end(|| {
+                        [
+                            ("model", model.heap_size()),
+                            ("render_cache", render_cache.borrow().heap_size()),
+                        ]
+                    });
+                }
                 Ok(())
             })?;
-        Ok(())
+        Ok(exported)
+    }
+
+    /// Evaluate and export all variants given by the parameter rows in `params`.
+    fn export_sweep(&self, cli: &Cli, params: &std::path::Path) -> anyhow::Result<()> {
+        let start = std::time::Instant::now();
+        let config = cli.fetch_config()?;
+
+        let results = super::sweep::run_variants(
+            &self.eval.resolve.parse.input,
+            &self.eval.resolve.search_paths(),
+            self.jobs,
+            || sweep_variants(params),
+            |snapshot, render_cache, index, variant| {
+                self.export_variant(&config, snapshot, render_cache, index, variant)
+            },
+        )?;
+
+        let failed = results
+            .iter()
+            .enumerate()
+            .filter(|(index, result)| match result {
+                Ok(result) => {
+                    eprintln!("{index:>4}: {result}");
+                    false
+                }
+                Err(err) => {
+                    eprintln!("{index:>4}: {err}");
+                    true
+                }
+            })
+            .count();
+
+        if cli.time {
+            eprintln!("Exporting Time : {}", Cli::time_to_string(&start.elapsed()));
+        }
+
+        match failed {
+            0 => {
+                eprintln!("Exported {} variant(s) successfully!", results.len());
+                Ok(())
+            }
+            failed => Err(anyhow!("{failed} of {} variant(s) failed.", results.len())),
+        }
+    }
+
+    /// Evaluate a single variant and export its targets with the variant index as suffix.
+    fn export_variant(
+        &self,
+        config: &Config,
+        snapshot: &EvalSnapshot,
+        render_cache: &RcMut<RenderCache>,
+        index: usize,
+        variant: Tuple,
+    ) -> anyhow::Result<String> {
+        let params = variant.to_string();
+        let mut context = snapshot.fork(
+            variant,
+            Capture::new(),
+            builtin_exporters(),
+            builtin_importers(),
+        )?;
+        let model = context.eval()?;
+
+        if context.has_errors() {
+            return Err(anyhow!(
+                "{params} evaluation failed:\n{}",
+                context.diagnosis()
+            ));
+        }
+        let model = model.ok_or_else(|| anyhow!("{params} model missing!"))?;
+
+        let filenames = self
+            .target_models(&model, config, context.exporters())?
+            .into_iter()
+            .map(|(model, mut export)| -> anyhow::Result<String> {
+                export.filename = variant_filename(&export.filename, index);
+                if !self.dry_run {
+                    let value = self.export_target(&model, &export, render_cache.clone())?;
+                    match value {
+                        Some(Value::None) | None => (),
+                        Some(value) => log::info!("{value}"),
+                    }
+                }
+                Ok(export.filename.display().to_string())
+            })
+            .collect::<anyhow::Result<Vec<_>>>()?;
+
+        Ok(format!("{params} => {}", filenames.join(", ")))
     }
 
     pub fn list_targets(&self, models: &Vec<(Model, ExportCommand)>) -> anyhow::Result<()> {
@@ -214,3 +384,187 @@ impl Export {
         Ok(())
     }
 }
+
+/// Read the `[[variant]]` tables of a TOML file with the TOML importer.
+fn sweep_variants(params: &std::path::Path) -> anyhow::Result<Vec<Tuple>> {
+    use microcad_lang::{Id, syntax::Identifier};
+
+    let mut args = Tuple::default();
+    args.insert(
+        Identifier::no_ref("filename"),
+        Value::String(params.to_string_lossy().to_string()),
+    );
+    let table = builtin_importers()
+        .by_id(&Id::new("toml"))
+        .and_then(|importer| importer.import(&args))
+        .map_err(|err| anyhow!("Cannot read {params:?}: {err}"))?;
+
+    let rows = match &table {
+        Value::Tuple(table) => table.by_id(&Identifier::no_ref("variant")),
+        _ => None,
+    };
+    match rows {
+        Some(Value::Array(rows)) => rows
+            .iter()
+            .map(|row| match row {
+                Value::Tuple(row) => row
+                    .transform(|value| Ok(sweep_value(value)))
+                    .map_err(|err| anyhow!("{err}")),
+                row => Err(anyhow!("Variant must be a table: {row}")),
+            })
+            .collect(),
+        _ => Err(anyhow!("No [[variant]] tables found in {params:?}")),
+    }
+}
+
+/// Turn strings of numbers with units (e.g. `"1.5mm"`) into quantities.
+///
+/// TOML numbers have no units, so floats are imported as unitless scalars.
+fn sweep_value(value: Value) -> Value {
+    use microcad_lang::{
+        src_ref::SrcReferrer,
+        syntax::{NumberLiteral, Unit},
+    };
+    use std::str::FromStr;
+
+    match value {
+        Value::String(s) => match NumberLiteral::from_str(&s) {
+            Ok(literal)
+                if literal.unit() != Unit::None
+                    && literal.src_ref().as_ref().map(|r| r.len as usize)
+                        == Some(s.trim().len()) =>
+            {
+                literal.value()
+            }
+            _ => Value::String(s),
+        },
+        Value::Array(array) => {
+            let values: ValueList = array.into_iter().map(sweep_value).collect();
+            match Array::try_from(values.clone()) {
+                Ok(array) => Value::Array(array),
+                Err(_) => Value::Array(Array::from_values(values, Type::Invalid)),
+            }
+        }
+        value => value,
+    }
+}
+
+/// Insert the variant index into a filename, e.g. `gear.stl` => `gear_3.stl`.
+fn variant_filename(filename: &std::path::Path, index: usize) -> std::path::PathBuf {
+    let mut name = filename.file_stem().unwrap_or_default().to_os_string();
+    name.push(format!("_{index}"));
+    if let Some(extension) = filename.extension() {
+        name.push(".");
+        name.push(extension);
+    }
+    filename.with_file_name(name)
+}
+
+#[test]
+fn variant_filenames() {
+    use std::path::{Path, PathBuf};
+
+    assert_eq!(
+        variant_filename(Path::new("out/gear.stl"), 3),
+        PathBuf::from("out/gear_3.stl")
+    );
+    assert_eq!(
+        variant_filename(Path::new("gear"), 0),
+        PathBuf::from("gear_0")
+    );
+}
+
+#[test]
+fn sweep_variant_values() {
+    use microcad_lang::syntax::Identifier;
+
+    let dir = std::path::Path::new("../../target/sweep_variants");
+    std::fs::create_dir_all(dir).expect("test error");
+    let params = dir.join("params.toml");
+    std::fs::write(
+        &params,
+        r#"
+            [[variant]]
+            W = "1.5mm"
+            A = ["1mm", "2.5mm"]
+            N = 2
+            S = 0.5
+            T = "1.5mm wide"
+
+            [[variant]]
+            W = "wide"
+        "#,
+    )
+    .expect("test error");
+
+    let variants = sweep_variants(&params).expect("variants");
+    assert_eq!(variants.len(), 2);
+    let value = |variant: &Tuple, id: &str| {
+        variant
+            .by_id(&Identifier::no_ref(id))
+            .expect("value")
+            .clone()
+    };
+    assert_eq!(
+        value(&variants[0], "W"),
+        Value::Quantity(Quantity::new(1.5, QuantityType::Length))
+    );
+    assert_eq!(
+        value(&variants[0], "A").ty(),
+        Type::Array(Box::new(Type::Quantity(QuantityType::Length)))
+    );
+    assert_eq!(value(&variants[0], "N"), Value::Integer(2));
+    assert_eq!(
+        value(&variants[0], "S").ty(),
+        Type::Quantity(QuantityType::Scalar)
+    );
+    // strings which are not just a number with a unit are kept
+    assert_eq!(value(&variants[0], "T"), Value::String("1.5mm wide".into()));
+    assert_eq!(value(&variants[1], "W"), Value::String("wide".into()));
+
+    std::fs::write(&params, "Z = 20").expect("test error");
+    assert!(sweep_variants(&params).is_err());
+}
+
+#[test]
+fn export_sweep() {
+    use clap::Parser;
+
+    let dir = std::path::Path::new("../../target/export_sweep");
+    let _ = std::fs::remove_dir_all(dir);
+    std::fs::create_dir_all(dir).expect("test error");
+    let input = dir.join("rect.µcad");
+    std::fs::write(
+        &input,
+        "const W = 1mm;\n__builtin::geo2d::Rect(width = W / 1mm, height = 1.0, x = 0.0, y = 0.0);\n",
+    )
+    .expect("test error");
+    let params = dir.join("params.toml");
+    std::fs::write(
+        &params,
+        "[[variant]]\nW = \"2mm\"\n\n[[variant]]\nW = \"3mm\"\n",
+    )
+    .expect("test error");
+    let output = dir.join("rect.wkt");
+
+    let path = |path: &std::path::Path| path.to_string_lossy().to_string();
+    Cli::parse_from([
+        "microcad".to_string(),
+        "export".to_string(),
+        path(&input),
+        path(&output),
+        "--sweep".to_string(),
+        path(&params),
+        "--omit-default-libs".to_string(),
+        "--jobs".to_string(),
+        "1".to_string(),
+    ])
+    .run()
+    .expect("export error");
+
+    // one output per variant with the overridden width
+    let read = |name: &str| std::fs::read_to_string(dir.join(name)).expect("test error");
+    assert!(read("rect_0.wkt").contains("2 1"));
+    assert!(read("rect_1.wkt").contains("3 1"));
+    assert!(!output.exists());
+}
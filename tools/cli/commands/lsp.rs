@@ -0,0 +1,809 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! µcad CLI language server command.
+//!
+//! Speaks the *Language Server Protocol* (JSON-RPC with `Content-Length` framing) on stdin and
+//! stdout.
+//! For every open document the server keeps the syntax tree, the evaluation context (which
+//! holds source cache and symbol table) and the evaluated model in memory:
+//!
+//! - edits are applied with [`SourceFile::reparse`] which only parses the touched statements,
+//! - resolving reuses the already loaded library files (see [`ResolveContext::recreate`]),
+//! - diagnostics, go-to-definition and hover are answered from this cached state,
+//! - a burst of edits is evaluated once when no more messages are waiting.
+
+use microcad_lang::{
+    diag::*, eval::*, model::Model, parse::*, rc::*, resolve::*, src_ref::*, syntax::*,
+    tree_display::*,
+};
+use serde_json::{json, Value};
+use std::io::{BufRead, Read, Write};
+
+use crate::*;
+use anyhow::*;
+
+#[derive(clap::Parser)]
+pub struct Lsp {
+    /// Paths to search for files.
+    ///
+    /// By default, `./lib` (if it exists) and `~/.microcad/lib` are used.
+    #[arg(short = 'P', long = "search-path", action = clap::ArgAction::Append)]
+    pub search_paths: Vec<std::path::PathBuf>,
+
+    /// Do not use default search paths.
+    #[arg(short, long)]
+    omit_default_libs: bool,
+}
+
+impl RunCommand for Lsp {
+    fn run(&self, _cli: &Cli) -> anyhow::Result<()> {
+        let mut search_paths = self.search_paths.clone();
+        if !self.omit_default_libs {
+            search_paths.append(&mut Cli::default_search_paths())
+        };
+
+        let mut server = Server {
+            search_paths,
+            documents: Default::default(),
+            output: std::io::stdout().lock(),
+            shutdown: false,
+        };
+
+        // read in a separate thread to know if more messages are waiting
+        let (sender, receiver) = std::sync::mpsc::channel();
+        std::thread::spawn(move || {
+            let mut input = std::io::stdin().lock();
+            loop {
+                let message = read_message(&mut input).transpose();
+                let end = !matches!(message, Some(Result::Ok(_)));
+                if let Some(message) = message {
+                    if sender.send(message).is_err() {
+                        break;
+                    }
+                }
+                if end {
+                    break;
+                }
+            }
+        });
+        server.serve(&receiver)?;
+
+        if !server.shutdown {
+            bail!("Language server exited without shutdown request");
+        }
+        Ok(())
+    }
+}
+
+/// Read a JSON-RPC message or `None` at end of input.
+fn read_message(input: &mut impl BufRead) -> anyhow::Result<Option<Value>> {
+    let mut length = None;
+    loop {
+        let mut line = String::new();
+        if input.read_line(&mut line)? == 0 {
+            return Ok(None);
+        }
+        let line = line.trim_end();
+        if line.is_empty() {
+            break;
+        }
+        if let Some(value) = line.strip_prefix("Content-Length:") {
+            length = Some(value.trim().parse::<usize>()?);
+        }
+    }
+
+    let length = length.ok_or(anyhow!("Missing Content-Length header"))?;
+    let mut buf = vec![0; length];
+    input.read_exact(&mut buf)?;
+    Ok(Some(serde_json::from_slice(&buf)?))
+}
+
+/// Write a JSON-RPC message.
+fn write_message(output: &mut impl Write, message: &Value) -> anyhow::Result<()> {
+    let body = message.to_string();
+    write!(output, "Content-Length: {}\r\n\r\n{body}", body.len())?;
+    output.flush()?;
+    Ok(())
+}
+
+/// Convert a `file://` URI into a path.
+fn uri_to_path(uri: &str) -> Option<std::path::PathBuf> {
+    let path = uri.strip_prefix("file://")?;
+    let bytes = path.as_bytes();
+    let mut decoded = Vec::with_capacity(bytes.len());
+    let mut i = 0;
+    while i < bytes.len() {
+        match (bytes[i], path.get(i + 1..i + 3)) {
+            (b'%', Some(hex)) if u8::from_str_radix(hex, 16).is_ok() => {
+                decoded.push(u8::from_str_radix(hex, 16).ok()?);
+                i += 3;
+            }
+            (byte, _) => {
+                decoded.push(byte);
+                i += 1;
+            }
+        }
+    }
+    Some(String::from_utf8(decoded).ok()?.into())
+}
+
+/// Convert a path into a `file://` URI.
+fn path_to_uri(path: &std::path::Path) -> String {
+    let mut uri = String::from("file://");
+    for byte in path.to_string_lossy().bytes() {
+        match byte {
+            b'a'..=b'z' | b'A'..=b'Z' | b'0'..=b'9' | b'/' | b'-' | b'_' | b'.' | b'~' => {
+                uri.push(byte as char)
+            }
+            _ => uri.push_str(&format!("%{byte:02X}")),
+        }
+    }
+    uri
+}
+
+/// Return LSP position (line and UTF-16 column, both starting at `0`) of byte `offset`.
+fn position(text: &str, offset: usize) -> (usize, usize) {
+    let before = &text[..offset.min(text.len())];
+    let line_start = before.rfind('\n').map(|n| n + 1).unwrap_or(0);
+    (
+        before.matches('\n').count(),
+        before[line_start..].encode_utf16().count(),
+    )
+}
+
+/// Return byte offset of an LSP position (line and UTF-16 column, both starting at `0`).
+fn offset(text: &str, line: usize, character: usize) -> usize {
+    let line_start = match line {
+        0 => 0,
+        _ => match text.match_indices('\n').nth(line - 1) {
+            Some((n, _)) => n + 1,
+            None => return text.len(),
+        },
+    };
+    let mut units = 0;
+    for (n, ch) in text[line_start..].char_indices() {
+        if units >= character || ch == '\n' {
+            return line_start + n;
+        }
+        units += ch.len_utf16();
+    }
+    text.len()
+}
+
+/// Return the (qualified) name at byte `offset`.
+fn name_at(text: &str, offset: usize) -> Option<QualifiedName> {
+    let is_name = |ch: char| ch.is_ascii_alphanumeric() || ch == '_' || ch == ':';
+    let start = text[..offset]
+        .char_indices()
+        .rev()
+        .find(|(_, ch)| !is_name(*ch))
+        .map(|(n, ch)| n + ch.len_utf8())
+        .unwrap_or(0);
+    let end = text[offset..]
+        .find(|ch| !is_name(ch))
+        .map(|n| offset + n)
+        .unwrap_or(text.len());
+    let name = text[start..end].trim_matches(':');
+    match name.is_empty() {
+        true => None,
+        false => QualifiedName::try_from(name).ok(),
+    }
+}
+
+/// Open document with its cached state.
+struct Document {
+    /// Text as the editor sees it.
+    text: String,
+    /// Bytes of whitespace which were trimmed from the front of `text` before parsing.
+    lead: usize,
+    /// Syntax tree of `text` (or of an earlier version if `text` cannot be parsed).
+    source_file: Option<Rc<SourceFile>>,
+    /// `true` if `source_file` does not match `text`.
+    stale: bool,
+    /// Parse error of `text`.
+    parse_error: Option<String>,
+    /// Context of the last evaluation (holds sources, symbol table and diagnostics).
+    context: Option<EvalContext>,
+    /// Resolve or evaluation error which does not have a diagnostic.
+    eval_error: Option<String>,
+    /// Model of the last successful evaluation.
+    model: Option<Model>,
+    /// `true` if the text has changed since the last evaluation.
+    pending: bool,
+}
+
+impl Document {
+    fn new(path: &std::path::Path, text: String) -> Self {
+        let mut document = Self {
+            text,
+            lead: 0,
+            source_file: None,
+            stale: true,
+            parse_error: None,
+            context: None,
+            eval_error: None,
+            model: None,
+            pending: true,
+        };
+        document.parse(path);
+        document
+    }
+
+    /// Parse the whole text.
+    fn parse(&mut self, path: &std::path::Path) {
+        let name = path
+            .file_stem()
+            .map(|stem| stem.to_string_lossy().to_string())
+            .unwrap_or_default();
+        match SourceFile::load_from_str(&name, &self.text) {
+            Result::Ok(source_file) => {
+                let mut source_file = Rc::unwrap_or_clone(source_file);
+                source_file.set_filename(path);
+                self.set_source_file(Rc::new(source_file));
+            }
+            Err(err) => {
+                self.stale = true;
+                self.parse_error = Some(err.to_string());
+            }
+        }
+    }
+
+    fn set_source_file(&mut self, source_file: Rc<SourceFile>) {
+        self.lead = self.text.len() - self.text.trim_start().len();
+        self.source_file = Some(source_file);
+        self.stale = false;
+        self.parse_error = None;
+    }
+
+    /// Replace byte `range` of the text and parse only what is needed.
+    fn edit(&mut self, range: std::ops::Range<usize>, new_text: &str) {
+        let old_lead = self.lead;
+        self.text.replace_range(range.clone(), new_text);
+        if self.stale {
+            return;
+        }
+        let Some(source_file) = &self.source_file else {
+            return;
+        };
+        if range.start < old_lead || range.end > old_lead + source_file.source.len() {
+            self.stale = true;
+            return;
+        }
+
+        let edit = TextEdit::new(range.start - old_lead..range.end - old_lead, new_text);
+        match source_file.reparse(&edit) {
+            // reparse keeps untrimmed source if the edit touched leading or trailing whitespace
+            Result::Ok(source_file) if source_file.source == self.text.trim() => {
+                self.set_source_file(source_file)
+            }
+            Result::Ok(_) => self.stale = true,
+            Err(err) => {
+                self.stale = true;
+                self.parse_error = Some(err.to_string());
+            }
+        }
+    }
+
+    /// Resolve and evaluate the current syntax tree.
+    ///
+    /// Errors are kept in `eval_error`, so the server keeps running.
+    fn eval(&mut self, search_paths: &[std::path::PathBuf]) {
+        self.pending = false;
+        // an outdated syntax tree is not evaluated again
+        let Some(root) = self.source_file.clone().filter(|_| !self.stale) else {
+            return;
+        };
+        let builtin = Some(microcad_builtin::builtin_module());
+
+        // reuse loaded library files from the last run
+        let resolve_context = match self
+            .context
+            .as_ref()
+            .filter(|context| !context.sources().is_empty())
+        {
+            Some(context) => {
+                ResolveContext::recreate(context.sources(), root, builtin, DiagHandler::default())
+            }
+            None => ResolveContext::create(root, search_paths, builtin, DiagHandler::default()),
+        };
+        let resolve_context = match resolve_context {
+            Result::Ok(resolve_context) => resolve_context,
+            Err(err) => {
+                // diagnostics of the last context do not belong to the current syntax tree
+                self.context = None;
+                self.eval_error = Some(err.to_string());
+                return;
+            }
+        };
+
+        let mut context = EvalContext::new(
+            resolve_context,
+            Capture::new(),
+            microcad_builtin::builtin_exporters(),
+            microcad_builtin::builtin_importers(),
+        );
+
+        self.eval_error = None;
+        if !context.has_errors() {
+            // a panic must not take down the editor session
+            match std::panic::catch_unwind(std::panic::AssertUnwindSafe(|| context.eval())) {
+                Result::Ok(Result::Ok(model)) => self.model = model,
+                Result::Ok(Err(err)) => self.eval_error = Some(err.to_string()),
+                Err(_) => self.eval_error = Some("Evaluation panicked".into()),
+            }
+        }
+        self.context = Some(context);
+    }
+
+    /// Return source file with the given hash.
+    fn source_by_hash(&self, hash: u64) -> Option<Rc<SourceFile>> {
+        match &self.source_file {
+            Some(source_file) if source_file.hash == hash => Some(source_file.clone()),
+            _ => self.context.as_ref()?.sources().get_by_hash(hash).ok(),
+        }
+    }
+
+    /// Return LSP range of a source code reference in the given source file.
+    fn range(&self, source_file: &SourceFile, src_ref: &SrcRef) -> Option<Value> {
+        let range = src_ref.0?.range();
+        // the open document has been trimmed before parsing
+        let (text, lead) = match &self.source_file {
+            Some(root) if root.hash == source_file.hash && !self.stale => {
+                (self.text.as_str(), self.lead)
+            }
+            _ => (source_file.source.as_str(), 0),
+        };
+        let (start_line, start_char) = position(text, range.start + lead);
+        let (end_line, end_char) = position(text, range.end + lead);
+        Some(json!({
+            "start": { "line": start_line, "character": start_char },
+            "end": { "line": end_line, "character": end_char },
+        }))
+    }
+
+    /// Find the symbol which is named at byte `offset`.
+    fn symbol_at(&self, offset: usize) -> Option<Symbol> {
+        let name = name_at(&self.text, offset)?;
+        let context = self.context.as_ref()?;
+        let symbol_table = context.symbol_table();
+        let root = self.source_file.as_ref()?;
+        let within = symbol_table.lookup(&QualifiedName::from_id(root.id())).ok();
+        let symbol = symbol_table.lookup_within_opt(&name, &within).ok()?;
+
+        // follow `use` aliases to the actual definition
+        match symbol.definition() {
+            SymbolDefinition::Alias(.., target) => symbol_table.lookup(&target).ok(),
+            _ => Some(symbol),
+        }
+    }
+
+    /// Collect all diagnostics of parsing, resolving and evaluation.
+    fn diagnostics(&self) -> Vec<Value> {
+        let range = |line: usize, character: usize| {
+            json!({
+                "start": { "line": line, "character": character },
+                "end": { "line": line, "character": character },
+            })
+        };
+
+        let mut diagnostics = Vec::new();
+        if let Some(parse_error) = &self.parse_error {
+            // pest errors contain the position like ` --> 3:5`
+            let (line, col) = parse_error
+                .split_once("--> ")
+                .and_then(|(_, at)| {
+                    let (line, rest) = at.split_once(':')?;
+                    let col: String = rest.chars().take_while(char::is_ascii_digit).collect();
+                    Some((line.parse::<usize>().ok()?, col.parse::<usize>().ok()?))
+                })
+                .unwrap_or((1, 1));
+            diagnostics.push(json!({
+                "range": range(line.saturating_sub(1), col.saturating_sub(1)),
+                "severity": 1,
+                "source": "microcad",
+                "message": parse_error,
+            }));
+        }
+        if let Some(eval_error) = &self.eval_error {
+            diagnostics.push(json!({
+                "range": range(0, 0),
+                "severity": 1,
+                "source": "microcad",
+                "message": eval_error,
+            }));
+        }
+
+        // resolve and evaluation diagnostics are only valid for the current syntax tree
+        let (Some(context), Some(root), false) = (&self.context, &self.source_file, self.stale)
+        else {
+            return diagnostics;
+        };
+        for diagnostic in context.diag_handler().diag_list().iter() {
+            let severity = match diagnostic.level() {
+                Level::Error => 1,
+                Level::Warning => 2,
+                Level::Info => 3,
+                Level::Trace => continue,
+            };
+            let src_ref = diagnostic.src_ref();
+            // diagnostics of other files are shown at the start of the document
+            let range = match src_ref.source_hash() == root.hash {
+                true => self.range(root, &src_ref).unwrap_or(range(0, 0)),
+                false => range(0, 0),
+            };
+            diagnostics.push(json!({
+                "range": range,
+                "severity": severity,
+                "source": "microcad",
+                "message": diagnostic.message(),
+            }));
+        }
+        diagnostics
+    }
+}
+
+/// Language server state.
+struct Server<W: Write> {
+    search_paths: Vec<std::path::PathBuf>,
+    documents: std::collections::HashMap<String, Document>,
+    output: W,
+    shutdown: bool,
+}
+
+impl<W: Write> Server<W> {
+    /// Handle messages until the input ends or an exit notification arrives.
+    ///
+    /// Changed documents are evaluated when no more messages are waiting, so a burst of edits
+    /// is evaluated only once.
+    fn serve(&mut self, messages: &std::sync::mpsc::Receiver<anyhow::Result<Value>>) -> Result<()> {
+        loop {
+            let message = match messages.try_recv() {
+                Result::Ok(message) => message,
+                Err(_) => {
+                    self.eval_pending()?;
+                    match messages.recv() {
+                        Result::Ok(message) => message,
+                        Err(_) => return Ok(()),
+                    }
+                }
+            };
+            if !self.handle(message?)? {
+                return Ok(());
+            }
+        }
+    }
+
+    /// Evaluate changed documents and publish their diagnostics.
+    fn eval_pending(&mut self) -> Result<()> {
+        let pending: Vec<_> = self
+            .documents
+            .iter()
+            .filter(|(_, document)| document.pending)
+            .map(|(uri, _)| uri.clone())
+            .collect();
+        for uri in pending {
+            if let Some(document) = self.documents.get_mut(&uri) {
+                document.eval(&self.search_paths);
+            }
+            self.publish_diagnostics(&uri)?;
+        }
+        Ok(())
+    }
+
+    /// Handle a message and return `false` if the server shall exit.
+    fn handle(&mut self, message: Value) -> anyhow::Result<bool> {
+        let method = message["method"].as_str().unwrap_or_default().to_string();
+        let params = &message["params"];
+        let id = message.get("id").cloned();
+        log::debug!("LSP message: {method}");
+
+        // requests are answered from the current text
+        if id.is_some() {
+            self.eval_pending()?;
+        }
+
+        let result = match method.as_str() {
+            "initialize" => Some(json!({
+                "capabilities": {
+                    // incremental text synchronization
+                    "textDocumentSync": 2,
+                    "definitionProvider": true,
+                    "hoverProvider": true,
+                },
+                "serverInfo": { "name": "microcad", "version": env!("CARGO_PKG_VERSION") },
+            })),
+            "shutdown" => {
+                self.shutdown = true;
+                Some(Value::Null)
+            }
+            "exit" => return Ok(false),
+            "textDocument/didOpen" => {
+                let uri = params["textDocument"]["uri"].as_str().unwrap_or_default();
+                let text = params["textDocument"]["text"].as_str().unwrap_or_default();
+                let path = uri_to_path(uri).unwrap_or_else(|| uri.into());
+                self.documents
+                    .insert(uri.to_string(), Document::new(&path, text.to_string()));
+                None
+            }
+            "textDocument/didChange" => {
+                let uri = params["textDocument"]["uri"].as_str().unwrap_or_default();
+                self.change(uri, &params["contentChanges"]);
+                None
+            }
+            "textDocument/didClose" => {
+                let uri = params["textDocument"]["uri"].as_str().unwrap_or_default();
+                self.documents.remove(uri);
+                None
+            }
+            "textDocument/definition" => Some(self.definition(params).unwrap_or(Value::Null)),
+            "textDocument/hover" => Some(self.hover(params).unwrap_or(Value::Null)),
+            "microcad/modelTree" => Some(self.model_tree(params).unwrap_or(Value::Null)),
+            _ => {
+                // unknown requests must be answered, unknown notifications are ignored
+                if let Some(id) = id {
+                    write_message(
+                        &mut self.output,
+                        &json!({
+                            "jsonrpc": "2.0",
+                            "id": id,
+                            "error": { "code": -32601, "message": format!("Unknown method {method}") },
+                        }),
+                    )?;
+                }
+                return Ok(true);
+            }
+        };
+
+        if let (Some(id), Some(result)) = (id, result) {
+            write_message(
+                &mut self.output,
+                &json!({ "jsonrpc": "2.0", "id": id, "result": result }),
+            )?;
+        }
+        Ok(true)
+    }
+
+    /// Apply content changes to a document and mark it for evaluation.
+    fn change(&mut self, uri: &str, changes: &Value) {
+        let Some(document) = self.documents.get_mut(uri) else {
+            return;
+        };
+        let path = uri_to_path(uri).unwrap_or_else(|| uri.into());
+
+        for change in changes.as_array().into_iter().flatten() {
+            let text = change["text"].as_str().unwrap_or_default();
+            match change.get("range") {
+                Some(range) => {
+                    let at = |pos: &Value| {
+                        offset(
+                            &document.text,
+                            pos["line"].as_u64().unwrap_or_default() as usize,
+                            pos["character"].as_u64().unwrap_or_default() as usize,
+                        )
+                    };
+                    let (start, end) = (at(&range["start"]), at(&range["end"]));
+                    document.edit(start..end.max(start), text);
+                }
+                None => {
+                    document.text = text.to_string();
+                    document.stale = true;
+                }
+            }
+        }
+
+        if document.stale {
+            document.parse(&path);
+        }
+        document.pending = true;
+    }
+
+    fn publish_diagnostics(&mut self, uri: &str) -> anyhow::Result<()> {
+        let Some(document) = self.documents.get(uri) else {
+            return Ok(());
+        };
+        write_message(
+            &mut self.output,
+            &json!({
+                "jsonrpc": "2.0",
+                "method": "textDocument/publishDiagnostics",
+                "params": { "uri": uri, "diagnostics": document.diagnostics() },
+            }),
+        )?;
+
+        // forward what the µcad code printed
+        if let Some(output) = document
+            .context
+            .as_ref()
+            .and_then(|context| context.output())
+            .filter(|output| !output.is_empty())
+        {
+            write_message(
+                &mut self.output,
+                &json!({
+                    "jsonrpc": "2.0",
+                    "method": "window/logMessage",
+                    "params": { "type": 4, "message": output },
+                }),
+            )?;
+        }
+        Ok(())
+    }
+
+    /// Return document and byte offset of a `TextDocumentPositionParams`.
+    fn document_position(&self, params: &Value) -> Option<(&Document, usize)> {
+        let document = self
+            .documents
+            .get(params["textDocument"]["uri"].as_str()?)?;
+        let offset = offset(
+            &document.text,
+            params["position"]["line"].as_u64()? as usize,
+            params["position"]["character"].as_u64()? as usize,
+        );
+        Some((document, offset))
+    }
+
+    fn definition(&self, params: &Value) -> Option<Value> {
+        let (document, offset) = self.document_position(params)?;
+        let symbol = document.symbol_at(offset)?;
+        let src_ref = symbol.src_ref();
+        let source_file = document.source_by_hash(src_ref.source_hash())?;
+        Some(json!({
+            "uri": path_to_uri(&source_file.filename()),
+            "range": document.range(&source_file, &src_ref)?,
+        }))
+    }
+
+    fn hover(&self, params: &Value) -> Option<Value> {
+        let (document, offset) = self.document_position(params)?;
+        let symbol = document.symbol_at(offset)?;
+        let definition = symbol.definition();
+
+        let mut value = format!("```µcad\n{} {definition}\n```", symbol.full_name());
+        if let SymbolDefinition::Workbench(workbench) = &definition {
+            if !workbench.doc.lines.is_empty() {
+                value.push_str("\n\n");
+                value.push_str(&workbench.doc.lines.join("\n"));
+            }
+        }
+        Some(json!({ "contents": { "kind": "markdown", "value": value } }))
+    }
+
+    /// Return the tree of the last evaluated model of a document.
+    fn model_tree(&self, params: &Value) -> Option<Value> {
+        let document = self
+            .documents
+            .get(params["textDocument"]["uri"].as_str()?)?;
+        let model = document.model.as_ref()?;
+        Some(Value::String(FormatTree(model).to_string()))
+    }
+}
+
+#[test]
+fn lsp_positions() {
+    let text = "a = 1;\nb = \"ä😀\" + c;\n";
+    assert_eq!(offset(text, 0, 0), 0);
+    assert_eq!(offset(text, 1, 0), 7);
+    // `ä` is one UTF-16 unit but two bytes, `😀` is two UTF-16 units but four bytes
+    assert_eq!(offset(text, 1, 6), 7 + 7);
+    assert_eq!(offset(text, 1, 8), 7 + 11);
+    assert_eq!(offset(text, 0, 99), 6);
+    assert_eq!(offset(text, 99, 0), text.len());
+
+    assert_eq!(position(text, 0), (0, 0));
+    assert_eq!(position(text, 7 + 11), (1, 8));
+    assert_eq!(position(text, text.len() + 1), (2, 0));
+    for offset_ in [0, 4, 7, 14, 18] {
+        let (line, character) = position(text, offset_);
+        assert_eq!(offset(text, line, character), offset_);
+    }
+}
+
+#[test]
+fn lsp_uri_to_path() {
+    assert_eq!(
+        uri_to_path("file:///home/user/my%20part.%C2%B5cad"),
+        Some("/home/user/my part.µcad".into())
+    );
+    assert_eq!(uri_to_path("file:///100%"), Some("/100%".into()));
+    assert_eq!(uri_to_path("untitled:Untitled-1"), None);
+
+    let path = std::path::Path::new("/home/user/my part.µcad");
+    assert_eq!(uri_to_path(&path_to_uri(path)).as_deref(), Some(path));
+}
+
+#[test]
+fn lsp_name_at() {
+    let text = "std::geo2d::Circle(r = 1mm);";
+    assert_eq!(
+        name_at(text, 13).map(|name| name.to_string()),
+        Some("std::geo2d::Circle".into())
+    );
+    assert_eq!(
+        name_at(text, 0).map(|name| name.to_string()),
+        Some("std::geo2d::Circle".into())
+    );
+    assert_eq!(
+        name_at(text, 19).map(|name| name.to_string()),
+        Some("r".into())
+    );
+    assert_eq!(name_at(text, 21), None);
+}
+
+#[test]
+fn lsp_diagnostics_round_trip() {
+    let mut server = Server {
+        search_paths: Vec::new(),
+        documents: Default::default(),
+        output: Vec::new(),
+        shutdown: false,
+    };
+    let uri = "file:///tmp/lsp_round_trip.%C2%B5cad";
+
+    // serve `messages` as if they arrived at once and return the published diagnostics
+    let mut serve = |messages: Vec<Value>| {
+        let (sender, receiver) = std::sync::mpsc::channel();
+        messages
+            .into_iter()
+            .for_each(|message| sender.send(Ok(message)).expect("send"));
+        drop(sender);
+        server.serve(&receiver).expect("serve");
+
+        let mut output = std::io::Cursor::new(std::mem::take(&mut server.output));
+        let mut diagnostics = Vec::new();
+        while let Some(message) = read_message(&mut output).expect("message") {
+            if message["method"] == "textDocument/publishDiagnostics" {
+                assert_eq!(message["params"]["uri"], uri);
+                diagnostics.push(message["params"]["diagnostics"].clone());
+            }
+        }
+        diagnostics
+    };
+    let change = |changes: Value| {
+        json!({
+            "jsonrpc": "2.0",
+            "method": "textDocument/didChange",
+            "params": { "textDocument": { "uri": uri }, "contentChanges": changes },
+        })
+    };
+    let replace = |text: &str| {
+        change(json!([{
+            "range": {
+                "start": { "line": 0, "character": 25 },
+                "end": { "line": 0, "character": 30 },
+            },
+            "text": text,
+        }]))
+    };
+
+    // a burst of edits is evaluated once with the final text
+    let diagnostics = serve(vec![
+        json!({
+            "jsonrpc": "2.0",
+            "method": "textDocument/didOpen",
+            "params": { "textDocument": {
+                "uri": uri,
+                "text": "__builtin::debug::assert(1 == 1);\n",
+            } },
+        }),
+        replace("2 == "),
+        replace("1 == "),
+    ]);
+    assert_eq!(diagnostics.len(), 1);
+    let errors = |diagnostics: &Value| {
+        diagnostics
+            .as_array()
+            .expect("diagnostics")
+            .iter()
+            .filter(|diagnostic| diagnostic["severity"] == 1)
+            .count()
+    };
+    assert_eq!(errors(&diagnostics[0]), 0);
+
+    // syntax errors are published, too
+    let diagnostics = serve(vec![change(
+        json!([{ "text": "__builtin::debug::assert(1 == );" }]),
+    )]);
+    assert_eq!(diagnostics.len(), 1);
+    assert_eq!(errors(&diagnostics[0]), 1);
+}
@@ -7,8 +7,10 @@ mod create;
 mod eval;
 mod export;
 mod install;
+mod lsp;
 mod parse;
 mod resolve;
+mod sweep;
 mod watch;
 
 use clap::Subcommand;
@@ -17,8 +19,10 @@ pub use create::Create;
 pub use eval::Eval;
 pub use export::Export;
 pub use install::Install;
+pub use lsp::Lsp;
 pub use parse::Parse;
 pub use resolve::Resolve;
+pub use sweep::Sweep;
 pub use watch::Watch;
 
 #[derive(Subcommand)]
@@ -38,11 +42,17 @@ pub enum Commands {
     /// Create a new source file with µcad extension.
     Create(Create),
 
+    /// Evaluate and render variants of a µcad file with different top-level values.
+    Sweep(Sweep),
+
     /// Watch a µcad file
     Watch(Watch),
 
     /// Install µcad standard library
     Install(Install),
+
+    /// Run language server on stdin and stdout
+    Lsp(Lsp),
 }
 
 /// Run this command for a CLI.
@@ -20,9 +20,14 @@ pub struct Parse {
 impl RunCommand<Rc<SourceFile>> for Parse {
     fn run(&self, cli: &Cli) -> anyhow::Result<Rc<SourceFile>> {
         let start = std::time::Instant::now();
+        let stage = cli.begin_stage("parse");
 
         let source_file = SourceFile::load(self.input.clone())?;
 
+        if let Some(stage) = stage {
+            stage.end(|| []);
+        }
+
         if cli.time {
             eprintln!("Parsing Time   : {}", Cli::time_to_string(&start.elapsed()));
         }
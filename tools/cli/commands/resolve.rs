@@ -28,12 +28,9 @@ pub struct Resolve {
     omit_default_libs: bool,
 }
 
-impl RunCommand<ResolveContext> for Resolve {
-    fn run(&self, cli: &Cli) -> anyhow::Result<ResolveContext> {
-        // run prior parse step
-        let root = self.parse.run(cli)?;
-
-        // add default paths or omit this step by option
+impl Resolve {
+    /// Search paths including the default paths unless they are omitted.
+    pub fn search_paths(&self) -> Vec<std::path::PathBuf> {
         let mut search_paths = self.search_paths.clone();
 
         if !self.omit_default_libs {
@@ -52,7 +49,18 @@ Use `microcad install std` to install the std library.",
             );
         }
 
+        search_paths
+    }
+}
+
+impl RunCommand<ResolveContext> for Resolve {
+    fn run(&self, cli: &Cli) -> anyhow::Result<ResolveContext> {
+        // run prior parse step
+        let root = self.parse.run(cli)?;
+        let search_paths = self.search_paths();
+
         let start = std::time::Instant::now();
+        let stage = cli.begin_stage("resolve");
 
         // resolve the file
         let context = ResolveContext::create(
@@ -62,12 +70,16 @@ Use `microcad install std` to install the std library.",
             DiagHandler::default(),
         )?;
 
+        if let Some(stage) = stage {
+            stage.end(|| []);
+        }
+
         if cli.time {
             eprintln!("Resolving Time : {}", Cli::time_to_string(&start.elapsed()));
         }
 
-        if context.has_errors() {
-            eprint!("{}", context.diagnosis());
+        if context.has_errors() || (cli.diag_json && cli.is_resolve()) {
+            cli.print_diagnosis(&context);
         }
 
         if self.resolve {
@@ -0,0 +1,168 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! µcad CLI sweep command
+
+use microcad_core::RenderResolution;
+use microcad_lang::{
+    diag::*,
+    eval::{Capture, EvalSnapshot},
+    model::Model,
+    rc::RcMut,
+    render::*,
+    syntax::SourceFile,
+    value::Tuple,
+};
+
+use crate::*;
+
+/// Evaluate and render variants of a µcad file with overridden top-level values.
+#[derive(clap::Parser)]
+pub struct Sweep {
+    #[clap(flatten)]
+    pub resolve: Resolve,
+
+    /// Top-level values to override as µcad tuple, e.g. `(z = [20..120], m = 1.5mm)`.
+    ///
+    /// Each array is expanded, so there is one variant for each combination of the array items.
+    pub params: String,
+
+    /// Number of worker threads (default: number of CPUs).
+    #[arg(short, long)]
+    pub jobs: Option<usize>,
+
+    /// The resolution for rendering.
+    #[arg(short, long, default_value = "0.1mm")]
+    pub resolution: String,
+}
+
+impl RunCommand for Sweep {
+    fn run(&self, cli: &Cli) -> anyhow::Result<()> {
+        let start = std::time::Instant::now();
+        let resolution = super::export::parse_resolution(&self.resolution);
+
+        let results = run_variants(
+            &self.resolve.parse.input,
+            &self.resolve.search_paths(),
+            self.jobs,
+            || Ok(Tuple::from_code(&self.params)?.variants()),
+            |snapshot, render_cache, _, variant| {
+                eval_variant(snapshot, variant, &resolution, render_cache)
+            },
+        )?;
+
+        results
+            .iter()
+            .enumerate()
+            .for_each(|(index, result)| match result {
+                Ok(result) => println!("{index:>4}: {result}"),
+                Err(err) => println!("{index:>4}: {err}"),
+            });
+
+        if cli.time {
+            eprintln!("Sweep Time     : {}", Cli::time_to_string(&start.elapsed()));
+        }
+        eprintln!("Evaluated {} variant(s).", results.len());
+
+        Ok(())
+    }
+}
+
+/// Result of processing a single variant.
+pub type VariantResult = anyhow::Result<String>;
+
+/// Process all variants of a design on `jobs` worker threads (default: number of CPUs).
+///
+/// Syntax trees, models and values are not thread-safe, so each worker loads the design,
+/// gets the `variants` and processes every `jobs`-th variant with `f`.
+/// The variants of a worker share one render cache.
+/// Returns the results ordered by variant index.
+pub fn run_variants(
+    input: &std::path::Path,
+    search_paths: &[std::path::PathBuf],
+    jobs: Option<usize>,
+    variants: impl Fn() -> anyhow::Result<Vec<Tuple>> + Sync,
+    f: impl Fn(&EvalSnapshot, &RcMut<RenderCache>, usize, Tuple) -> VariantResult + Sync,
+) -> anyhow::Result<Vec<VariantResult>> {
+    let count = variants()?.len();
+    let jobs = jobs
+        .unwrap_or_else(|| std::thread::available_parallelism().map_or(1, |n| n.get()))
+        .clamp(1, count.max(1));
+
+    let worker = |worker: usize| -> anyhow::Result<Vec<(usize, VariantResult)>> {
+        let root = SourceFile::load(input)?;
+        let snapshot =
+            EvalSnapshot::load(root, search_paths, Some(microcad_builtin::builtin_module))?;
+        let render_cache = RcMut::new(RenderCache::default());
+
+        Ok(variants()?
+            .into_iter()
+            .enumerate()
+            .skip(worker)
+            .step_by(jobs)
+            .map(|(index, variant)| (index, f(&snapshot, &render_cache, index, variant)))
+            .collect())
+    };
+
+    let mut results = std::thread::scope(|scope| {
+        let workers: Vec<_> = (0..jobs)
+            .map(|index| scope.spawn(move || worker(index)))
+            .collect();
+        workers
+            .into_iter()
+            .map(|worker| worker.join().expect("sweep worker panicked"))
+            .collect::<anyhow::Result<Vec<_>>>()
+    })?
+    .into_iter()
+    .flatten()
+    .collect::<Vec<_>>();
+
+    results.sort_by_key(|(index, _)| *index);
+    Ok(results.into_iter().map(|(_, result)| result).collect())
+}
+
+/// Evaluate and render a single variant and describe the result.
+fn eval_variant(
+    snapshot: &EvalSnapshot,
+    variant: Tuple,
+    resolution: &RenderResolution,
+    render_cache: &RcMut<RenderCache>,
+) -> VariantResult {
+    let start = std::time::Instant::now();
+    let params = variant.to_string();
+    let mut context = snapshot.fork(
+        variant,
+        Capture::new(),
+        microcad_builtin::builtin_exporters(),
+        microcad_builtin::builtin_importers(),
+    )?;
+
+    let status = match context.eval() {
+        Ok(_) if context.has_errors() => format!("{} error(s)", context.error_count()),
+        Ok(Some(model)) => {
+            let rendered =
+                RenderContext::init(&model, resolution.clone(), Some(render_cache.clone()))
+                    .and_then(|mut render_context| -> RenderResult<Model> {
+                        model.render_with_context(&mut render_context)
+                    });
+            match rendered {
+                Ok(_) => "ok".to_string(),
+                Err(err) => format!("render error: {err}"),
+            }
+        }
+        Ok(None) => "no model".to_string(),
+        Err(err) => format!("eval error: {err}"),
+    };
+
+    let unused = context.unused_overrides();
+    let status = if unused.is_empty() {
+        status
+    } else {
+        format!("{status} (unused: {unused})")
+    };
+
+    Ok(format!(
+        "{params} {status} {time}",
+        time = Cli::time_to_string(&start.elapsed())
+    ))
+}
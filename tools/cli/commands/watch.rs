@@ -56,6 +56,9 @@ impl RunCommand for Watch {
                     cache.garbage_collection();
                 }
 
+                // Write the spans of this compilation, because watching ends by interruption.
+                cli.write_trace()?;
+
                 // Wait until anything relevant happens.
                 watcher.wait()?;
             }
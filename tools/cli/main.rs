@@ -9,6 +9,7 @@ extern crate microcad_lang;
 mod cli;
 mod commands;
 mod config;
+mod mem;
 pub mod watcher;
 
 pub use cli::*;
@@ -0,0 +1,175 @@
+// Copyright © 2025 The µcad authors <info@ucad.xyz>
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+//! Memory accounting for the µcad CLI.
+//!
+//! Exact allocation numbers are only available when the CLI is built with the `track-alloc`
+//! feature, which installs a counting global allocator.
+//! Otherwise, only the peak resident set size (Linux only) and size estimates are reported.
+
+use std::{cell::RefCell, collections::BTreeMap};
+
+#[cfg(feature = "track-alloc")]
+mod tracking {
+    use std::{
+        alloc::{GlobalAlloc, Layout, System},
+        sync::atomic::{AtomicUsize, Ordering},
+    };
+
+    /// Currently allocated bytes.
+    pub static ALLOCATED: AtomicUsize = AtomicUsize::new(0);
+    /// Maximum of allocated bytes since the last reset.
+    pub static PEAK: AtomicUsize = AtomicUsize::new(0);
+
+    /// System allocator which counts allocated bytes.
+    struct TrackingAllocator;
+
+    unsafe impl GlobalAlloc for TrackingAllocator {
+        unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+            let ptr = unsafe { System.alloc(layout) };
+            if !ptr.is_null() {
+                let allocated = ALLOCATED.fetch_add(layout.size(), Ordering::Relaxed);
+                PEAK.fetch_max(allocated + layout.size(), Ordering::Relaxed);
+            }
+            ptr
+        }
+
+        unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+            unsafe { System.dealloc(ptr, layout) };
+            ALLOCATED.fetch_sub(layout.size(), Ordering::Relaxed);
+        }
+
+        unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+            let new_ptr = unsafe { System.realloc(ptr, layout, new_size) };
+            if !new_ptr.is_null() {
+                if new_size > layout.size() {
+                    let grow = new_size - layout.size();
+                    let allocated = ALLOCATED.fetch_add(grow, Ordering::Relaxed);
+                    PEAK.fetch_max(allocated + grow, Ordering::Relaxed);
+                } else {
+                    ALLOCATED.fetch_sub(layout.size() - new_size, Ordering::Relaxed);
+                }
+            }
+            new_ptr
+        }
+    }
+
+    #[global_allocator]
+    static GLOBAL: TrackingAllocator = TrackingAllocator;
+}
+
+/// Currently allocated bytes.
+pub fn allocated() -> Option<usize> {
+    #[cfg(feature = "track-alloc")]
+    let allocated = Some(tracking::ALLOCATED.load(std::sync::atomic::Ordering::Relaxed));
+    #[cfg(not(feature = "track-alloc"))]
+    let allocated = None;
+    allocated
+}
+
+/// Peak of allocated bytes since the last call of [`reset_peak`].
+pub fn peak() -> Option<usize> {
+    #[cfg(feature = "track-alloc")]
+    let peak = Some(tracking::PEAK.load(std::sync::atomic::Ordering::Relaxed));
+    #[cfg(not(feature = "track-alloc"))]
+    let peak = None;
+    peak
+}
+
+/// Set the peak of allocated bytes to the currently allocated bytes.
+pub fn reset_peak() {
+    #[cfg(feature = "track-alloc")]
+    {
+        use std::sync::atomic::Ordering;
+        tracking::PEAK.store(
+            tracking::ALLOCATED.load(Ordering::Relaxed),
+            Ordering::Relaxed,
+        );
+    }
+}
+
+/// Peak resident set size of the process in bytes (Linux only).
+pub fn peak_rss() -> Option<usize> {
+    let status = std::fs::read_to_string("/proc/self/status").ok()?;
+    let line = status.lines().find(|line| line.starts_with("VmHWM:"))?;
+    let kilo_bytes: usize = line
+        .trim_start_matches("VmHWM:")
+        .trim()
+        .trim_end_matches("kB")
+        .trim()
+        .parse()
+        .ok()?;
+    Some(kilo_bytes * 1024)
+}
+
+/// Memory usage of one processing stage.
+#[derive(serde::Serialize)]
+pub struct MemoryRecord {
+    /// Name of the stage, e.g. `parse`.
+    pub stage: &'static str,
+    /// Export target, if the record belongs to a single target model.
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub target: Option<String>,
+    /// Bytes still allocated at the end of the stage.
+    pub retained: Option<usize>,
+    /// Maximum of allocated bytes during the stage.
+    pub peak: Option<usize>,
+    /// Peak resident set size of the process until the end of the stage.
+    pub peak_rss: Option<usize>,
+    /// Estimated sizes of the data created by the stage, e.g. `model` or `render_cache`.
+    pub estimates: BTreeMap<&'static str, usize>,
+}
+
+thread_local! {
+    static RECORDS: RefCell<Vec<MemoryRecord>> = const { RefCell::new(Vec::new()) };
+}
+
+/// A processing stage which is measured from creation until [`Stage::end`].
+pub struct Stage {
+    stage: &'static str,
+    target: Option<String>,
+}
+
+impl Stage {
+    /// Begin to measure a stage.
+    pub fn begin(stage: &'static str) -> Self {
+        reset_peak();
+        Self {
+            stage,
+            target: None,
+        }
+    }
+
+    /// Begin to measure a stage for a single export target.
+    pub fn begin_target(stage: &'static str, target: impl std::fmt::Display) -> Self {
+        let mut stage = Self::begin(stage);
+        stage.target = Some(target.to_string());
+        stage
+    }
+
+    /// End the stage and record its memory usage with some size estimates.
+    ///
+    /// The counters are read before `estimates` is called, because estimating allocates, too.
+    pub fn end<E: IntoIterator<Item = (&'static str, usize)>>(self, estimates: impl FnOnce() -> E) {
+        let (retained, peak, peak_rss) = (allocated(), peak(), peak_rss());
+        let record = MemoryRecord {
+            stage: self.stage,
+            target: self.target,
+            retained,
+            peak,
+            peak_rss,
+            estimates: estimates().into_iter().collect(),
+        };
+        RECORDS.with_borrow_mut(|records| records.push(record));
+    }
+}
+
+/// Memory report of all recorded stages as JSON.
+pub fn report() -> anyhow::Result<String> {
+    RECORDS.with_borrow(|records| {
+        Ok(serde_json::to_string_pretty(&serde_json::json!({
+            "track_alloc": cfg!(feature = "track-alloc"),
+            "stages": records,
+        }))?)
+    })
+}